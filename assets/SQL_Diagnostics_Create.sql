@@ -0,0 +1,7 @@
+CREATE TAG TABLE DIAGNOSTICS (NAME VARCHAR(150) PRIMARY KEY, TIMESTAMP DATETIME BASETIME, VALUE DOUBLE SUMMARIZED, PARAMETER VARCHAR(100) NOT NULL, DEVICE_ID VARCHAR(50) NOT NULL);
+
+CREATE ROLLUP _DIAGNOSTICS_ROLLUP_HOUR ON DIAGNOSTICS(VALUE) INTERVAL 1 HOUR EXTENSION;
+
+
+CREATE INDEX IDX_DIAGNOSTICS_PARAMETER ON DIAGNOSTICS (PARAMETER) INDEX_TYPE TAG;
+CREATE INDEX IDX_DIAGNOSTICS_DEVICE_ID ON DIAGNOSTICS (DEVICE_ID) INDEX_TYPE TAG;
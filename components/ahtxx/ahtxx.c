@@ -52,14 +52,12 @@
 #define I2C_AHTXX_CTRL_MEAS             UINT8_C(0x33)
 #define I2C_AHTXX_CTRL_NOP              UINT8_C(0x00)
 
-#define I2C_AHTXX_DATA_POLL_TIMEOUT_MS  UINT16_C(100)
+#define I2C_AHTXX_DATA_POLL_TIMEOUT_MS  UINT16_C(150)   /*!< ahtxx maximum time from measurement trigger to data ready */
 #define I2C_AHTXX_DATA_READY_DELAY_MS   UINT16_C(2)
 #define I2C_AHTXX_POWERUP_DELAY_MS      UINT16_C(120)
 #define I2C_AHTXX_RESET_DELAY_MS        UINT16_C(25)
 #define I2C_AHTXX_SETUP_DELAY_MS        UINT16_C(15)
 #define I2C_AHTXX_APPSTART_DELAY_MS     UINT16_C(10)    /*!< ahtxx delay after initialization before application start-up */
-#define I2C_AHTXX_CMD_DELAY_MS          UINT16_C(5)     /*!< ahtxx delay before attempting I2C transactions after a command is issued */
-#define I2C_AHTXX_TX_RX_DELAY_MS        UINT16_C(10)    /*!< ahtxx delay after attempting an I2C transmit transaction and attempting an I2C receive transaction */
 
 
 /*
@@ -74,15 +72,39 @@
 static const char *TAG = "ahtxx";
 
 /**
- * @brief Calculates dewpoint temperature from air temperature and relative humidity.
+ * @brief Delays the task by at least the given time, rounded up to the next tick.
  *
- * @param[in] temperature air temperature in degrees Celsius.
- * @param[in] humidity relative humiity in percent.
- * @param[out] dewpoint calculated dewpoint temperature in degrees Celsius.
- * @return esp_err_t ESP_OK on success.
+ * @param[in] delay_us delay in micro-seconds.
  */
-static inline esp_err_t i2c_ahtxx_calculate_dewpoint(const float temperature, const float humidity, float *const dewpoint) {
-    ESP_ARG_CHECK(temperature && humidity && dewpoint);
+static inline void i2c_ahtxx_delay_us(const int64_t delay_us) {
+    const int64_t tick_us = (int64_t)portTICK_PERIOD_MS * 1000;
+
+    if(delay_us > 0) {
+        vTaskDelay((TickType_t)((delay_us + tick_us - 1) / tick_us));
+    }
+}
+
+/**
+ * @brief Decodes temperature and relative humidity from an AHTXX measurement frame.
+ *
+ * @param[in] rx measurement frame, status byte followed by 20-bit humidity and 20-bit temperature.
+ * @param[out] temperature temperature in degree Celsius.
+ * @param[out] humidity relative humidity in percentage.
+ */
+static inline void i2c_ahtxx_decode_measurement(const i2c_uint48_t rx, float *const temperature, float *const humidity) {
+    uint32_t raw;
+
+    /* compute and set humidity */
+    raw = ((uint32_t)rx[1] << 12) | ((uint32_t)rx[2] << 4) | (rx[3] >> 4);
+    *humidity = (float)(raw * 100) / (float)0x100000;
+
+    /* compute and set temperature */
+    raw = ((uint32_t)(rx[3] & 0x0f) << 16) | ((uint32_t)rx[4] << 8) | rx[5];
+    *temperature = (float)(raw * 200) / (float)0x100000 - 50;
+}
+
+esp_err_t i2c_ahtxx_calculate_dewpoint(const float temperature, const float humidity, float *const dewpoint) {
+    ESP_ARG_CHECK(dewpoint);
 
     // validate parameters
     if(temperature > 80 || temperature < -40) return ESP_ERR_INVALID_ARG;
@@ -108,7 +130,7 @@ esp_err_t i2c_ahtxx_setup(i2c_ahtxx_handle_t ahtxx_handle) {
     }
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(ahtxx_handle->i2c_dev_handle, tx, I2C_UINT24_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "write initializaion register 0xbe failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit(ahtxx_handle->i2c_dev_handle, tx, I2C_UINT24_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "write initializaion register 0xbe failed" );
 
     /* delay task before next i2c transaction */
     vTaskDelay(pdMS_TO_TICKS(I2C_AHTXX_SETUP_DELAY_MS));
@@ -130,20 +152,17 @@ esp_err_t i2c_ahtxx_get_status_register(i2c_ahtxx_handle_t ahtxx_handle) {
     i2c_uint8_t rx = { 0 };
 
     /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(ahtxx_handle->i2c_dev_handle, tx, I2C_UINT8_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, read status register failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit(ahtxx_handle->i2c_dev_handle, tx, I2C_UINT8_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_transmit, read status register failed" );
 
-    /* delay task before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_AHTXX_TX_RX_DELAY_MS));
+    /* delay task for the device turnaround before next i2c transaction */
+    i2c_ahtxx_delay_us(I2C_AHTXX_TURNAROUND_US);
 
     /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_receive(ahtxx_handle->i2c_dev_handle, rx, I2C_UINT8_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_receive, read status register failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_receive(ahtxx_handle->i2c_dev_handle, rx, I2C_UINT8_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_receive, read status register failed" );
 
     /* set status register */
     ahtxx_handle->status_reg.reg = rx[0];
 
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_AHTXX_CMD_DELAY_MS));
-
     return ESP_OK;
 }
 
@@ -174,8 +193,8 @@ esp_err_t i2c_ahtxx_init(i2c_master_bus_handle_t bus_handle, const i2c_ahtxx_con
         ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(bus_handle, &i2c_dev_conf, &out_handle->i2c_dev_handle), err_handle, TAG, "i2c new bus for init failed");
     }
 
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_AHTXX_CMD_DELAY_MS));
+    /* register device for i2c statistics */
+    ESP_GOTO_ON_ERROR(i2c_master_stats_register(out_handle->i2c_dev_handle, ahtxx_config->dev_config.device_address), err_handle, TAG, "register i2c statistics for init failed");
 
     /* attempt soft-reset */
     ESP_GOTO_ON_ERROR(i2c_ahtxx_reset(out_handle), err_handle, TAG, "soft-reset for init failed");
@@ -191,6 +210,7 @@ esp_err_t i2c_ahtxx_init(i2c_master_bus_handle_t bus_handle, const i2c_ahtxx_con
     err_handle:
         /* clean up handle instance */
         if (out_handle && out_handle->i2c_dev_handle) {
+            i2c_master_stats_unregister(out_handle->i2c_dev_handle);
             i2c_master_bus_rm_device(out_handle->i2c_dev_handle);
         }
         free(out_handle);
@@ -198,64 +218,97 @@ esp_err_t i2c_ahtxx_init(i2c_master_bus_handle_t bus_handle, const i2c_ahtxx_con
         return ret;
 }
 
-esp_err_t i2c_ahtxx_get_measurement(i2c_ahtxx_handle_t ahtxx_handle, float *const temperature, float *const humidity) {
-    //esp_err_t    ret        = ESP_OK;
-    //uint64_t     start_time = 0;
-    //bool         is_busy    = true;
-    uint32_t     raw       = 0;
-    i2c_uint24_t tx         = { I2C_AHTXX_CMD_TRIGGER_MEAS, I2C_AHTXX_CTRL_MEAS, I2C_AHTXX_CTRL_NOP };
-    i2c_uint48_t rx         = { 0, 0, 0, 0, 0, 0 };
+esp_err_t i2c_ahtxx_start_measurement(i2c_ahtxx_handle_t ahtxx_handle) {
+    i2c_uint24_t tx = { I2C_AHTXX_CMD_TRIGGER_MEAS, I2C_AHTXX_CTRL_MEAS, I2C_AHTXX_CTRL_NOP };
 
     /* validate arguments */
     ESP_ARG_CHECK( ahtxx_handle );
 
+    /* attempt i2c write transaction */
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit(ahtxx_handle->i2c_dev_handle, tx, I2C_UINT24_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "write measurement trigger command for start measurement failed" );
+
     /* set start time (us) for timeout monitoring */
-    //start_time = esp_timer_get_time(); 
+    ahtxx_handle->measurement_start_us = esp_timer_get_time();
+    ahtxx_handle->measurement_pending  = true;
 
-    /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(ahtxx_handle->i2c_dev_handle, tx, I2C_UINT24_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "write measurement trigger command for get measurement failed" );
+    return ESP_OK;
+}
 
-    vTaskDelay(pdMS_TO_TICKS(I2C_AHTXX_DATA_POLL_TIMEOUT_MS));
+esp_err_t i2c_ahtxx_read_if_ready(i2c_ahtxx_handle_t ahtxx_handle, bool *const ready, float *const temperature, float *const humidity) {
+    i2c_uint48_t rx = { 0, 0, 0, 0, 0, 0 };
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ahtxx_handle && ready && temperature && humidity );
 
-    /* delay before next i2c transaction */
-    //vTaskDelay(pdMS_TO_TICKS(I2C_AHTXX_CMD_DELAY_MS));
+    /* validate measurement state */
+    if(ahtxx_handle->measurement_pending == false) return ESP_ERR_INVALID_STATE;
 
-    /* attempt to poll status until data is available or timeout occurs  */
-    /*
-        NOTE this causes problems since ESP-IDF v5.3.1, unexpected NACK but it may be hardware related
-        some breakout SHT20 boards tested work with the do..while loop where others don't and generate an unexpected NACK
-        the SHT10 board tested generates an unexpected NACK
+    *ready = false;
+
+    /* 
+        attempt i2c read transaction, the status byte leads the measurement frame.  the 
+        status register command isn't issued while polling, see the unexpected NACK note
+        of ESP-IDF v5.3.1 on some breakout boards when the status was polled by command 
     */
-    //do {
-        /* attempt to check if data is ready */
-    //    ESP_GOTO_ON_ERROR( i2c_ahtxx_get_busy_status(ahtxx_handle, &is_busy), err, TAG, "is busy read for get measurement failed." );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_receive(ahtxx_handle->i2c_dev_handle, rx, I2C_UINT48_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "read measurement data for read if ready failed" );
 
-        /* delay task before next i2c transaction */
-    //    vTaskDelay(pdMS_TO_TICKS(I2C_AHTXX_DATA_READY_DELAY_MS));
+    /* set status register */
+    ahtxx_handle->status_reg.reg = rx[0];
 
+    /* validate conversion state */
+    if(ahtxx_handle->status_reg.bits.busy == true) {
         /* validate timeout condition */
-    //    if (ESP_TIMEOUT_CHECK(start_time, (I2C_AHTXX_DATA_POLL_TIMEOUT_MS * 1000)))
-    //        return ESP_ERR_TIMEOUT;
-    //} while (is_busy == true);
+        if (ESP_TIMEOUT_CHECK(ahtxx_handle->measurement_start_us, (I2C_AHTXX_DATA_POLL_TIMEOUT_MS * 1000))) {
+            ahtxx_handle->measurement_pending = false;
+            return ESP_ERR_TIMEOUT;
+        }
+        return ESP_OK;
+    }
 
-    /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_receive(ahtxx_handle->i2c_dev_handle, rx, I2C_UINT48_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "read measurement data for get measurement failed" );
+    /* compute and set temperature and humidity */
+    i2c_ahtxx_decode_measurement(rx, temperature, humidity);
 
-    /* compute and set humidity */
-    raw = ((uint32_t)rx[1] << 12) | ((uint32_t)rx[2] << 4) | (rx[3] >> 4);
-    *humidity = (float)(raw * 100) / (float)0x100000;
+    ahtxx_handle->measurement_pending = false;
+    *ready = true;
 
-    /* compute and set temperature */
-    raw = ((uint32_t)(rx[3] & 0x0f) << 16) | ((uint32_t)rx[4] << 8) | rx[5];
-    *temperature = (float)(raw * 200) / (float)0x100000 - 50;
+    return ESP_OK;
+}
+
+esp_err_t i2c_ahtxx_wait_measurement(i2c_ahtxx_handle_t ahtxx_handle, float *const temperature, float *const humidity) {
+    bool ready = false;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( ahtxx_handle && temperature && humidity );
+
+    /* validate measurement state */
+    if(ahtxx_handle->measurement_pending == false) return ESP_ERR_INVALID_STATE;
+
+    /* delay task for the remainder of the typical conversion time */
+    i2c_ahtxx_delay_us(ahtxx_handle->measurement_start_us + I2C_AHTXX_MEASUREMENT_TIME_US - esp_timer_get_time());
+
+    /* attempt to poll the busy bit until data is available or timeout occurs */
+    for ( ;; ) {
+        ESP_RETURN_ON_ERROR( i2c_ahtxx_read_if_ready(ahtxx_handle, &ready, temperature, humidity), TAG, "read if ready for wait measurement failed" );
+        if(ready == true) break;
+
+        /* delay task before next i2c transaction */
+        vTaskDelay(pdMS_TO_TICKS(I2C_AHTXX_DATA_READY_DELAY_MS));
+    }
 
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_AHTXX_CMD_DELAY_MS));
-    
     return ESP_OK;
+}
+
+esp_err_t i2c_ahtxx_get_measurement(i2c_ahtxx_handle_t ahtxx_handle, float *const temperature, float *const humidity) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ahtxx_handle && temperature && humidity );
+
+    /* attempt to trigger a measurement */
+    ESP_RETURN_ON_ERROR( i2c_ahtxx_start_measurement(ahtxx_handle), TAG, "start measurement for get measurement failed" );
 
-    //err:
-    //    return ret;
+    /* attempt to wait for and read the measurement */
+    ESP_RETURN_ON_ERROR( i2c_ahtxx_wait_measurement(ahtxx_handle, temperature, humidity), TAG, "wait measurement for get measurement failed" );
+    
+    return ESP_OK;
 }
 
 esp_err_t i2c_ahtxx_get_measurements(i2c_ahtxx_handle_t ahtxx_handle, float *const temperature, float *const humidity, float *const dewpoint) {
@@ -335,9 +388,19 @@ esp_err_t i2c_ahtxx_reset(i2c_ahtxx_handle_t ahtxx_handle) {
         ESP_RETURN_ON_ERROR(i2c_ahtxx_get_status_register(ahtxx_handle), TAG, "read status register for reset failed");
     }
 
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_AHTXX_CMD_DELAY_MS));
-    
+    return ESP_OK;
+}
+
+esp_err_t i2c_ahtxx_reinit(i2c_ahtxx_handle_t ahtxx_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( ahtxx_handle );
+
+    /* a triggered measurement is lost with the soft-reset */
+    ahtxx_handle->measurement_pending = false;
+
+    /* attempt soft-reset and calibration setup */
+    ESP_RETURN_ON_ERROR(i2c_ahtxx_reset(ahtxx_handle), TAG, "soft-reset for reinit failed");
+
     return ESP_OK;
 }
 
@@ -345,6 +408,9 @@ esp_err_t i2c_ahtxx_rm(i2c_ahtxx_handle_t ahtxx_handle) {
     /* validate arguments */
     ESP_ARG_CHECK( ahtxx_handle );
 
+    /* unregister device from i2c statistics, statistics of the device address are kept */
+    i2c_master_stats_unregister(ahtxx_handle->i2c_dev_handle);
+
     /* remove device from i2c master bus */
     return i2c_master_bus_rm_device(ahtxx_handle->i2c_dev_handle);
 }
\ No newline at end of file
@@ -52,6 +52,9 @@ extern "C"
 
 #define I2C_AHTXX_DEV_ADDR              UINT8_C(0x38) //!< ahtxx I2C address
 
+#define I2C_AHTXX_TURNAROUND_US         UINT32_C(1000)  //!< ahtxx minimum time between I2C transactions, covers the unexpected NACKs of some breakout boards
+#define I2C_AHTXX_MEASUREMENT_TIME_US   UINT32_C(80000) //!< ahtxx typical measurement conversion time
+
 
 /*
  * AHTXX macro definitions
@@ -116,6 +119,8 @@ extern "C"
         i2c_master_dev_handle_t     i2c_dev_handle; /*!< I2C device handle */
         i2c_ahtxx_types_t           aht_type;
         i2c_ahtxx_status_register_t status_reg; /*!< status register */
+        bool                        measurement_pending;    /*!< measurement was triggered and is not collected yet */
+        int64_t                     measurement_start_us;   /*!< time of the pending measurement trigger in micro-seconds */
     };
 
     /**
@@ -156,7 +161,7 @@ extern "C"
     esp_err_t i2c_ahtxx_init(i2c_master_bus_handle_t bus_handle, const i2c_ahtxx_config_t *ahtxx_config, i2c_ahtxx_handle_t *ahtxx_handle);
 
     /**
-     * @brief Reads temperature and relative humidity from AHTXX.
+     * @brief Reads temperature and relative humidity from AHTXX, triggers a measurement and waits for it.
      *
      * @param ahtxx_handle AHTXX device handle.
      * @param temperature temperature in degree Celsius.
@@ -165,6 +170,52 @@ extern "C"
      */
     esp_err_t i2c_ahtxx_get_measurement(i2c_ahtxx_handle_t ahtxx_handle, float *const temperature, float *const humidity);
 
+    /**
+     * @brief Triggers a measurement on AHTXX and returns without waiting for the conversion.  
+     * Collect the measurement with `i2c_ahtxx_read_if_ready` or `i2c_ahtxx_wait_measurement`, 
+     * the conversion typically takes 80 ms.
+     *
+     * @param ahtxx_handle AHTXX device handle.
+     * @return esp_err_t ESP_OK on success.
+     */
+    esp_err_t i2c_ahtxx_start_measurement(i2c_ahtxx_handle_t ahtxx_handle);
+
+    /**
+     * @brief Reads the measurement started by `i2c_ahtxx_start_measurement` when the conversion 
+     * is complete.  The status byte of the measurement frame is checked, the status register 
+     * command is not issued.
+     *
+     * @param[in] ahtxx_handle AHTXX device handle.
+     * @param[out] ready measurement is complete and collected when true, temperature and humidity are unchanged otherwise.
+     * @param[out] temperature temperature in degree Celsius.
+     * @param[out] humidity relative humidity in percentage.
+     * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when no measurement is pending, 
+     * ESP_ERR_TIMEOUT when the device is still busy after the data poll timeout.
+     */
+    esp_err_t i2c_ahtxx_read_if_ready(i2c_ahtxx_handle_t ahtxx_handle, bool *const ready, float *const temperature, float *const humidity);
+
+    /**
+     * @brief Waits for the measurement started by `i2c_ahtxx_start_measurement` and reads it.  The 
+     * busy bit is polled once the typical conversion time since the trigger has elapsed, the wait 
+     * is bounded by the data poll timeout.
+     *
+     * @param[in] ahtxx_handle AHTXX device handle.
+     * @param[out] temperature temperature in degree Celsius.
+     * @param[out] humidity relative humidity in percentage.
+     * @return esp_err_t ESP_OK on success.
+     */
+    esp_err_t i2c_ahtxx_wait_measurement(i2c_ahtxx_handle_t ahtxx_handle, float *const temperature, float *const humidity);
+
+    /**
+     * @brief Calculates dewpoint temperature from air temperature and relative humidity.
+     *
+     * @param[in] temperature air temperature in degrees Celsius.
+     * @param[in] humidity relative humiity in percent.
+     * @param[out] dewpoint calculated dewpoint temperature in degrees Celsius.
+     * @return esp_err_t ESP_OK on success.
+     */
+    esp_err_t i2c_ahtxx_calculate_dewpoint(const float temperature, const float humidity, float *const dewpoint);
+
     /**
      * @brief Similar to `i2c_aht2x_read_measurement` but it includes dewpoint in the results.
      *
@@ -212,6 +263,15 @@ extern "C"
      */
     esp_err_t i2c_ahtxx_reset(i2c_ahtxx_handle_t ahtxx_handle);
 
+    /**
+     * @brief Re-initializes AHTXX after a bus fault or power glitch, a triggered measurement 
+     * is discarded and the device is soft-reset and calibrated.
+     *
+     * @param ahtxx_handle AHTXX device handle.
+     * @return esp_err_t ESP_OK on success.
+     */
+    esp_err_t i2c_ahtxx_reinit(i2c_ahtxx_handle_t ahtxx_handle);
+
     /**
      * @brief removes an ahtxx device from master bus.
      *
@@ -40,13 +40,18 @@
 #include <esp_log.h>
 #include <esp_check.h>
 #include <esp_timer.h>
+#include <esp_rom_sys.h>
 #include <i2c_master_ext.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <nvs.h>
 
 /**
  * possible BMP280 registers
  */
+#define I2C_BMP280_REG_HUM_LSB      0xFE
+#define I2C_BMP280_REG_HUM_MSB      0xFD
+#define I2C_BMP280_REG_HUM          (I2C_BMP280_REG_HUM_MSB)
 #define I2C_BMP280_REG_TEMP_XLSB    0xFC /* bits: 7-4 */
 #define I2C_BMP280_REG_TEMP_LSB     0xFB
 #define I2C_BMP280_REG_TEMP_MSB     0xFA
@@ -62,19 +67,23 @@
 #define I2C_BMP280_REG_RESET        0xE0
 #define I2C_BMP280_REG_ID           0xD0
 #define I2C_BMP280_REG_CALIB        0x88
-#define I2C_BMP280_REG_HUM_CALIB    0x88
+#define I2C_BMP280_REG_HUM_CALIB    0xE1
 #define I2C_BMP280_RESET_VALUE      0xB6
+#define I2C_BMP280_CALIB_SIZE       24   /* 0x88 to 0x9F, T1-T3 and P1-P9 little-endian words */
+#define I2C_BME280_CALIB_SIZE       26   /* 0x88 to 0xA1, T1-T3, P1-P9, reserved and H1 */
+#define I2C_BME280_HUM_CALIB_SIZE   7    /* 0xE1 to 0xE7, H2-H6 */
+#define I2C_BMP280_CALIB_SIZE_MAX   (I2C_BME280_CALIB_SIZE + I2C_BME280_HUM_CALIB_SIZE)
+#define I2C_BMP280_CONFIG_MASK      0xFD /* writable bits, bit 1 is reserved */
+#define I2C_BMP280_CTRL_MASK        0xFF
+#define I2C_BMP280_CTRL_HUM_MASK    0x07 /* writable bits, bits 7-3 are reserved */
 
-#define I2C_BMP280_TYPE_BMP280      0x58  //!< BMP280
-#define I2C_BMP280_TYPE_BME280      0x60  //!< BME280
+#define I2C_BMP280_NVS_NAMESPACE    "bmp280"
 
 #define I2C_BMP280_DATA_POLL_TIMEOUT_MS  UINT16_C(250) // ? see datasheet tables 13 and 14, standby-time could be 2-seconds (2000ms)
 #define I2C_BMP280_DATA_READY_DELAY_MS   UINT16_C(1)
 #define I2C_BMP280_POWERUP_DELAY_MS      UINT16_C(25)  // start-up time is 2-ms
 #define I2C_BMP280_APPSTART_DELAY_MS     UINT16_C(25)
 #define I2C_BMP280_RESET_DELAY_MS        UINT16_C(25)
-#define I2C_BMP280_CMD_DELAY_MS          UINT16_C(5)
-#define I2C_BMP280_TX_RX_DELAY_MS        UINT16_C(10)
 
 /*
  * macro definitions
@@ -139,29 +148,391 @@ static inline uint32_t i2c_bmp280_compensate_pressure(i2c_bmp280_handle_t bmp280
 }
 
 /**
- * @brief reads calibration factors onboard the bmp280.  see datasheet for details.
+ * @brief 32-bit pressure compensation algorithm is taken from datasheet section 8.2.  see datasheet for details.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[in] adc_pressure raw adc pressure.
+ * @param[in] fine_temperature fine temperature in degrees Celsius.
+ * @return Pa, 1 Pa resolution.
+ */
+static inline uint32_t i2c_bmp280_compensate_pressure_int32(i2c_bmp280_handle_t bmp280_handle, const int32_t adc_pressure, const int32_t fine_temperature) {
+    int32_t var1, var2;
+    uint32_t p;
+
+    var1 = (fine_temperature >> 1) - (int32_t)64000;
+    var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * (int32_t)bmp280_handle->dev_cal_factors->dig_P6;
+    var2 = var2 + ((var1 * (int32_t)bmp280_handle->dev_cal_factors->dig_P5) << 1);
+    var2 = (var2 >> 2) + ((int32_t)bmp280_handle->dev_cal_factors->dig_P4 << 16);
+    var1 = ((((int32_t)bmp280_handle->dev_cal_factors->dig_P3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) + (((int32_t)bmp280_handle->dev_cal_factors->dig_P2 * var1) >> 1)) >> 18;
+    var1 = ((32768 + var1) * (int32_t)bmp280_handle->dev_cal_factors->dig_P1) >> 15;
+
+    if (var1 == 0) {
+        return 0;  // avoid exception caused by division by zero
+    }
+
+    p = ((uint32_t)((int32_t)1048576 - adc_pressure) - (uint32_t)(var2 >> 12)) * 3125;
+    if (p < 0x80000000) {
+        p = (p << 1) / (uint32_t)var1;
+    } else {
+        p = (p / (uint32_t)var1) * 2;
+    }
+    var1 = ((int32_t)bmp280_handle->dev_cal_factors->dig_P9 * (int32_t)(((p >> 3) * (p >> 3)) >> 13)) >> 12;
+    var2 = ((int32_t)(p >> 2) * (int32_t)bmp280_handle->dev_cal_factors->dig_P8) >> 13;
+    p = (uint32_t)((int32_t)p + ((var1 + var2 + bmp280_handle->dev_cal_factors->dig_P7) >> 4));
+
+    return p;
+}
+
+/**
+ * @brief floating-point temperature compensation algorithm is taken from datasheet section 8.1 in single-precision.  see datasheet for details.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[in] adc_temperature raw adc temperature.
+ * @param[out] fine_temperature fine temperature, not truncated.
+ * @return temperature in degrees Celsius.
+ */
+static inline float i2c_bmp280_compensate_temperature_float(i2c_bmp280_handle_t bmp280_handle, const int32_t adc_temperature, float *const fine_temperature) {
+    const float t1 = (float)bmp280_handle->dev_cal_factors->dig_T1;
+    float var1, var2;
+
+    var1 = ((float)adc_temperature / 16384.0f - t1 / 1024.0f) * (float)bmp280_handle->dev_cal_factors->dig_T2;
+    var2 = ((float)adc_temperature / 131072.0f - t1 / 8192.0f);
+    var2 = var2 * var2 * (float)bmp280_handle->dev_cal_factors->dig_T3;
+
+    *fine_temperature = var1 + var2;
+
+    return *fine_temperature / 5120.0f;
+}
+
+/**
+ * @brief floating-point pressure compensation algorithm is taken from datasheet section 8.1 in single-precision.  see datasheet for details.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[in] adc_pressure raw adc pressure.
+ * @param[in] fine_temperature fine temperature, not truncated.
+ * @return Pa.
+ */
+static inline float i2c_bmp280_compensate_pressure_float(i2c_bmp280_handle_t bmp280_handle, const int32_t adc_pressure, const float fine_temperature) {
+    float var1, var2, p;
+
+    var1 = fine_temperature / 2.0f - 64000.0f;
+    var2 = var1 * var1 * (float)bmp280_handle->dev_cal_factors->dig_P6 / 32768.0f;
+    var2 = var2 + var1 * (float)bmp280_handle->dev_cal_factors->dig_P5 * 2.0f;
+    var2 = var2 / 4.0f + (float)bmp280_handle->dev_cal_factors->dig_P4 * 65536.0f;
+    var1 = ((float)bmp280_handle->dev_cal_factors->dig_P3 * var1 * var1 / 524288.0f + (float)bmp280_handle->dev_cal_factors->dig_P2 * var1) / 524288.0f;
+    var1 = (1.0f + var1 / 32768.0f) * (float)bmp280_handle->dev_cal_factors->dig_P1;
+
+    if (var1 == 0.0f) {
+        return 0;  // avoid exception caused by division by zero
+    }
+
+    p = 1048576.0f - (float)adc_pressure;
+    p = (p - var2 / 4096.0f) * 6250.0f / var1;
+    var1 = (float)bmp280_handle->dev_cal_factors->dig_P9 * p * p / 2147483648.0f;
+    var2 = p * (float)bmp280_handle->dev_cal_factors->dig_P8 / 32768.0f;
+    p = p + (var1 + var2 + (float)bmp280_handle->dev_cal_factors->dig_P7) / 16.0f;
+
+    return p;
+}
+
+/**
+ * @brief bme280 humidity compensation algorithm is taken from bme280 datasheet section 4.2.3.  see datasheet for details.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[in] adc_humidity raw adc humidity.
+ * @param[in] fine_temperature fine temperature in degrees Celsius.
+ * @return %RH, 22 integer bits and 10 fractional bits.
+ */
+static inline uint32_t i2c_bmp280_compensate_humidity(i2c_bmp280_handle_t bmp280_handle, const int32_t adc_humidity, const int32_t fine_temperature) {
+    int32_t var1;
+
+    var1 = fine_temperature - (int32_t)76800;
+    var1 = ((((adc_humidity << 14) - ((int32_t)bmp280_handle->dev_cal_factors->dig_H4 << 20) - ((int32_t)bmp280_handle->dev_cal_factors->dig_H5 * var1)) + (int32_t)16384) >> 15) *
+            (((((((var1 * (int32_t)bmp280_handle->dev_cal_factors->dig_H6) >> 10) * (((var1 * (int32_t)bmp280_handle->dev_cal_factors->dig_H3) >> 11) + (int32_t)32768)) >> 10) + 
+            (int32_t)2097152) * (int32_t)bmp280_handle->dev_cal_factors->dig_H2 + 8192) >> 14);
+    var1 = var1 - (((((var1 >> 15) * (var1 >> 15)) >> 7) * (int32_t)bmp280_handle->dev_cal_factors->dig_H1) >> 4);
+    var1 = (var1 < 0) ? 0 : var1;
+    var1 = (var1 > 419430400) ? 419430400 : var1;
+
+    return (uint32_t)(var1 >> 12);
+}
+
+/**
+ * @brief bme280 floating-point humidity compensation algorithm is taken from bme280 datasheet section 8.1 in single-precision.  see datasheet for details.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[in] adc_humidity raw adc humidity.
+ * @param[in] fine_temperature fine temperature, not truncated.
+ * @return %RH.
+ */
+static inline float i2c_bmp280_compensate_humidity_float(i2c_bmp280_handle_t bmp280_handle, const int32_t adc_humidity, const float fine_temperature) {
+    float var_h;
+
+    var_h = fine_temperature - 76800.0f;
+    var_h = ((float)adc_humidity - ((float)bmp280_handle->dev_cal_factors->dig_H4 * 64.0f + (float)bmp280_handle->dev_cal_factors->dig_H5 / 16384.0f * var_h)) *
+            ((float)bmp280_handle->dev_cal_factors->dig_H2 / 65536.0f * (1.0f + (float)bmp280_handle->dev_cal_factors->dig_H6 / 67108864.0f * var_h *
+            (1.0f + (float)bmp280_handle->dev_cal_factors->dig_H3 / 67108864.0f * var_h)));
+    var_h = var_h * (1.0f - (float)bmp280_handle->dev_cal_factors->dig_H1 * var_h / 524288.0f);
+
+    return (var_h > 100.0f) ? 100.0f : (var_h < 0.0f) ? 0.0f : var_h;
+}
+
+/**
+ * @brief compensates raw adc temperature, pressure and humidity with the compensation back-end of the handle.
+ * bme280 humidity is compensated with the 32-bit integer algorithm by both integer back-ends.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[in] adc_temperature raw adc temperature.
+ * @param[in] adc_pressure raw adc pressure, ignored when pressure is NULL.
+ * @param[in] adc_humidity raw adc humidity, ignored when humidity is NULL.
+ * @param[out] temperature temperature in degrees Celsius.
+ * @param[out] pressure pressure in Pa, NULL to skip pressure compensation.
+ * @param[out] humidity relative humidity in percent, NULL to skip humidity compensation.
+ */
+static inline void i2c_bmp280_compensate_measurements(i2c_bmp280_handle_t bmp280_handle, const int32_t adc_temperature, const int32_t adc_pressure, const int32_t adc_humidity, 
+                                                      float *const temperature, float *const pressure, float *const humidity) {
+    int32_t fine_temp;
+    float   fine_temp_float;
+
+    switch(bmp280_handle->compensation) {
+        case I2C_BMP280_COMPENSATION_FLOAT:
+            *temperature = i2c_bmp280_compensate_temperature_float(bmp280_handle, adc_temperature, &fine_temp_float);
+            if(pressure) *pressure = i2c_bmp280_compensate_pressure_float(bmp280_handle, adc_pressure, fine_temp_float);
+            if(humidity) *humidity = i2c_bmp280_compensate_humidity_float(bmp280_handle, adc_humidity, fine_temp_float);
+            break;
+        case I2C_BMP280_COMPENSATION_INT32:
+            *temperature = (float)i2c_bmp280_compensate_temperature(bmp280_handle, adc_temperature, &fine_temp) / 100;
+            if(pressure) *pressure = (float)i2c_bmp280_compensate_pressure_int32(bmp280_handle, adc_pressure, fine_temp);
+            if(humidity) *humidity = (float)i2c_bmp280_compensate_humidity(bmp280_handle, adc_humidity, fine_temp) / 1024;
+            break;
+        default:
+            *temperature = (float)i2c_bmp280_compensate_temperature(bmp280_handle, adc_temperature, &fine_temp) / 100;
+            if(pressure) *pressure = (float)i2c_bmp280_compensate_pressure(bmp280_handle, adc_pressure, fine_temp) / 256;
+            if(humidity) *humidity = (float)i2c_bmp280_compensate_humidity(bmp280_handle, adc_humidity, fine_temp) / 1024;
+            break;
+    }
+}
+
+/**
+ * @brief converts an oversampling setting to the number of samples.
+ *
+ * @param[in] oversampling oversampling setting, 0 skips the measurement.
+ * @return number of samples.
+ */
+static inline uint32_t i2c_bmp280_get_oversampling_count(const uint8_t oversampling) {
+    return (oversampling == 0) ? 0 : (oversampling >= 5) ? 16 : (1u << (oversampling - 1));
+}
+
+/**
+ * @brief calculates the measurement time of the configured oversampling.  see datasheet section 3.8.1 and 
+ * bme280 datasheet section 9.1 for details.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[in] maximum maximum measurement time when true, typical measurement time otherwise.
+ * @return measurement time in micro-seconds.
+ */
+static inline uint32_t i2c_bmp280_get_measurement_time_us(i2c_bmp280_handle_t bmp280_handle, const bool maximum) {
+    const uint32_t osrs_t = i2c_bmp280_get_oversampling_count(bmp280_handle->ctrl_meas_reg.bits.temperature_oversampling);
+    const uint32_t osrs_p = i2c_bmp280_get_oversampling_count(bmp280_handle->ctrl_meas_reg.bits.pressure_oversampling);
+    const uint32_t osrs_h = (bmp280_handle->dev_type == I2C_BMP280_TYPE_BME280) ? 
+                            i2c_bmp280_get_oversampling_count(bmp280_handle->ctrl_hum_reg.bits.humidity_oversampling) : 0;
+
+    if(maximum == true) {
+        return 1250 + 2300 * osrs_t + ((osrs_p > 0) ? 2300 * osrs_p + 575 : 0) + ((osrs_h > 0) ? 2300 * osrs_h + 575 : 0);
+    }
+    return 1000 + 2000 * osrs_t + ((osrs_p > 0) ? 2000 * osrs_p + 500 : 0) + ((osrs_h > 0) ? 2000 * osrs_h + 500 : 0);
+}
+
+/**
+ * @brief converts the configured standby time to micro-seconds.  see datasheet table 11 for details.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @return standby time in micro-seconds.
+ */
+static inline uint32_t i2c_bmp280_get_standby_time_us(i2c_bmp280_handle_t bmp280_handle) {
+    static const uint32_t standby_us[8] = { 500, 62500, 125000, 250000, 500000, 1000000, 2000000, 4000000 };
+    const uint8_t         standby_time  = bmp280_handle->config_reg.bits.standby_time;
+
+    /* bme280 standby times of the two longest settings are 10 and 20 ms */
+    if(bmp280_handle->dev_type == I2C_BMP280_TYPE_BME280 && standby_time >= I2C_BMP280_STANDBY_TIME_2000MS) {
+        return (standby_time == I2C_BMP280_STANDBY_TIME_2000MS) ? 10000 : 20000;
+    }
+
+    return standby_us[standby_time];
+}
+
+/**
+ * @brief delays the task until the due time, whole ticks are delayed and the remainder of a tick is
+ * busy-waited.  a delay of n ticks wakes on the n-th tick boundary and may end early by up to a tick.
+ *
+ * @param[in] due_us due time in micro-seconds.
+ */
+static inline void i2c_bmp280_delay_until(const int64_t due_us) {
+    const int64_t tick_us = (int64_t)portTICK_PERIOD_MS * 1000;
+    int64_t       delay_us = due_us - esp_timer_get_time();
+
+    /* the remainder is recomputed after every delay */
+    while(delay_us >= tick_us) {
+        vTaskDelay((TickType_t)(delay_us / tick_us));
+        delay_us = due_us - esp_timer_get_time();
+    }
+
+    if(delay_us > 0) {
+        esp_rom_delay_us((uint32_t)delay_us);
+    }
+}
+
+/**
+ * @brief decodes calibration factors from the little-endian calibration block.  see datasheet for details.
+ *
+ * @param[in] calib calibration block, registers 0x88 to 0x9F.
+ * @param[out] cal_factors calibration factors.
+ */
+static inline void i2c_bmp280_decode_cal_factors(const uint8_t calib[I2C_BMP280_CALIB_SIZE], i2c_bmp280_cal_factors_t *const cal_factors) {
+    cal_factors->dig_T1 = (uint16_t)(calib[1]  << 8 | calib[0]);
+    cal_factors->dig_T2 = (int16_t) (calib[3]  << 8 | calib[2]);
+    cal_factors->dig_T3 = (int16_t) (calib[5]  << 8 | calib[4]);
+    cal_factors->dig_P1 = (uint16_t)(calib[7]  << 8 | calib[6]);
+    cal_factors->dig_P2 = (int16_t) (calib[9]  << 8 | calib[8]);
+    cal_factors->dig_P3 = (int16_t) (calib[11] << 8 | calib[10]);
+    cal_factors->dig_P4 = (int16_t) (calib[13] << 8 | calib[12]);
+    cal_factors->dig_P5 = (int16_t) (calib[15] << 8 | calib[14]);
+    cal_factors->dig_P6 = (int16_t) (calib[17] << 8 | calib[16]);
+    cal_factors->dig_P7 = (int16_t) (calib[19] << 8 | calib[18]);
+    cal_factors->dig_P8 = (int16_t) (calib[21] << 8 | calib[20]);
+    cal_factors->dig_P9 = (int16_t) (calib[23] << 8 | calib[22]);
+}
+
+/**
+ * @brief decodes bme280 humidity calibration factors from the calibration block.  see bme280 datasheet section 4.2.2 for details.
+ *
+ * @param[in] calib calibration block, registers 0x88 to 0xA1 followed by registers 0xE1 to 0xE7.
+ * @param[out] cal_factors calibration factors.
+ */
+static inline void i2c_bmp280_decode_hum_cal_factors(const uint8_t calib[I2C_BMP280_CALIB_SIZE_MAX], i2c_bmp280_cal_factors_t *const cal_factors) {
+    const uint8_t *const hum_calib = calib + I2C_BME280_CALIB_SIZE;
+
+    cal_factors->dig_H1 = calib[25];
+    cal_factors->dig_H2 = (int16_t) (hum_calib[1] << 8 | hum_calib[0]);
+    cal_factors->dig_H3 = hum_calib[2];
+    cal_factors->dig_H4 = (int16_t) ((int8_t)hum_calib[3] * 16 | (hum_calib[4] & 0x0F));
+    cal_factors->dig_H5 = (int16_t) ((int8_t)hum_calib[5] * 16 | (hum_calib[4] >> 4));
+    cal_factors->dig_H6 = (int8_t)  hum_calib[6];
+}
+
+/**
+ * @brief gets the calibration block size of the device type, the bme280 block adds the humidity calibration.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @return calibration block size in bytes.
+ */
+static inline size_t i2c_bmp280_get_cal_size(i2c_bmp280_handle_t bmp280_handle) {
+    return (bmp280_handle->dev_type == I2C_BMP280_TYPE_BME280) ? I2C_BMP280_CALIB_SIZE_MAX : I2C_BMP280_CALIB_SIZE;
+}
+
+/**
+ * @brief formats the nvs key of the cached calibration block, the calibration block is 
+ * keyed by chip identifier and device address.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[out] key nvs key, at least `NVS_KEY_NAME_MAX_SIZE` characters.
+ */
+static inline void i2c_bmp280_get_cal_factors_key(i2c_bmp280_handle_t bmp280_handle, char *const key) {
+    snprintf(key, NVS_KEY_NAME_MAX_SIZE, "cal_%02x_%02x", bmp280_handle->dev_type, bmp280_handle->dev_address);
+}
+
+/**
+ * @brief reads the calibration block from the nvs cache.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[out] calib calibration block, see `i2c_bmp280_get_cal_size`.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t i2c_bmp280_read_cal_cache(i2c_bmp280_handle_t bmp280_handle, uint8_t calib[I2C_BMP280_CALIB_SIZE_MAX]) {
+    nvs_handle_t nvs_handle;
+    char         key[NVS_KEY_NAME_MAX_SIZE];
+    size_t       size = i2c_bmp280_get_cal_size(bmp280_handle);
+
+    i2c_bmp280_get_cal_factors_key(bmp280_handle, key);
+
+    ESP_RETURN_ON_ERROR( nvs_open(I2C_BMP280_NVS_NAMESPACE, NVS_READONLY, &nvs_handle), TAG, "open nvs namespace for read calibration cache failed" );
+    esp_err_t ret = nvs_get_blob(nvs_handle, key, calib, &size);
+    nvs_close(nvs_handle);
+
+    ESP_RETURN_ON_ERROR( ret, TAG, "read nvs blob for read calibration cache failed" );
+    ESP_RETURN_ON_FALSE( size == i2c_bmp280_get_cal_size(bmp280_handle), ESP_ERR_INVALID_SIZE, TAG, "invalid nvs blob size for read calibration cache" );
+
+    return ESP_OK;
+}
+
+/**
+ * @brief writes the calibration block to the nvs cache.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[in] calib calibration block, see `i2c_bmp280_get_cal_size`.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t i2c_bmp280_write_cal_cache(i2c_bmp280_handle_t bmp280_handle, const uint8_t calib[I2C_BMP280_CALIB_SIZE_MAX]) {
+    nvs_handle_t nvs_handle;
+    char         key[NVS_KEY_NAME_MAX_SIZE];
+
+    i2c_bmp280_get_cal_factors_key(bmp280_handle, key);
+
+    ESP_RETURN_ON_ERROR( nvs_open(I2C_BMP280_NVS_NAMESPACE, NVS_READWRITE, &nvs_handle), TAG, "open nvs namespace for write calibration cache failed" );
+    esp_err_t ret = nvs_set_blob(nvs_handle, key, calib, i2c_bmp280_get_cal_size(bmp280_handle));
+    if(ret == ESP_OK) ret = nvs_commit(nvs_handle);
+    nvs_close(nvs_handle);
+
+    ESP_RETURN_ON_ERROR( ret, TAG, "write nvs blob for write calibration cache failed" );
+
+    return ESP_OK;
+}
+
+/**
+ * @brief reads calibration factors onboard the bmp280 with a single burst read of the 
+ * calibration block, or from the nvs cache when enabled.  see datasheet for details.
  *
  * @param[in] bmp280_handle bmp280 device handle.
  * @return esp_err_t ESP_OK on success.
  */
 static inline esp_err_t i2c_bmp280_get_cal_factors(i2c_bmp280_handle_t bmp280_handle) {
+    const i2c_uint8_t tx     = { I2C_BMP280_REG_CALIB };
+    const i2c_uint8_t hum_tx = { I2C_BMP280_REG_HUM_CALIB };
+    uint8_t           calib[I2C_BMP280_CALIB_SIZE_MAX];
+
     /* validate arguments */
     ESP_ARG_CHECK( bmp280_handle );
 
-    /* bmp280 attempt to request T1-T3 calibration values from device */
-    ESP_ERROR_CHECK( i2c_master_bus_read_uint16(bmp280_handle->i2c_dev_handle, 0x88, &bmp280_handle->dev_cal_factors->dig_T1) );
-    ESP_ERROR_CHECK( i2c_master_bus_read_uint16(bmp280_handle->i2c_dev_handle, 0x8a, (uint16_t *)&bmp280_handle->dev_cal_factors->dig_T2) );
-    ESP_ERROR_CHECK( i2c_master_bus_read_uint16(bmp280_handle->i2c_dev_handle, 0x8c, (uint16_t *)&bmp280_handle->dev_cal_factors->dig_T3) );
-    /* bmp280 attempt to request P1-P9 calibration values from device */
-    ESP_ERROR_CHECK( i2c_master_bus_read_uint16(bmp280_handle->i2c_dev_handle, 0x8e, &bmp280_handle->dev_cal_factors->dig_P1) );
-    ESP_ERROR_CHECK( i2c_master_bus_read_uint16(bmp280_handle->i2c_dev_handle, 0x90, (uint16_t *)&bmp280_handle->dev_cal_factors->dig_P2) );
-    ESP_ERROR_CHECK( i2c_master_bus_read_uint16(bmp280_handle->i2c_dev_handle, 0x92, (uint16_t *)&bmp280_handle->dev_cal_factors->dig_P3) );
-    ESP_ERROR_CHECK( i2c_master_bus_read_uint16(bmp280_handle->i2c_dev_handle, 0x94, (uint16_t *)&bmp280_handle->dev_cal_factors->dig_P4) );
-    ESP_ERROR_CHECK( i2c_master_bus_read_uint16(bmp280_handle->i2c_dev_handle, 0x96, (uint16_t *)&bmp280_handle->dev_cal_factors->dig_P5) );
-    ESP_ERROR_CHECK( i2c_master_bus_read_uint16(bmp280_handle->i2c_dev_handle, 0x98, (uint16_t *)&bmp280_handle->dev_cal_factors->dig_P6) );
-    ESP_ERROR_CHECK( i2c_master_bus_read_uint16(bmp280_handle->i2c_dev_handle, 0x9a, (uint16_t *)&bmp280_handle->dev_cal_factors->dig_P7) );
-    ESP_ERROR_CHECK( i2c_master_bus_read_uint16(bmp280_handle->i2c_dev_handle, 0x9c, (uint16_t *)&bmp280_handle->dev_cal_factors->dig_P8) );
-    ESP_ERROR_CHECK( i2c_master_bus_read_uint16(bmp280_handle->i2c_dev_handle, 0x9e, (uint16_t *)&bmp280_handle->dev_cal_factors->dig_P9) );
+    /* attempt to read calibration block from nvs cache, the device is read when it isn't cached */
+    if(bmp280_handle->cal_factors_cache == true && i2c_bmp280_read_cal_cache(bmp280_handle, calib) == ESP_OK) {
+        i2c_bmp280_decode_cal_factors(calib, bmp280_handle->dev_cal_factors);
+        if(bmp280_handle->dev_type == I2C_BMP280_TYPE_BME280) {
+            i2c_bmp280_decode_hum_cal_factors(calib, bmp280_handle->dev_cal_factors);
+        }
+
+        ESP_LOGD(TAG, "Calibration data read from nvs cache");
+
+        return ESP_OK;
+    }
+
+    if(bmp280_handle->dev_type == I2C_BMP280_TYPE_BME280) {
+        /* bme280 attempt to burst read T1-T3, P1-P9 and H1 calibration block, followed by the H2-H6 calibration block from device */
+        ESP_RETURN_ON_ERROR( i2c_master_bus_transmit_receive(bmp280_handle->i2c_dev_handle, tx, I2C_UINT8_SIZE, calib, I2C_BME280_CALIB_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "read calibration block for get calibration factors failed" );
+        ESP_RETURN_ON_ERROR( i2c_master_bus_transmit_receive(bmp280_handle->i2c_dev_handle, hum_tx, I2C_UINT8_SIZE, calib + I2C_BME280_CALIB_SIZE, I2C_BME280_HUM_CALIB_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "read humidity calibration block for get calibration factors failed" );
+
+        i2c_bmp280_decode_cal_factors(calib, bmp280_handle->dev_cal_factors);
+        i2c_bmp280_decode_hum_cal_factors(calib, bmp280_handle->dev_cal_factors);
+    } else {
+        /* bmp280 attempt to burst read T1-T3 and P1-P9 calibration block from device */
+        ESP_RETURN_ON_ERROR( i2c_master_bus_transmit_receive(bmp280_handle->i2c_dev_handle, tx, I2C_UINT8_SIZE, calib, I2C_BMP280_CALIB_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "read calibration block for get calibration factors failed" );
+
+        i2c_bmp280_decode_cal_factors(calib, bmp280_handle->dev_cal_factors);
+    }
+
+    /* attempt to write calibration block to nvs cache, the device is read at next init on failure */
+    if(bmp280_handle->cal_factors_cache == true && i2c_bmp280_write_cal_cache(bmp280_handle, calib) != ESP_OK) {
+        ESP_LOGW(TAG, "unable to cache calibration data in nvs");
+    }
 
     ESP_LOGD(TAG, "Calibration data received:");
     ESP_LOGD(TAG, "dig_T1=%u", bmp280_handle->dev_cal_factors->dig_T1);
@@ -176,32 +547,63 @@ static inline esp_err_t i2c_bmp280_get_cal_factors(i2c_bmp280_handle_t bmp280_ha
     ESP_LOGD(TAG, "dig_P7=%d", bmp280_handle->dev_cal_factors->dig_P7);
     ESP_LOGD(TAG, "dig_P8=%d", bmp280_handle->dev_cal_factors->dig_P8);
     ESP_LOGD(TAG, "dig_P9=%d", bmp280_handle->dev_cal_factors->dig_P9);
+    if(bmp280_handle->dev_type == I2C_BMP280_TYPE_BME280) {
+        ESP_LOGD(TAG, "dig_H1=%u", bmp280_handle->dev_cal_factors->dig_H1);
+        ESP_LOGD(TAG, "dig_H2=%d", bmp280_handle->dev_cal_factors->dig_H2);
+        ESP_LOGD(TAG, "dig_H3=%u", bmp280_handle->dev_cal_factors->dig_H3);
+        ESP_LOGD(TAG, "dig_H4=%d", bmp280_handle->dev_cal_factors->dig_H4);
+        ESP_LOGD(TAG, "dig_H5=%d", bmp280_handle->dev_cal_factors->dig_H5);
+        ESP_LOGD(TAG, "dig_H6=%d", bmp280_handle->dev_cal_factors->dig_H6);
+    }
 
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_BMP280_CMD_DELAY_MS));
-    
     return ESP_OK;
 }
 
 /**
- * @brief reads fixed measurements (temperature and pressure) from the bmp280.  see datasheet for details.
+ * @brief reads raw adc data registers in one sequence, the pressure and temperature data registers 
+ * are followed by the bme280 humidity data registers when humidity is read.
  *
  * @param[in] bmp280_handle bmp280 device handle.
- * @param[out] temperature fixed temperature.
- * @param[out] pressure fixed temperature.
+ * @param[out] adc_temperature raw adc temperature.
+ * @param[out] adc_pressure raw adc pressure.
+ * @param[out] adc_humidity raw adc humidity, NULL to skip the humidity data registers.
  * @return esp_err_t ESP_OK on success.
  */
-static inline esp_err_t i2c_bmp280_get_fixed_measurements(i2c_bmp280_handle_t bmp280_handle, int32_t *const temperature, uint32_t *const pressure) {
+static inline esp_err_t i2c_bmp280_read_adc_data(i2c_bmp280_handle_t bmp280_handle, int32_t *const adc_temperature, int32_t *const adc_pressure, int32_t *const adc_humidity) {
+    i2c_uint64_t    data;
+
+    if(adc_humidity) {
+        /* attempt to burst read pressure, temperature and humidity data registers */
+        ESP_RETURN_ON_ERROR( i2c_master_bus_read_byte64(bmp280_handle->i2c_dev_handle, I2C_BMP280_REG_PRESSURE, &data), TAG, "read temperature, pressure and humidity data failed" );
+
+        *adc_humidity = data[6] << 8 | data[7];
+    } else {
+        /* attempt to burst read pressure and temperature data registers */
+        ESP_RETURN_ON_ERROR( i2c_master_bus_read_byte48(bmp280_handle->i2c_dev_handle, I2C_BMP280_REG_PRESSURE, (i2c_uint48_t*)data), TAG, "read temperature and pressure data failed" );
+    }
+
+    *adc_pressure    = data[0] << 12 | data[1] << 4 | data[2] >> 4;
+    *adc_temperature = data[3] << 12 | data[4] << 4 | data[5] >> 4;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief reads raw adc measurements (temperature, pressure and humidity) from the bmp280.  see datasheet for details.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[out] adc_temperature raw adc temperature.
+ * @param[out] adc_pressure raw adc pressure.
+ * @param[out] adc_humidity raw adc humidity, NULL to skip the bme280 humidity.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t i2c_bmp280_get_adc_measurements(i2c_bmp280_handle_t bmp280_handle, int32_t *const adc_temperature, int32_t *const adc_pressure, int32_t *const adc_humidity) {
     esp_err_t       ret             = ESP_OK;
     uint64_t        start_time      = 0;
     bool            data_is_ready   = false;
-    int32_t         adc_press;
-    int32_t         adc_temp;
-    int32_t         fine_temp;
-    i2c_uint48_t    data;
 
     /* validate arguments */
-    ESP_ARG_CHECK( bmp280_handle && temperature && pressure );
+    ESP_ARG_CHECK( bmp280_handle && adc_temperature && adc_pressure );
 
     /* set start time for timeout monitoring */
     start_time = esp_timer_get_time();
@@ -220,19 +622,10 @@ static inline esp_err_t i2c_bmp280_get_fixed_measurements(i2c_bmp280_handle_t bm
     } while (data_is_ready == false);
 
     // need to read in one sequence to ensure they match.
-    ESP_GOTO_ON_ERROR( i2c_master_bus_read_byte48(bmp280_handle->i2c_dev_handle, I2C_BMP280_REG_PRESSURE, &data), err, TAG, "read temperature and pressure data failed" );
-
-    adc_press = data[0] << 12 | data[1] << 4 | data[2] >> 4;
-    adc_temp  = data[3] << 12 | data[4] << 4 | data[5] >> 4;
+    ESP_GOTO_ON_ERROR( i2c_bmp280_read_adc_data(bmp280_handle, adc_temperature, adc_pressure, adc_humidity), err, TAG, "read adc data failed" );
 
-    ESP_LOGD(TAG, "ADC temperature: %" PRIi32, adc_temp);
-    ESP_LOGD(TAG, "ADC pressure: %" PRIi32, adc_press);
-
-    *temperature = i2c_bmp280_compensate_temperature(bmp280_handle, adc_temp, &fine_temp);
-    *pressure    = i2c_bmp280_compensate_pressure(bmp280_handle, adc_press, fine_temp);
-
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_BMP280_CMD_DELAY_MS));
+    ESP_LOGD(TAG, "ADC temperature: %" PRIi32, *adc_temperature);
+    ESP_LOGD(TAG, "ADC pressure: %" PRIi32, *adc_pressure);
 
     return ESP_OK;
 
@@ -241,22 +634,20 @@ static inline esp_err_t i2c_bmp280_get_fixed_measurements(i2c_bmp280_handle_t bm
 }
 
 /**
- * @brief reads fixed temperature measurement from the bmp280.  see datasheet for details.
+ * @brief reads raw adc temperature measurement from the bmp280.  see datasheet for details.
  *
  * @param[in] bmp280_handle bmp280 device handle.
- * @param[out] temperature fixed temperature.
+ * @param[out] adc_temperature raw adc temperature.
  * @return esp_err_t ESP_OK on success.
  */
-static inline esp_err_t i2c_bmp280_get_fixed_temperature(i2c_bmp280_handle_t bmp280_handle, int32_t *const temperature) {
+static inline esp_err_t i2c_bmp280_get_adc_temperature(i2c_bmp280_handle_t bmp280_handle, int32_t *const adc_temperature) {
     esp_err_t       ret             = ESP_OK;
     uint64_t        start_time      = 0;
     bool            data_is_ready   = false;
-    int32_t         adc_temp;
-    int32_t         fine_temp;
     i2c_uint24_t    data;
 
     /* validate arguments */
-    ESP_ARG_CHECK( bmp280_handle && temperature );
+    ESP_ARG_CHECK( bmp280_handle && adc_temperature );
 
     /* set start time for timeout monitoring */
     start_time = esp_timer_get_time();
@@ -277,14 +668,9 @@ static inline esp_err_t i2c_bmp280_get_fixed_temperature(i2c_bmp280_handle_t bmp
     // need to read in one sequence to ensure they match.
     ESP_GOTO_ON_ERROR( i2c_master_bus_read_byte24(bmp280_handle->i2c_dev_handle, I2C_BMP280_REG_TEMP, &data), err, TAG, "read temperature data failed" );
 
-    adc_temp  = data[0] << 12 | data[1] << 4 | data[2] >> 4;
+    *adc_temperature = data[0] << 12 | data[1] << 4 | data[2] >> 4;
 
-    ESP_LOGD(TAG, "ADC temperature: %" PRIi32, adc_temp);
-
-    *temperature = i2c_bmp280_compensate_temperature(bmp280_handle, adc_temp, &fine_temp);
-
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_BMP280_CMD_DELAY_MS));
+    ESP_LOGD(TAG, "ADC temperature: %" PRIi32, *adc_temperature);
 
     return ESP_OK;
 
@@ -305,11 +691,45 @@ static inline esp_err_t i2c_bmp280_get_registers(i2c_bmp280_handle_t bmp280_hand
     /* attempt to read calibration factors from device */
     ESP_RETURN_ON_ERROR( i2c_bmp280_get_cal_factors(bmp280_handle), TAG, "read calibration factors for get registers failed" );
 
-    /* attempt read control measurement register */
-    ESP_RETURN_ON_ERROR( i2c_bmp280_get_control_measurement_register(bmp280_handle), TAG, "read control measurement register for get registers failed" );
+    /* attempt to read configuration, control humidity, and control measurement registers into the register shadow */
+    ESP_RETURN_ON_ERROR( i2c_master_shadow_refresh(&bmp280_handle->regs_shadow), TAG, "read registers for get registers failed" );
 
-    /* attempt read configuration register */
-    ESP_RETURN_ON_ERROR( i2c_bmp280_get_configuration_register(bmp280_handle), TAG, "read configuration register for get registers failed" );
+    return ESP_OK;
+}
+
+/**
+ * @brief updates the configuration, control humidity, and control measurement register shadows and writes 
+ * the changed registers to bmp280, one write per changed register.
+ * 
+ * @param bmp280_handle bmp280 device handle.
+ * @param config_reg configuration register.
+ * @param ctrl_hum_reg control humidity register, ignored by the bmp280.
+ * @param ctrl_meas_reg control measurement register.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t i2c_bmp280_update_registers(i2c_bmp280_handle_t bmp280_handle, 
+                                                    const i2c_bmp280_configuration_register_t config_reg, 
+                                                    const i2c_bmp280_control_humidity_register_t ctrl_hum_reg, 
+                                                    const i2c_bmp280_control_measurement_register_t ctrl_meas_reg) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle );
+
+    /* attempt to update register shadows */
+    ESP_RETURN_ON_ERROR( i2c_master_shadow_update(&bmp280_handle->regs_shadow, I2C_BMP280_REG_CONFIG, I2C_BMP280_CONFIG_MASK, config_reg.reg), TAG, "update configuration register failed" );
+    if(bmp280_handle->dev_type == I2C_BMP280_TYPE_BME280) {
+        const uint8_t ctrl_hum = bmp280_handle->ctrl_hum_reg.reg;
+
+        ESP_RETURN_ON_ERROR( i2c_master_shadow_update(&bmp280_handle->regs_shadow, I2C_BMP280_REG_CTRL_HUM, I2C_BMP280_CTRL_HUM_MASK, ctrl_hum_reg.reg), TAG, "update control humidity register failed" );
+
+        /* control humidity register changes take effect after the control measurement register is written */
+        if(bmp280_handle->ctrl_hum_reg.reg != ctrl_hum) {
+            ESP_RETURN_ON_ERROR( i2c_master_shadow_mark_dirty(&bmp280_handle->regs_shadow, I2C_BMP280_REG_CTRL), TAG, "update control measurement register failed" );
+        }
+    }
+    ESP_RETURN_ON_ERROR( i2c_master_shadow_update(&bmp280_handle->regs_shadow, I2C_BMP280_REG_CTRL, I2C_BMP280_CTRL_MASK, ctrl_meas_reg.reg), TAG, "update control measurement register failed" );
+
+    /* attempt to write changed registers */
+    ESP_RETURN_ON_ERROR( i2c_master_shadow_flush(&bmp280_handle->regs_shadow), TAG, "write registers failed" );
 
     return ESP_OK;
 }
@@ -321,9 +741,6 @@ esp_err_t i2c_bmp280_get_chip_id_register(i2c_bmp280_handle_t bmp280_handle) {
     /* attempt i2c read transaction */
     ESP_RETURN_ON_ERROR( i2c_master_bus_read_uint8(bmp280_handle->i2c_dev_handle, I2C_BMP280_REG_ID, &bmp280_handle->dev_type), TAG, "read chip identifier register failed" );
 
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_BMP280_CMD_DELAY_MS));
-
     return ESP_OK;
 }
 
@@ -334,9 +751,6 @@ esp_err_t i2c_bmp280_get_status_register(i2c_bmp280_handle_t bmp280_handle) {
     /* attempt i2c read transaction */
     ESP_RETURN_ON_ERROR( i2c_master_bus_read_uint8(bmp280_handle->i2c_dev_handle, I2C_BMP280_REG_STATUS, &bmp280_handle->status_reg.reg), TAG, "read status register failed" );
 
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_BMP280_CMD_DELAY_MS));
-
     return ESP_OK;
 }
 
@@ -345,10 +759,7 @@ esp_err_t i2c_bmp280_get_control_measurement_register(i2c_bmp280_handle_t bmp280
     ESP_ARG_CHECK( bmp280_handle );
 
     /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_bus_read_uint8(bmp280_handle->i2c_dev_handle, I2C_BMP280_REG_CTRL, &bmp280_handle->ctrl_meas_reg.reg), TAG, "read control measurement register failed" );
-
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_BMP280_CMD_DELAY_MS));
+    ESP_RETURN_ON_ERROR( i2c_master_shadow_read(&bmp280_handle->regs_shadow, I2C_BMP280_REG_CTRL), TAG, "read control measurement register failed" );
 
     return ESP_OK;
 }
@@ -357,14 +768,39 @@ esp_err_t i2c_bmp280_set_control_measurement_register(i2c_bmp280_handle_t bmp280
     /* validate arguments */
     ESP_ARG_CHECK( bmp280_handle );
 
-    /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_bus_write_uint8(bmp280_handle->i2c_dev_handle, I2C_BMP280_REG_CTRL, ctrl_meas_reg.reg), TAG, "write control measurement register failed" );
+    /* attempt to write register through the register shadow */
+    ESP_RETURN_ON_ERROR( i2c_master_shadow_write(&bmp280_handle->regs_shadow, I2C_BMP280_REG_CTRL, ctrl_meas_reg.reg), TAG, "write control measurement register failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bmp280_get_control_humidity_register(i2c_bmp280_handle_t bmp280_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle );
+
+    /* validate device type */
+    if(bmp280_handle->dev_type != I2C_BMP280_TYPE_BME280) return ESP_ERR_NOT_SUPPORTED;
 
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_BMP280_CMD_DELAY_MS));
+    /* attempt i2c read transaction */
+    ESP_RETURN_ON_ERROR( i2c_master_shadow_read(&bmp280_handle->regs_shadow, I2C_BMP280_REG_CTRL_HUM), TAG, "read control humidity register failed" );
 
-    /* attempt to set device handle register */
-    ESP_RETURN_ON_ERROR( i2c_bmp280_get_control_measurement_register(bmp280_handle), TAG, "read control measurement register for set control measurement register failed" );
+    return ESP_OK;
+}
+
+esp_err_t i2c_bmp280_set_control_humidity_register(i2c_bmp280_handle_t bmp280_handle, const i2c_bmp280_control_humidity_register_t ctrl_hum_reg) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle );
+
+    /* validate device type */
+    if(bmp280_handle->dev_type != I2C_BMP280_TYPE_BME280) return ESP_ERR_NOT_SUPPORTED;
+
+    /* attempt to update register shadow, control humidity register changes take effect after the control measurement register is written */
+    ESP_RETURN_ON_ERROR( i2c_master_shadow_update(&bmp280_handle->regs_shadow, I2C_BMP280_REG_CTRL_HUM, I2C_BMP280_CTRL_HUM_MASK, ctrl_hum_reg.reg), TAG, "update control humidity register failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_shadow_mark_dirty(&bmp280_handle->regs_shadow, I2C_BMP280_REG_CTRL_HUM), TAG, "update control humidity register failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_shadow_mark_dirty(&bmp280_handle->regs_shadow, I2C_BMP280_REG_CTRL), TAG, "update control measurement register for set control humidity register failed" );
+
+    /* attempt to write registers */
+    ESP_RETURN_ON_ERROR( i2c_master_shadow_flush(&bmp280_handle->regs_shadow), TAG, "write control humidity register failed" );
 
     return ESP_OK;
 }
@@ -374,42 +810,68 @@ esp_err_t i2c_bmp280_get_configuration_register(i2c_bmp280_handle_t bmp280_handl
     ESP_ARG_CHECK( bmp280_handle );
 
     /* attempt i2c read transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_bus_read_uint8(bmp280_handle->i2c_dev_handle, I2C_BMP280_REG_CONFIG, &bmp280_handle->config_reg.reg), TAG, "read configuration register failed" );
-
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_BMP280_CMD_DELAY_MS));
+    ESP_RETURN_ON_ERROR( i2c_master_shadow_read(&bmp280_handle->regs_shadow, I2C_BMP280_REG_CONFIG), TAG, "read configuration register failed" );
 
     return ESP_OK;
 }
 
 esp_err_t i2c_bmp280_set_configuration_register(i2c_bmp280_handle_t bmp280_handle, const i2c_bmp280_configuration_register_t config_reg) {
-    i2c_bmp280_configuration_register_t config;
-
     /* validate arguments */
     ESP_ARG_CHECK( bmp280_handle );
 
-    /* copy register */
-    config.reg = config_reg.reg;
+    /* attempt to write register through the register shadow, reserved bits are written as 0 */
+    ESP_RETURN_ON_ERROR( i2c_master_shadow_write(&bmp280_handle->regs_shadow, I2C_BMP280_REG_CONFIG, config_reg.reg), TAG, "write configuration register failed" );
 
-    /* set reserved to 0 */
-    config.bits.reserved = 0;
+    return ESP_OK;
+}
+
+/**
+ * @brief writes configuration, control humidity, and control measurement registers of bmp280 from 
+ * configuration params, only changed registers are written.
+ * 
+ * @param bmp280_handle bmp280 device handle.
+ * @param bmp280_config configuration of the bmp280 device.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t i2c_bmp280_configure_registers(i2c_bmp280_handle_t bmp280_handle, const i2c_bmp280_config_t *bmp280_config) {
+    i2c_bmp280_configuration_register_t         config_reg;
+    i2c_bmp280_control_measurement_register_t   ctrl_meas_reg;
+    i2c_bmp280_control_humidity_register_t      ctrl_hum_reg;
 
-    /* attempt i2c write transaction */
-    ESP_RETURN_ON_ERROR( i2c_master_bus_write_uint8(bmp280_handle->i2c_dev_handle, I2C_BMP280_REG_CONFIG, config.reg), TAG, "write configuration register failed" );
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle && bmp280_config );
 
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_BMP280_CMD_DELAY_MS));
+    /* copy configuration, control measurement, and control humidity registers from register shadow */
+    config_reg.reg      = bmp280_handle->config_reg.reg;
+    ctrl_meas_reg.reg   = bmp280_handle->ctrl_meas_reg.reg;
+    ctrl_hum_reg.reg    = bmp280_handle->ctrl_hum_reg.reg;
 
-    /* attempt to set device handle register */
-    ESP_RETURN_ON_ERROR( i2c_bmp280_get_configuration_register(bmp280_handle), TAG, "read configuration register for set configuration register failed" );
+    /* initialize configuration register from configuration params */
+    config_reg.bits.standby_time = bmp280_config->standby_time;
+    config_reg.bits.iir_filter   = bmp280_config->iir_filter;
+
+    /* initialize control measurement register from configuration params */
+    if (bmp280_config->power_mode == I2C_BMP280_POWER_MODE_FORCED || bmp280_config->power_mode == I2C_BMP280_POWER_MODE_FORCED1) {
+        // initial mode for forced is sleep
+        ctrl_meas_reg.bits.power_mode               = I2C_BMP280_POWER_MODE_SLEEP;
+        ctrl_meas_reg.bits.temperature_oversampling = bmp280_config->temperature_oversampling;
+        ctrl_meas_reg.bits.pressure_oversampling    = bmp280_config->pressure_oversampling;
+    } else {
+        ctrl_meas_reg.bits.power_mode               = bmp280_config->power_mode;
+        ctrl_meas_reg.bits.temperature_oversampling = bmp280_config->temperature_oversampling;
+        ctrl_meas_reg.bits.pressure_oversampling    = bmp280_config->pressure_oversampling;
+    }
+    
+    /* initialize control humidity register from configuration params */
+    ctrl_hum_reg.bits.humidity_oversampling = bmp280_config->humidity_oversampling;
+
+    /* attempt to write changed registers */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_update_registers(bmp280_handle, config_reg, ctrl_hum_reg, ctrl_meas_reg), TAG, "write registers for configure registers failed" );
 
     return ESP_OK;
 }
 
 esp_err_t i2c_bmp280_init(i2c_master_bus_handle_t bus_handle, const i2c_bmp280_config_t *bmp280_config, i2c_bmp280_handle_t *bmp280_handle) {
-    i2c_bmp280_configuration_register_t         config_reg;
-    i2c_bmp280_control_measurement_register_t   ctrl_meas_reg;
-
     /* validate arguments */
     ESP_ARG_CHECK( bus_handle && bmp280_config );
 
@@ -440,43 +902,35 @@ esp_err_t i2c_bmp280_init(i2c_master_bus_handle_t bus_handle, const i2c_bmp280_c
         ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(bus_handle, &i2c_dev_conf, &out_handle->i2c_dev_handle), err_handle, TAG, "i2c0 new bus failed for init");
     }
 
-    /* delay before next i2c transaction */
-    vTaskDelay(pdMS_TO_TICKS(I2C_BMP280_CMD_DELAY_MS));
+    /* register device for i2c statistics */
+    ESP_GOTO_ON_ERROR(i2c_master_stats_register(out_handle->i2c_dev_handle, bmp280_config->dev_config.device_address), err_handle, TAG, "register i2c statistics for init failed");
+
+    /* set calibration factors cache and device address, the cache is keyed by chip identifier and address */
+    out_handle->cal_factors_cache = bmp280_config->cal_factors_cache;
+    out_handle->dev_address       = (uint8_t)bmp280_config->dev_config.device_address;
+
+    /* set compensation back-end */
+    out_handle->compensation      = bmp280_config->compensation;
 
     /* read and validate device type */
     ESP_GOTO_ON_ERROR(i2c_bmp280_get_chip_id_register(out_handle), err_handle, TAG, "read chip identifier for init failed");
-    if(out_handle->dev_type != I2C_BMP280_TYPE_BMP280) {
+    if(out_handle->dev_type != I2C_BMP280_TYPE_BMP280 && out_handle->dev_type != I2C_BMP280_TYPE_BME280) {
         ESP_GOTO_ON_FALSE(false, ESP_ERR_INVALID_VERSION, err_handle, TAG, "detected an invalid chip type for init, got: %02x", out_handle->dev_type);
     }
 
+    /* initialize register shadow, the control measurement register is last for control humidity register changes to take effect */
+    ESP_GOTO_ON_ERROR(i2c_master_shadow_init(&out_handle->regs_shadow, out_handle->i2c_dev_handle, bmp280_config->verify_registers), err_handle, TAG, "initialize register shadow for init failed");
+    ESP_GOTO_ON_ERROR(i2c_master_shadow_add(&out_handle->regs_shadow, I2C_BMP280_REG_CONFIG, &out_handle->config_reg.reg, I2C_BMP280_CONFIG_MASK), err_handle, TAG, "add configuration register to register shadow for init failed");
+    if(out_handle->dev_type == I2C_BMP280_TYPE_BME280) {
+        ESP_GOTO_ON_ERROR(i2c_master_shadow_add(&out_handle->regs_shadow, I2C_BMP280_REG_CTRL_HUM, &out_handle->ctrl_hum_reg.reg, I2C_BMP280_CTRL_HUM_MASK), err_handle, TAG, "add control humidity register to register shadow for init failed");
+    }
+    ESP_GOTO_ON_ERROR(i2c_master_shadow_add(&out_handle->regs_shadow, I2C_BMP280_REG_CTRL, &out_handle->ctrl_meas_reg.reg, I2C_BMP280_CTRL_MASK), err_handle, TAG, "add control measurement register to register shadow for init failed");
+
     /* attempt to reset the device and initialize registers */
     ESP_GOTO_ON_ERROR(i2c_bmp280_reset(out_handle), err_handle, TAG, "soft-reset and initialize registers for init failed");
 
-    /* copy configuration and control measurement registers from handle */
-    config_reg.reg      = out_handle->config_reg.reg;
-    ctrl_meas_reg.reg   = out_handle->ctrl_meas_reg.reg;
-
-    /* initialize configuration register from configuration params */
-    config_reg.bits.standby_time = bmp280_config->standby_time;
-    config_reg.bits.iir_filter   = bmp280_config->iir_filter;
-
-    /* initialize control measurement register from configuration params */
-    if (bmp280_config->power_mode == I2C_BMP280_POWER_MODE_FORCED || bmp280_config->power_mode == I2C_BMP280_POWER_MODE_FORCED1) {
-        // initial mode for forced is sleep
-        ctrl_meas_reg.bits.power_mode               = I2C_BMP280_POWER_MODE_SLEEP;
-        ctrl_meas_reg.bits.temperature_oversampling = bmp280_config->temperature_oversampling;
-        ctrl_meas_reg.bits.pressure_oversampling    = bmp280_config->pressure_oversampling;
-    } else {
-        ctrl_meas_reg.bits.power_mode               = bmp280_config->power_mode;
-        ctrl_meas_reg.bits.temperature_oversampling = bmp280_config->temperature_oversampling;
-        ctrl_meas_reg.bits.pressure_oversampling    = bmp280_config->pressure_oversampling;
-    }
-    
-    /* attempt to write configuration register */
-    ESP_GOTO_ON_ERROR(i2c_bmp280_set_configuration_register(out_handle, config_reg), err_handle, TAG, "write configuration register for init failed");
-
-    /* attempt to write control measurement register */
-    ESP_GOTO_ON_ERROR(i2c_bmp280_set_control_measurement_register(out_handle, ctrl_meas_reg), err_handle, TAG, "write control measurement register for init failed");
+    /* attempt to write registers from configuration params */
+    ESP_GOTO_ON_ERROR(i2c_bmp280_configure_registers(out_handle, bmp280_config), err_handle, TAG, "write registers for init failed");
 
     /* copy configuration */
     *bmp280_handle = out_handle;
@@ -488,57 +942,328 @@ esp_err_t i2c_bmp280_init(i2c_master_bus_handle_t bus_handle, const i2c_bmp280_c
 
     err_handle:
         if (out_handle && out_handle->i2c_dev_handle) {
+            i2c_master_stats_unregister(out_handle->i2c_dev_handle);
             i2c_master_bus_rm_device(out_handle->i2c_dev_handle);
         }
+        if (out_handle) free(out_handle->dev_cal_factors);
         free(out_handle);
     err:
         return ret;
 }
 
 esp_err_t i2c_bmp280_get_measurements(i2c_bmp280_handle_t bmp280_handle, float *const temperature, float *const pressure) {
-    int32_t  fixed_temperature;
-    uint32_t fixed_pressure;
+    int32_t adc_temperature;
+    int32_t adc_pressure;
 
     /* validate arguments */
     ESP_ARG_CHECK( bmp280_handle && temperature && pressure );
 
-    /* attempt to read fixed measurements (temperature & pressure) */
-    ESP_ERROR_CHECK( i2c_bmp280_get_fixed_measurements(bmp280_handle, &fixed_temperature, &fixed_pressure) );
+    /* attempt to read raw adc measurements (temperature & pressure) */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_get_adc_measurements(bmp280_handle, &adc_temperature, &adc_pressure, NULL), TAG, "read adc measurements for get measurements failed" );
 
     /* set output parameters */
-    *temperature = (float)fixed_temperature / 100;
-    *pressure    = (float)fixed_pressure / 256;
+    i2c_bmp280_compensate_measurements(bmp280_handle, adc_temperature, adc_pressure, 0, temperature, pressure, NULL);
 
     return ESP_OK;
 }
 
 esp_err_t i2c_bmp280_get_temperature(i2c_bmp280_handle_t bmp280_handle, float *const temperature) {
-    int32_t  fixed_temperature;
+    int32_t adc_temperature;
 
     /* validate arguments */
     ESP_ARG_CHECK( bmp280_handle && temperature );
 
-    /* attempt to read fixed temperature measurement */
-    ESP_ERROR_CHECK( i2c_bmp280_get_fixed_temperature(bmp280_handle, &fixed_temperature) );
+    /* attempt to read raw adc temperature measurement */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_get_adc_temperature(bmp280_handle, &adc_temperature), TAG, "read adc temperature for get temperature failed" );
 
     /* set output parameter */
-    *temperature = (float)fixed_temperature / 100;
+    i2c_bmp280_compensate_measurements(bmp280_handle, adc_temperature, 0, 0, temperature, NULL, NULL);
 
     return ESP_OK;
 }
 
 esp_err_t i2c_bmp280_get_pressure(i2c_bmp280_handle_t bmp280_handle, float *const pressure) {
-    int32_t  fixed_temperature;
-    uint32_t fixed_pressure;
+    float temperature;
 
     /* validate arguments */
     ESP_ARG_CHECK( bmp280_handle && pressure );
 
-    /* attempt to read fixed measurements (temperature & pressure) */
-    ESP_ERROR_CHECK( i2c_bmp280_get_fixed_measurements(bmp280_handle, &fixed_temperature, &fixed_pressure) );
+    /* attempt to read measurements (temperature & pressure), pressure compensation requires temperature */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_get_measurements(bmp280_handle, &temperature, pressure), TAG, "read measurements for get pressure failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bmp280_get_humidity_measurements(i2c_bmp280_handle_t bmp280_handle, float *const temperature, float *const pressure, float *const humidity) {
+    int32_t adc_temperature;
+    int32_t adc_pressure;
+    int32_t adc_humidity;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle && temperature && pressure && humidity );
+
+    /* validate device type */
+    if(bmp280_handle->dev_type != I2C_BMP280_TYPE_BME280) return ESP_ERR_NOT_SUPPORTED;
+
+    /* attempt to read raw adc measurements (temperature, pressure & humidity) */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_get_adc_measurements(bmp280_handle, &adc_temperature, &adc_pressure, &adc_humidity), TAG, "read adc measurements for get humidity measurements failed" );
+
+    /* set output parameters */
+    i2c_bmp280_compensate_measurements(bmp280_handle, adc_temperature, adc_pressure, adc_humidity, temperature, pressure, humidity);
+
+    return ESP_OK;
+}
+
+/**
+ * @brief triggers a forced mode measurement, the measurement is complete after the maximum 
+ * measurement time of the configured oversampling.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE while streaming.
+ */
+static inline esp_err_t i2c_bmp280_start_forced_adc_measurement(i2c_bmp280_handle_t bmp280_handle) {
+    i2c_bmp280_control_measurement_register_t   ctrl_meas_reg;
+
+    /* validate streaming state, a forced measurement would end normal mode */
+    if(bmp280_handle->streaming == true) return ESP_ERR_INVALID_STATE;
+
+    /* copy control measurement register from handle */
+    ctrl_meas_reg.reg = bmp280_handle->ctrl_meas_reg.reg;
+
+    /* initialize control measurement register */
+    ctrl_meas_reg.bits.power_mode = I2C_BMP280_POWER_MODE_FORCED;
+
+    /* attempt i2c write transaction, the measurement starts when the register is written */
+    ESP_RETURN_ON_ERROR( i2c_master_bus_write_uint8(bmp280_handle->i2c_dev_handle, I2C_BMP280_REG_CTRL, ctrl_meas_reg.reg), TAG, "write control measurement register for start forced measurement failed" );
+
+    /* the bmp280 returns to sleep mode once the measurement is complete */
+    ctrl_meas_reg.bits.power_mode    = I2C_BMP280_POWER_MODE_SLEEP;
+    bmp280_handle->ctrl_meas_reg.reg = ctrl_meas_reg.reg;
+
+    /* set completion time of the maximum measurement time of the configured oversampling */
+    bmp280_handle->forced_due_us  = esp_timer_get_time() + i2c_bmp280_get_measurement_time_us(bmp280_handle, true);
+    bmp280_handle->forced_pending = true;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief reads the raw adc data registers of a started forced mode measurement in one sequence 
+ * once the maximum measurement time has elapsed.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[out] adc_temperature raw adc temperature.
+ * @param[out] adc_pressure raw adc pressure.
+ * @param[out] adc_humidity raw adc humidity, NULL to skip the bme280 humidity.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when no measurement was started.
+ */
+static inline esp_err_t i2c_bmp280_wait_forced_adc_measurements(i2c_bmp280_handle_t bmp280_handle, int32_t *const adc_temperature, int32_t *const adc_pressure, int32_t *const adc_humidity) {
+    /* validate measurement state */
+    if(bmp280_handle->forced_pending == false) return ESP_ERR_INVALID_STATE;
+
+    /* delay task until the maximum measurement time has elapsed */
+    i2c_bmp280_delay_until(bmp280_handle->forced_due_us);
+
+    bmp280_handle->forced_pending = false;
+
+    /* attempt to read data registers in one sequence */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_read_adc_data(bmp280_handle, adc_temperature, adc_pressure, adc_humidity), TAG, "read adc data for wait forced measurements failed" );
+
+    return ESP_OK;
+}
+
+/**
+ * @brief triggers a forced mode measurement and reads the raw adc data registers in one sequence 
+ * once the maximum measurement time has elapsed.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[out] adc_temperature raw adc temperature.
+ * @param[out] adc_pressure raw adc pressure.
+ * @param[out] adc_humidity raw adc humidity, NULL to skip the bme280 humidity.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE while streaming.
+ */
+static inline esp_err_t i2c_bmp280_get_forced_adc_measurements(i2c_bmp280_handle_t bmp280_handle, int32_t *const adc_temperature, int32_t *const adc_pressure, int32_t *const adc_humidity) {
+    /* attempt to trigger forced measurement */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_start_forced_adc_measurement(bmp280_handle), TAG, "start forced measurement for get forced measurements failed" );
+
+    /* attempt to read forced measurement */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_wait_forced_adc_measurements(bmp280_handle, adc_temperature, adc_pressure, adc_humidity), TAG, "wait forced measurement for get forced measurements failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bmp280_get_forced_measurements(i2c_bmp280_handle_t bmp280_handle, float *const temperature, float *const pressure) {
+    int32_t adc_press;
+    int32_t adc_temp;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle && temperature && pressure );
+
+    /* attempt to trigger and read forced measurement */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_get_forced_adc_measurements(bmp280_handle, &adc_temp, &adc_press, NULL), TAG, "read forced adc measurements for get forced measurements failed" );
+
+    /* set output parameters */
+    i2c_bmp280_compensate_measurements(bmp280_handle, adc_temp, adc_press, 0, temperature, pressure, NULL);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bmp280_get_forced_humidity_measurements(i2c_bmp280_handle_t bmp280_handle, float *const temperature, float *const pressure, float *const humidity) {
+    int32_t adc_press;
+    int32_t adc_temp;
+    int32_t adc_hum;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle && temperature && pressure && humidity );
+
+    /* validate device type */
+    if(bmp280_handle->dev_type != I2C_BMP280_TYPE_BME280) return ESP_ERR_NOT_SUPPORTED;
+
+    /* attempt to trigger and read forced measurement */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_get_forced_adc_measurements(bmp280_handle, &adc_temp, &adc_press, &adc_hum), TAG, "read forced adc measurements for get forced humidity measurements failed" );
+
+    /* set output parameters */
+    i2c_bmp280_compensate_measurements(bmp280_handle, adc_temp, adc_press, adc_hum, temperature, pressure, humidity);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bmp280_start_forced_measurement(i2c_bmp280_handle_t bmp280_handle, uint32_t *const measurement_us) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle );
+
+    /* attempt to trigger forced measurement */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_start_forced_adc_measurement(bmp280_handle), TAG, "start forced adc measurement for start forced measurement failed" );
 
     /* set output parameter */
-    *pressure = (float)fixed_pressure / 256;
+    if(measurement_us) *measurement_us = i2c_bmp280_get_measurement_time_us(bmp280_handle, true);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bmp280_wait_forced_measurements(i2c_bmp280_handle_t bmp280_handle, float *const temperature, float *const pressure, float *const humidity) {
+    int32_t adc_press;
+    int32_t adc_temp;
+    int32_t adc_hum = 0;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle && temperature && pressure );
+
+    /* validate device type */
+    if(humidity && bmp280_handle->dev_type != I2C_BMP280_TYPE_BME280) return ESP_ERR_NOT_SUPPORTED;
+
+    /* attempt to read forced measurement */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_wait_forced_adc_measurements(bmp280_handle, &adc_temp, &adc_press, humidity ? &adc_hum : NULL), TAG, "wait forced adc measurements for wait forced measurements failed" );
+
+    /* set output parameters */
+    i2c_bmp280_compensate_measurements(bmp280_handle, adc_temp, adc_press, adc_hum, temperature, pressure, humidity);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bmp280_start_streaming(i2c_bmp280_handle_t bmp280_handle) {
+    i2c_bmp280_control_measurement_register_t   ctrl_meas_reg;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle );
+
+    /* copy control measurement register from handle */
+    ctrl_meas_reg.reg = bmp280_handle->ctrl_meas_reg.reg;
+
+    /* initialize control measurement register */
+    ctrl_meas_reg.bits.power_mode = I2C_BMP280_POWER_MODE_NORMAL;
+
+    /* attempt i2c write transaction, normal mode cycles start when the register is written */
+    ESP_RETURN_ON_ERROR( i2c_master_bus_write_uint8(bmp280_handle->i2c_dev_handle, I2C_BMP280_REG_CTRL, ctrl_meas_reg.reg), TAG, "write control measurement register for start streaming failed" );
+
+    /* set streaming schedule, the data registers are updated once per measurement and standby period */
+    bmp280_handle->stream_start_us       = esp_timer_get_time();
+    bmp280_handle->ctrl_meas_reg.reg     = ctrl_meas_reg.reg;
+    bmp280_handle->stream_period_us      = i2c_bmp280_get_measurement_time_us(bmp280_handle, false) + i2c_bmp280_get_standby_time_us(bmp280_handle);
+    bmp280_handle->stream_next_cycle     = 0;
+    bmp280_handle->streaming             = true;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bmp280_stop_streaming(i2c_bmp280_handle_t bmp280_handle) {
+    i2c_bmp280_control_measurement_register_t   ctrl_meas_reg;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle );
+
+    /* copy control measurement register from handle */
+    ctrl_meas_reg.reg = bmp280_handle->ctrl_meas_reg.reg;
+
+    /* initialize control measurement register */
+    ctrl_meas_reg.bits.power_mode = I2C_BMP280_POWER_MODE_SLEEP;
+
+    /* attempt to set sleep mode, the power mode setter is rejected while streaming */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_set_control_measurement_register(bmp280_handle, ctrl_meas_reg), TAG, "write power mode for stop streaming failed" );
+
+    bmp280_handle->streaming = false;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bmp280_get_latest_measurements(i2c_bmp280_handle_t bmp280_handle, float *const temperature, float *const pressure, float *const humidity, uint32_t *const age_us) {
+    int32_t         adc_press;
+    int32_t         adc_temp;
+    int32_t         adc_hum = 0;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle && temperature && pressure && age_us );
+
+    /* validate device type */
+    if(humidity && bmp280_handle->dev_type != I2C_BMP280_TYPE_BME280) return ESP_ERR_NOT_SUPPORTED;
+
+    /* validate streaming state */
+    if(bmp280_handle->streaming == false) return ESP_ERR_INVALID_STATE;
+
+    /* 
+        a measurement is complete by its maximum measurement time into each cycle, the
+        first measurement is awaited when none is complete yet 
+    */
+    const uint32_t measurement_max_us = i2c_bmp280_get_measurement_time_us(bmp280_handle, true);
+    int64_t        elapsed_us         = esp_timer_get_time() - bmp280_handle->stream_start_us;
+    if(elapsed_us < measurement_max_us) {
+        i2c_bmp280_delay_until(bmp280_handle->stream_start_us + measurement_max_us);
+    }
+
+    /* attempt to read data registers in one sequence, the registers are shadowed while read */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_read_adc_data(bmp280_handle, &adc_temp, &adc_press, humidity ? &adc_hum : NULL), TAG, "read adc data for get latest measurements failed" );
+
+    /* set measurement cycle and age, the age is estimated from the typical measurement time */
+    elapsed_us = esp_timer_get_time() - bmp280_handle->stream_start_us;
+    const uint32_t cycle = (uint32_t)((elapsed_us - measurement_max_us) / bmp280_handle->stream_period_us);
+    const int64_t  age   = elapsed_us - ((int64_t)cycle * bmp280_handle->stream_period_us + i2c_bmp280_get_measurement_time_us(bmp280_handle, false));
+    bmp280_handle->stream_next_cycle = cycle + 1;
+    *age_us = (uint32_t)age;
+
+    /* set output parameters */
+    i2c_bmp280_compensate_measurements(bmp280_handle, adc_temp, adc_press, adc_hum, temperature, pressure, humidity);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bmp280_get_next_measurements(i2c_bmp280_handle_t bmp280_handle, float *const temperature, float *const pressure, float *const humidity, uint32_t *const age_us) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle && temperature && pressure && age_us );
+
+    /* validate device type */
+    if(humidity && bmp280_handle->dev_type != I2C_BMP280_TYPE_BME280) return ESP_ERR_NOT_SUPPORTED;
+
+    /* validate streaming state */
+    if(bmp280_handle->streaming == false) return ESP_ERR_INVALID_STATE;
+
+    /* delay task until the measurement of the next cycle is complete */
+    const int64_t due_us = bmp280_handle->stream_start_us + 
+                            (int64_t)bmp280_handle->stream_next_cycle * bmp280_handle->stream_period_us + 
+                            i2c_bmp280_get_measurement_time_us(bmp280_handle, true);
+    i2c_bmp280_delay_until(due_us);
+
+    /* attempt to read the latest measurements */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_get_latest_measurements(bmp280_handle, temperature, pressure, humidity, age_us), TAG, "read latest measurements for get next measurements failed" );
 
     return ESP_OK;
 }
@@ -562,9 +1287,9 @@ esp_err_t i2c_bmp280_get_data_status(i2c_bmp280_handle_t bmp280_handle, bool *co
 
 esp_err_t i2c_bmp280_get_power_mode(i2c_bmp280_handle_t bmp280_handle, i2c_bmp280_power_modes_t *const power_mode) {
     /* validate arguments */
-    ESP_ARG_CHECK( bmp280_handle );
+    ESP_ARG_CHECK( bmp280_handle && power_mode );
 
-    /* attempt to read control measurement register */
+    /* attempt to read control measurement register, the device returns from forced to sleep mode by itself */
     ESP_RETURN_ON_ERROR( i2c_bmp280_get_control_measurement_register(bmp280_handle), TAG, "read control measurement register for get power mode failed" );
 
     /* set power mode */
@@ -579,6 +1304,9 @@ esp_err_t i2c_bmp280_set_power_mode(i2c_bmp280_handle_t bmp280_handle, const i2c
     /* validate arguments */
     ESP_ARG_CHECK( bmp280_handle );
 
+    /* validate streaming state, streaming is ended with stop streaming */
+    if(bmp280_handle->streaming == true) return ESP_ERR_INVALID_STATE;
+
     /* copy control measurement register from handle */
     ctrl_meas_reg.reg = bmp280_handle->ctrl_meas_reg.reg;
 
@@ -593,10 +1321,9 @@ esp_err_t i2c_bmp280_set_power_mode(i2c_bmp280_handle_t bmp280_handle, const i2c
 
 esp_err_t i2c_bmp280_get_pressure_oversampling(i2c_bmp280_handle_t bmp280_handle, i2c_bmp280_pressure_oversampling_t *const oversampling) {
     /* validate arguments */
-    ESP_ARG_CHECK( bmp280_handle );
+    ESP_ARG_CHECK( bmp280_handle && oversampling );
 
-    /* attempt to read control measurement register */
-    ESP_RETURN_ON_ERROR( i2c_bmp280_get_control_measurement_register(bmp280_handle), TAG, "read control measurement register for get pressure oversampling failed" );
+    /* control measurement register is served from the register shadow, the device doesn't change it */
 
     /* set oversampling */
     *oversampling = bmp280_handle->ctrl_meas_reg.bits.pressure_oversampling;
@@ -610,24 +1337,26 @@ esp_err_t i2c_bmp280_set_pressure_oversampling(i2c_bmp280_handle_t bmp280_handle
     /* validate arguments */
     ESP_ARG_CHECK( bmp280_handle );
 
+    /* validate streaming state, the streaming schedule follows the configuration */
+    if(bmp280_handle->streaming == true) return ESP_ERR_INVALID_STATE;
+
     /* copy control measurement register from handle */
     ctrl_meas_reg.reg = bmp280_handle->ctrl_meas_reg.reg;
 
     /* initialize control measurement register */
     ctrl_meas_reg.bits.pressure_oversampling = oversampling;
 
-    /* attempt to write control measurement register */
-    ESP_RETURN_ON_ERROR( i2c_bmp280_set_control_measurement_register(bmp280_handle, ctrl_meas_reg), TAG, "write control measurement register for set pressure oversampling failed" );
+    /* attempt to write control measurement register when changed */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_update_registers(bmp280_handle, bmp280_handle->config_reg, bmp280_handle->ctrl_hum_reg, ctrl_meas_reg), TAG, "write control measurement register for set pressure oversampling failed" );
 
     return ESP_OK;
 }
 
 esp_err_t i2c_bmp280_get_temperature_oversampling(i2c_bmp280_handle_t bmp280_handle, i2c_bmp280_temperature_oversampling_t *const oversampling) {
     /* validate arguments */
-    ESP_ARG_CHECK( bmp280_handle );
+    ESP_ARG_CHECK( bmp280_handle && oversampling );
 
-    /* attempt to read control measurement register */
-    ESP_RETURN_ON_ERROR( i2c_bmp280_get_control_measurement_register(bmp280_handle), TAG, "read control measurement register for get temperature oversampling failed" );
+    /* control measurement register is served from the register shadow, the device doesn't change it */
 
     /* set oversampling */
     *oversampling = bmp280_handle->ctrl_meas_reg.bits.temperature_oversampling;
@@ -641,25 +1370,66 @@ esp_err_t i2c_bmp280_set_temperature_oversampling(i2c_bmp280_handle_t bmp280_han
     /* validate arguments */
     ESP_ARG_CHECK( bmp280_handle );
 
+    /* validate streaming state, the streaming schedule follows the configuration */
+    if(bmp280_handle->streaming == true) return ESP_ERR_INVALID_STATE;
+
     /* copy control measurement register from handle */
     ctrl_meas_reg.reg = bmp280_handle->ctrl_meas_reg.reg;
 
     /* initialize control measurement register */
     ctrl_meas_reg.bits.temperature_oversampling = oversampling;
 
-    /* attempt to write control measurement register */
-    ESP_RETURN_ON_ERROR( i2c_bmp280_set_control_measurement_register(bmp280_handle, ctrl_meas_reg), TAG, "write control measurement register for set temperature oversampling failed" );
+    /* attempt to write control measurement register when changed */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_update_registers(bmp280_handle, bmp280_handle->config_reg, bmp280_handle->ctrl_hum_reg, ctrl_meas_reg), TAG, "write control measurement register for set temperature oversampling failed" );
 
     return ESP_OK;
 }
 
 
-esp_err_t i2c_bmp280_get_standby_time(i2c_bmp280_handle_t bmp280_handle, i2c_bmp280_standby_times_t *const standby_time) {
+esp_err_t i2c_bmp280_get_humidity_oversampling(i2c_bmp280_handle_t bmp280_handle, i2c_bmp280_humidity_oversampling_t *const oversampling) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle && oversampling );
+
+    /* validate device type */
+    if(bmp280_handle->dev_type != I2C_BMP280_TYPE_BME280) return ESP_ERR_NOT_SUPPORTED;
+
+    /* control humidity register is served from the register shadow, the device doesn't change it */
+
+    /* set oversampling */
+    *oversampling = bmp280_handle->ctrl_hum_reg.bits.humidity_oversampling;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bmp280_set_humidity_oversampling(i2c_bmp280_handle_t bmp280_handle, const i2c_bmp280_humidity_oversampling_t oversampling) {
+    i2c_bmp280_control_humidity_register_t  ctrl_hum_reg;
+
     /* validate arguments */
     ESP_ARG_CHECK( bmp280_handle );
 
-    /* attempt to read configuration register */
-    ESP_RETURN_ON_ERROR( i2c_bmp280_get_configuration_register(bmp280_handle), TAG, "read configuration register for get standby time failed" );
+    /* validate streaming state, the streaming schedule follows the configuration */
+    if(bmp280_handle->streaming == true) return ESP_ERR_INVALID_STATE;
+
+    /* validate device type */
+    if(bmp280_handle->dev_type != I2C_BMP280_TYPE_BME280) return ESP_ERR_NOT_SUPPORTED;
+
+    /* copy control humidity register from handle */
+    ctrl_hum_reg.reg = bmp280_handle->ctrl_hum_reg.reg;
+
+    /* initialize control humidity register */
+    ctrl_hum_reg.bits.humidity_oversampling = oversampling;
+
+    /* attempt to write control humidity and control measurement registers when changed */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_update_registers(bmp280_handle, bmp280_handle->config_reg, ctrl_hum_reg, bmp280_handle->ctrl_meas_reg), TAG, "write control humidity register for set humidity oversampling failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bmp280_get_standby_time(i2c_bmp280_handle_t bmp280_handle, i2c_bmp280_standby_times_t *const standby_time) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle && standby_time );
+
+    /* configuration register is served from the register shadow, the device doesn't change it */
 
     /* set standby time */
     *standby_time = bmp280_handle->config_reg.bits.standby_time;
@@ -673,24 +1443,26 @@ esp_err_t i2c_bmp280_set_standby_time(i2c_bmp280_handle_t bmp280_handle, const i
     /* validate arguments */
     ESP_ARG_CHECK( bmp280_handle );
 
+    /* validate streaming state, the streaming schedule follows the configuration */
+    if(bmp280_handle->streaming == true) return ESP_ERR_INVALID_STATE;
+
     /* copy configuration register from handle */
     config_reg.reg = bmp280_handle->config_reg.reg;
 
     /* initialize configuration register */
     config_reg.bits.standby_time = standby_time;
 
-    /* attempt to write configuration register */
-    ESP_RETURN_ON_ERROR( i2c_bmp280_set_configuration_register(bmp280_handle, config_reg), TAG, "write configuration register for set stanby time failed" );
+    /* attempt to write configuration register when changed */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_update_registers(bmp280_handle, config_reg, bmp280_handle->ctrl_hum_reg, bmp280_handle->ctrl_meas_reg), TAG, "write configuration register for set stanby time failed" );
 
     return ESP_OK;
 }
 
 esp_err_t i2c_bmp280_get_iir_filter(i2c_bmp280_handle_t bmp280_handle, i2c_bmp280_iir_filters_t *const iir_filter) {
     /* validate arguments */
-    ESP_ARG_CHECK( bmp280_handle );
+    ESP_ARG_CHECK( bmp280_handle && iir_filter );
 
-    /* attempt to read configuration register */
-    ESP_RETURN_ON_ERROR( i2c_bmp280_get_configuration_register(bmp280_handle), TAG, "read configuration register for get IIR filter failed" );
+    /* configuration register is served from the register shadow, the device doesn't change it */
 
     /* set standby time */
     *iir_filter = bmp280_handle->config_reg.bits.iir_filter;
@@ -704,14 +1476,33 @@ esp_err_t i2c_bmp280_set_iir_filter(i2c_bmp280_handle_t bmp280_handle, const i2c
     /* validate arguments */
     ESP_ARG_CHECK( bmp280_handle );
 
+    /* validate streaming state, configuration register writes in normal mode may be ignored */
+    if(bmp280_handle->streaming == true) return ESP_ERR_INVALID_STATE;
+
     /* copy configuration register from handle */
     config_reg.reg = bmp280_handle->config_reg.reg;
 
     /* initialize configuration register */
     config_reg.bits.iir_filter = iir_filter;
 
-    /* attempt to write configuration register */
-    ESP_RETURN_ON_ERROR( i2c_bmp280_set_configuration_register(bmp280_handle, config_reg), TAG, "write configuration register for set IIR filter failed" );
+    /* attempt to write configuration register when changed */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_update_registers(bmp280_handle, config_reg, bmp280_handle->ctrl_hum_reg, bmp280_handle->ctrl_meas_reg), TAG, "write configuration register for set IIR filter failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bmp280_reconfigure(i2c_bmp280_handle_t bmp280_handle, const i2c_bmp280_config_t *bmp280_config) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle && bmp280_config );
+
+    /* validate streaming state, the streaming schedule follows the configuration */
+    if(bmp280_handle->streaming == true) return ESP_ERR_INVALID_STATE;
+
+    /* set compensation back-end */
+    bmp280_handle->compensation = bmp280_config->compensation;
+
+    /* attempt to write changed registers from configuration params */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_configure_registers(bmp280_handle, bmp280_config), TAG, "write registers for reconfigure failed" );
 
     return ESP_OK;
 }
@@ -732,9 +1523,39 @@ esp_err_t i2c_bmp280_reset(i2c_bmp280_handle_t bmp280_handle) {
     return ESP_OK;
 }
 
+esp_err_t i2c_bmp280_reinit(i2c_bmp280_handle_t bmp280_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( bmp280_handle );
+
+    /* copy configured registers, the soft-reset refreshes the register shadow with the reset values */
+    const i2c_bmp280_configuration_register_t       config_reg    = bmp280_handle->config_reg;
+    const i2c_bmp280_control_humidity_register_t    ctrl_hum_reg  = bmp280_handle->ctrl_hum_reg;
+    const i2c_bmp280_control_measurement_register_t ctrl_meas_reg = bmp280_handle->ctrl_meas_reg;
+
+    /* a started forced measurement is lost with the soft-reset */
+    bmp280_handle->forced_pending = false;
+
+    /* attempt to soft-reset the device */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_reset(bmp280_handle), TAG, "soft-reset for reinit failed" );
+
+    /* attempt to write configured registers that differ from the reset values */
+    ESP_RETURN_ON_ERROR( i2c_bmp280_update_registers(bmp280_handle, config_reg, ctrl_hum_reg, ctrl_meas_reg), TAG, "write registers for reinit failed" );
+
+    /* normal mode cycles restart when the control measurement register is written */
+    if(bmp280_handle->streaming == true) {
+        bmp280_handle->stream_start_us   = esp_timer_get_time();
+        bmp280_handle->stream_next_cycle = 0;
+    }
+
+    return ESP_OK;
+}
+
 esp_err_t i2c_bmp280_rm(i2c_bmp280_handle_t bmp280_handle) {
     /* validate arguments */
     ESP_ARG_CHECK( bmp280_handle );
 
+    /* unregister device from i2c statistics, statistics of the device address are kept */
+    i2c_master_stats_unregister(bmp280_handle->i2c_dev_handle);
+
     return i2c_master_bus_rm_device(bmp280_handle->i2c_dev_handle);
 }
@@ -48,6 +48,7 @@ extern "C" {
  * BMP280 definitions
 */
 #define I2C_BMP280_SCL_SPEED_HZ     UINT32_C(100000)          //!< bmp280 I2C default clock frequency (100KHz)
+#define I2C_BMP280_TURNAROUND_US    UINT32_C(5)               //!< bmp280 minimum time between I2C transactions, the standard mode bus free time (4.7-us) rounded up
 
 /*
  * supported device addresses
@@ -55,6 +56,12 @@ extern "C" {
 #define I2C_BMP280_DEV_ADDR_LO      0x76 //!< bmp280 I2C address when ADDR pin floating/low
 #define I2C_BMP280_DEV_ADDR_HI      0x77 //!< bmp280 I2C address when ADDR pin high
 
+/*
+ * supported device types, chip identifier register
+*/
+#define I2C_BMP280_TYPE_BMP280      0x58  //!< BMP280, temperature and pressure
+#define I2C_BMP280_TYPE_BME280      0x60  //!< BME280, temperature, pressure and humidity
+
 /*
  * BMP280 macros
 */
@@ -65,7 +72,11 @@ extern "C" {
         .iir_filter                 = I2C_BMP280_IIR_FILTER_OFF,                 \
         .pressure_oversampling      = I2C_BMP280_PRESSURE_OVERSAMPLING_4X,       \
         .temperature_oversampling   = I2C_BMP280_TEMPERATURE_OVERSAMPLING_1X,    \
-        .standby_time               = I2C_BMP280_STANDBY_TIME_250MS }
+        .humidity_oversampling      = I2C_BMP280_HUMIDITY_OVERSAMPLING_1X,       \
+        .standby_time               = I2C_BMP280_STANDBY_TIME_250MS,             \
+        .cal_factors_cache          = true,                                     \
+        .compensation               = I2C_BMP280_COMPENSATION_INT64,             \
+        .verify_registers           = false }
 
 /*
  * BMP280 enumerator and sructure declerations
@@ -137,6 +148,42 @@ typedef enum {
     I2C_BMP280_TEMPERATURE_OVERSAMPLING_16X2       = (0b111)   //!< ultra high resolution
 } i2c_bmp280_temperature_oversampling_t;
 
+/**
+ * @brief BME280 I2C humidity oversampling enumerator.  See BME280 datasheet, section 5.4.3.
+ * 
+ */
+typedef enum {
+    I2C_BMP280_HUMIDITY_OVERSAMPLING_SKIPPED    = (0b000),  //!< skipped, no measurement, output set to 0x8000
+    I2C_BMP280_HUMIDITY_OVERSAMPLING_1X         = (0b001),
+    I2C_BMP280_HUMIDITY_OVERSAMPLING_2X         = (0b010),
+    I2C_BMP280_HUMIDITY_OVERSAMPLING_4X         = (0b011),
+    I2C_BMP280_HUMIDITY_OVERSAMPLING_8X         = (0b100),
+    I2C_BMP280_HUMIDITY_OVERSAMPLING_16X        = (0b101)
+} i2c_bmp280_humidity_oversampling_t;
+
+/**
+ * @brief BMP280 I2C compensation back-ends enumerator.  See datasheet sections 3.11.3 and 8 for details.
+ * 
+ */
+typedef enum {
+    I2C_BMP280_COMPENSATION_INT64 = 0,  //!< 32-bit temperature and 64-bit pressure integer compensation, 1/256 Pa resolution
+    I2C_BMP280_COMPENSATION_INT32,      //!< 32-bit temperature and pressure integer compensation, 1 Pa resolution
+    I2C_BMP280_COMPENSATION_FLOAT       //!< single-precision floating-point compensation, uses the fpu when available
+} i2c_bmp280_compensations_t;
+
+/**
+ * @brief BME280 I2C control humidity register (0xf2) structure.  The reset state is 0x00 for this register, 
+ * changes take effect after the control measurement register is written.
+ * 
+ */
+typedef union __attribute__((packed)) {
+    struct {
+        i2c_bmp280_humidity_oversampling_t      humidity_oversampling:3;    /*!< bme280 oversampling of humidity data       (bit:0-2) */
+        uint8_t                                 reserved:5;                 /*!< reserved                                   (bit:3-7) */
+    } bits;
+    uint8_t reg;
+} i2c_bmp280_control_humidity_register_t;
+
 /**
  * @brief BMP280 I2C status register (0xf3) structure.  The reset state is 0x00 for this register.
  * 
@@ -197,6 +244,13 @@ typedef struct {
     int16_t                 dig_P7;
     int16_t                 dig_P8;
     int16_t                 dig_P9;
+    /* humidity compensation, bme280 only */
+    uint8_t                 dig_H1;
+    int16_t                 dig_H2;
+    uint8_t                 dig_H3;
+    int16_t                 dig_H4;
+    int16_t                 dig_H5;
+    int8_t                  dig_H6;
 } i2c_bmp280_cal_factors_t;
 
 typedef struct {
@@ -205,16 +259,31 @@ typedef struct {
     i2c_bmp280_iir_filters_t                    iir_filter;
     i2c_bmp280_pressure_oversampling_t          pressure_oversampling;
     i2c_bmp280_temperature_oversampling_t       temperature_oversampling;
+    i2c_bmp280_humidity_oversampling_t          humidity_oversampling;  /*!< humidity oversampling, ignored by the bmp280 */
     i2c_bmp280_standby_times_t                  standby_time;
+    bool                                        cal_factors_cache;  /*!< calibration factors are cached in nvs by chip identifier and address when true, erase nvs when the device is replaced */
+    i2c_bmp280_compensations_t                  compensation;       /*!< temperature and pressure compensation back-end */
+    bool                                        verify_registers;   /*!< written registers are read back and compared when true */
 } i2c_bmp280_config_t;
 
 struct i2c_bmp280_t {
     i2c_master_dev_handle_t                     i2c_dev_handle;    /*!< I2C device handle */
     i2c_bmp280_cal_factors_t                   *dev_cal_factors;  /*!< bmp280 device calibration factors */
-    uint8_t                                     dev_type;           /*!< device type, should be bmp280 */
+    uint8_t                                     dev_type;           /*!< device type, bmp280 or bme280 */
+    uint8_t                                     dev_address;        /*!< device address */
+    bool                                        cal_factors_cache;  /*!< calibration factors are cached in nvs when true */
+    i2c_bmp280_compensations_t                  compensation;       /*!< temperature and pressure compensation back-end */
     i2c_bmp280_status_register_t                status_reg;         /*!< bmp280 status register */
     i2c_bmp280_control_measurement_register_t   ctrl_meas_reg;      /*!< bmp280 control measurement register */
+    i2c_bmp280_control_humidity_register_t      ctrl_hum_reg;       /*!< bme280 control humidity register */
     i2c_bmp280_configuration_register_t         config_reg;         /*!< bmp280 configuration register */
+    i2c_shadow_t                                regs_shadow;        /*!< register shadow of the configuration, control humidity, and control measurement registers */
+    bool                                        streaming;          /*!< bmp280 normal mode streaming is started when true */
+    int64_t                                     stream_start_us;    /*!< bmp280 normal mode start time in micro-seconds */
+    uint32_t                                    stream_period_us;   /*!< bmp280 normal mode measurement and standby period in micro-seconds */
+    uint32_t                                    stream_next_cycle;  /*!< bmp280 normal mode cycle following the last read measurement */
+    bool                                        forced_pending;     /*!< bmp280 forced mode measurement was started and is not read yet */
+    int64_t                                     forced_due_us;      /*!< bmp280 forced mode measurement completion time in micro-seconds */
 };
 
 typedef struct i2c_bmp280_t i2c_bmp280_t;
@@ -239,7 +308,7 @@ esp_err_t i2c_bmp280_get_chip_id_register(i2c_bmp280_handle_t bmp280_handle);
 esp_err_t i2c_bmp280_get_status_register(i2c_bmp280_handle_t bmp280_handle);
 
 /**
- * @brief reads control measurement register from bmp280.
+ * @brief reads control measurement register from bmp280 into the register shadow.
  * 
  * @param bmp280_handle[in] bmp280 device handle.
  * @return esp_err_t ESP_OK on success.
@@ -247,7 +316,7 @@ esp_err_t i2c_bmp280_get_status_register(i2c_bmp280_handle_t bmp280_handle);
 esp_err_t i2c_bmp280_get_control_measurement_register(i2c_bmp280_handle_t bmp280_handle);
 
 /**
- * @brief writes control measurement register to bmp280. 
+ * @brief writes control measurement register to bmp280 through the register shadow, unconditionally. 
  * 
  * @param[in] bmp280_handle bmp280 device handle.
  * @param[in] ctrl_meas_reg control measurement register.
@@ -256,7 +325,25 @@ esp_err_t i2c_bmp280_get_control_measurement_register(i2c_bmp280_handle_t bmp280
 esp_err_t i2c_bmp280_set_control_measurement_register(i2c_bmp280_handle_t bmp280_handle, const i2c_bmp280_control_measurement_register_t ctrl_meas_reg);
 
 /**
- * @brief reads configuration register from bmp280.
+ * @brief reads control humidity register from bme280 into the register shadow.
+ * 
+ * @param bmp280_handle[in] bmp280 device handle.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED when the device is not a bme280.
+ */
+esp_err_t i2c_bmp280_get_control_humidity_register(i2c_bmp280_handle_t bmp280_handle);
+
+/**
+ * @brief writes control humidity register to bme280, the control measurement register is 
+ * re-written for the change to take effect. 
+ * 
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[in] ctrl_hum_reg control humidity register.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED when the device is not a bme280.
+ */
+esp_err_t i2c_bmp280_set_control_humidity_register(i2c_bmp280_handle_t bmp280_handle, const i2c_bmp280_control_humidity_register_t ctrl_hum_reg);
+
+/**
+ * @brief reads configuration register from bmp280 into the register shadow.
  * 
  * @param bmp280_handle[in] bmp280 device handle
  * @return esp_err_t ESP_OK on success.
@@ -264,7 +351,7 @@ esp_err_t i2c_bmp280_set_control_measurement_register(i2c_bmp280_handle_t bmp280
 esp_err_t i2c_bmp280_get_configuration_register(i2c_bmp280_handle_t bmp280_handle);
 
 /**
- * @brief writes configuration register to bmp280. 
+ * @brief writes configuration register to bmp280 through the register shadow, unconditionally. 
  * 
  * @param[in] bmp280_handle bmp280 device handle.
  * @param[in] config_reg configuration register.
@@ -310,6 +397,116 @@ esp_err_t i2c_bmp280_get_temperature(i2c_bmp280_handle_t bmp280_handle, float *c
  */
 esp_err_t i2c_bmp280_get_pressure(i2c_bmp280_handle_t bmp280_handle, float *const pressure);
 
+/**
+ * @brief triggers a forced mode measurement on the bmp280 and reads it.  The task is delayed 
+ * for the datasheet maximum measurement time of the configured oversampling, the measurement 
+ * is read with one burst read without status polling.  The bmp280 returns to sleep mode 
+ * between measurements, configure `I2C_BMP280_POWER_MODE_FORCED` to start in sleep mode.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[out] temperature temperature in degree Celsius
+ * @param[out] pressure pressure in pascal
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE while streaming.
+ */
+esp_err_t i2c_bmp280_get_forced_measurements(i2c_bmp280_handle_t bmp280_handle, float *const temperature, float *const pressure);
+
+/**
+ * @brief high-level measurement (temperature, pressure & humidity) function for bme280.  The 
+ * measurement is read with one burst read of the pressure, temperature and humidity data registers.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[out] temperature temperature in degree Celsius
+ * @param[out] pressure pressure in pascal
+ * @param[out] humidity relative humidity in percent
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED when the device is not a bme280.
+ */
+esp_err_t i2c_bmp280_get_humidity_measurements(i2c_bmp280_handle_t bmp280_handle, float *const temperature, float *const pressure, float *const humidity);
+
+/**
+ * @brief triggers a forced mode measurement on the bme280 and reads it with humidity.  See 
+ * `i2c_bmp280_get_forced_measurements` for details, the measurement is read with one burst read 
+ * of the pressure, temperature and humidity data registers.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[out] temperature temperature in degree Celsius
+ * @param[out] pressure pressure in pascal
+ * @param[out] humidity relative humidity in percent
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE while streaming, ESP_ERR_NOT_SUPPORTED when the device is not a bme280.
+ */
+esp_err_t i2c_bmp280_get_forced_humidity_measurements(i2c_bmp280_handle_t bmp280_handle, float *const temperature, float *const pressure, float *const humidity);
+
+/**
+ * @brief starts a forced mode measurement on the bmp280 without waiting for it, the split form of 
+ * `i2c_bmp280_get_forced_measurements` to interleave other devices on the bus during the conversion.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[out] measurement_us datasheet maximum measurement time of the configured oversampling in micro-seconds, NULL when not required.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE while streaming.
+ */
+esp_err_t i2c_bmp280_start_forced_measurement(i2c_bmp280_handle_t bmp280_handle, uint32_t *const measurement_us);
+
+/**
+ * @brief reads the forced mode measurement started by `i2c_bmp280_start_forced_measurement`.  The task 
+ * is delayed for the remainder of the maximum measurement time, if any, and the measurement is read 
+ * with one burst read without status polling.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[out] temperature temperature in degree Celsius
+ * @param[out] pressure pressure in pascal
+ * @param[out] humidity relative humidity in percent, NULL to skip the bme280 humidity.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when no measurement was started, ESP_ERR_NOT_SUPPORTED 
+ * when humidity is requested and the device is not a bme280.
+ */
+esp_err_t i2c_bmp280_wait_forced_measurements(i2c_bmp280_handle_t bmp280_handle, float *const temperature, float *const pressure, float *const humidity);
+
+/**
+ * @brief starts normal mode streaming on the bmp280.  The bmp280 cycles between measurement and 
+ * standby, the data registers are read without status polling on a schedule derived from the 
+ * configured oversampling and standby time.  Set the standby time and oversampling beforehand.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_bmp280_start_streaming(i2c_bmp280_handle_t bmp280_handle);
+
+/**
+ * @brief stops normal mode streaming, the bmp280 is set to sleep mode.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_bmp280_stop_streaming(i2c_bmp280_handle_t bmp280_handle);
+
+/**
+ * @brief reads the latest completed measurement while streaming, without waiting for a new one.  
+ * The data registers, humidity included when requested, are read with one burst read.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[out] temperature temperature in degree Celsius
+ * @param[out] pressure pressure in pascal
+ * @param[out] humidity relative humidity in percent, NULL to skip the bme280 humidity.
+ * @param[out] age_us estimated time since the measurement completed in micro-seconds.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when not streaming, ESP_ERR_NOT_SUPPORTED 
+ * when humidity is requested and the device is not a bme280.
+ */
+esp_err_t i2c_bmp280_get_latest_measurements(i2c_bmp280_handle_t bmp280_handle, float *const temperature, float *const pressure, float *const humidity, uint32_t *const age_us);
+
+/**
+ * @brief waits for the measurement following the last read measurement while streaming and 
+ * reads it, reads are aligned to the measurement and standby period.  The schedule is kept 
+ * from the start of streaming, restart streaming periodically to re-align with the bmp280 
+ * oscillator over long runs.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[out] temperature temperature in degree Celsius
+ * @param[out] pressure pressure in pascal
+ * @param[out] humidity relative humidity in percent, NULL to skip the bme280 humidity.
+ * @param[out] age_us estimated time since the measurement completed in micro-seconds.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when not streaming, ESP_ERR_NOT_SUPPORTED 
+ * when humidity is requested and the device is not a bme280.
+ */
+esp_err_t i2c_bmp280_get_next_measurements(i2c_bmp280_handle_t bmp280_handle, float *const temperature, float *const pressure, float *const humidity, uint32_t *const age_us);
+
 /**
  * @brief reads data status of the bmp280.
  * 
@@ -333,12 +530,12 @@ esp_err_t i2c_bmp280_get_power_mode(i2c_bmp280_handle_t bmp280_handle, i2c_bmp28
  * 
  * @param[in] bmp280_handle bmp280 device handle.
  * @param[in] power_mode power mode setting.
- * @return esp_err_t ESP_OK on success.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE while streaming.
  */
 esp_err_t i2c_bmp280_set_power_mode(i2c_bmp280_handle_t bmp280_handle, const i2c_bmp280_power_modes_t power_mode);
 
 /**
- * @brief reads pressure oversampling setting from bmp280.
+ * @brief gets pressure oversampling setting of bmp280 from the register shadow.
  * 
  * @param[in] bmp280_handle bmp280 device handle.
  * @param[out] oversampling pressure oversampling setting.
@@ -347,16 +544,16 @@ esp_err_t i2c_bmp280_set_power_mode(i2c_bmp280_handle_t bmp280_handle, const i2c
 esp_err_t i2c_bmp280_get_pressure_oversampling(i2c_bmp280_handle_t bmp280_handle, i2c_bmp280_pressure_oversampling_t *const oversampling);
 
 /**
- * @brief writes pressure oversampling setting to bmp280.  See datasheet, section 3.3.1, table 4.
+ * @brief writes pressure oversampling setting to bmp280 when changed.  See datasheet, section 3.3.1, table 4.
  * 
  * @param bmp280_handle[in] bmp280 device handle.
  * @param oversampling[in] pressure oversampling setting.
- * @return esp_err_t ESP_OK on success.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE while streaming.
  */
 esp_err_t i2c_bmp280_set_pressure_oversampling(i2c_bmp280_handle_t bmp280_handle, const i2c_bmp280_pressure_oversampling_t oversampling);
 
 /**
- * @brief reads temperature oversampling setting from bmp280.
+ * @brief gets temperature oversampling setting of bmp280 from the register shadow.
  * 
  * @param[in] bmp280_handle bmp280 device handle.
  * @param[out] oversampling temperature oversampling setting.
@@ -365,16 +562,34 @@ esp_err_t i2c_bmp280_set_pressure_oversampling(i2c_bmp280_handle_t bmp280_handle
 esp_err_t i2c_bmp280_get_temperature_oversampling(i2c_bmp280_handle_t bmp280_handle, i2c_bmp280_temperature_oversampling_t *const oversampling);
 
 /**
- * @brief writes temperature oversampling setting to bmp280.  See datasheet, section 3.3.1, table 4.
+ * @brief writes temperature oversampling setting to bmp280 when changed.  See datasheet, section 3.3.1, table 4.
  * 
  * @param[in] bmp280_handle bmp280 device handle.
  * @param[in] oversampling temperature oversampling setting.
- * @return esp_err_t ESP_OK on success.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE while streaming.
  */
 esp_err_t i2c_bmp280_set_temperature_oversampling(i2c_bmp280_handle_t bmp280_handle, const i2c_bmp280_temperature_oversampling_t oversampling);
 
 /**
- * @brief reads standby time setting from bmp280.
+ * @brief gets humidity oversampling setting of bme280 from the register shadow.  See BME280 datasheet, section 5.4.3.
+ * 
+ * @param bmp280_handle[in] bmp280 device handle.
+ * @param oversampling[out] humidity oversampling setting.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_SUPPORTED when the device is not a bme280.
+ */
+esp_err_t i2c_bmp280_get_humidity_oversampling(i2c_bmp280_handle_t bmp280_handle, i2c_bmp280_humidity_oversampling_t *const oversampling);
+
+/**
+ * @brief writes humidity oversampling setting to bme280 when changed.  See BME280 datasheet, section 5.4.3.
+ * 
+ * @param bmp280_handle[in] bmp280 device handle.
+ * @param oversampling[in] humidity oversampling setting.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE while streaming, ESP_ERR_NOT_SUPPORTED when the device is not a bme280.
+ */
+esp_err_t i2c_bmp280_set_humidity_oversampling(i2c_bmp280_handle_t bmp280_handle, const i2c_bmp280_humidity_oversampling_t oversampling);
+
+/**
+ * @brief gets standby time setting of bmp280 from the register shadow.
  * 
  * @param[in] bmp280_handle bmp280 device handle.
  * @param[out] standby_time standby time setting.
@@ -383,16 +598,16 @@ esp_err_t i2c_bmp280_set_temperature_oversampling(i2c_bmp280_handle_t bmp280_han
 esp_err_t i2c_bmp280_get_standby_time(i2c_bmp280_handle_t bmp280_handle, i2c_bmp280_standby_times_t *const standby_time);
 
 /**
- * @brief writes standby time setting to bmp280.
+ * @brief writes standby time setting to bmp280 when changed.
  * 
  * @param[in] bmp280_handle bmp280 device handle.
  * @param[in] standby_time standby time setting.
- * @return esp_err_t ESP_OK on success.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE while streaming.
  */
 esp_err_t i2c_bmp280_set_standby_time(i2c_bmp280_handle_t bmp280_handle, const i2c_bmp280_standby_times_t standby_time);
 
 /**
- * @brief reads IIR filter setting to bmp280.
+ * @brief gets IIR filter setting of bmp280 from the register shadow.
  * 
  * @param[in] bmp280_handle bmp280 device handle.
  * @param[out] iir_filter IIR filter setting.
@@ -401,14 +616,25 @@ esp_err_t i2c_bmp280_set_standby_time(i2c_bmp280_handle_t bmp280_handle, const i
 esp_err_t i2c_bmp280_get_iir_filter(i2c_bmp280_handle_t bmp280_handle, i2c_bmp280_iir_filters_t *const iir_filter);
 
 /**
- * @brief writes IIR filter setting from bmp280.  See datasheet, section 3.4, table 7.
+ * @brief writes IIR filter setting to bmp280 when changed.  See datasheet, section 3.4, table 7.
  * 
  * @param[in] bmp280_handle bmp280 device handle.
  * @param[in] iir_filter IIR filter setting.
- * @return esp_err_t ESP_OK on success.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE while streaming.
  */
 esp_err_t i2c_bmp280_set_iir_filter(i2c_bmp280_handle_t bmp280_handle, const i2c_bmp280_iir_filters_t iir_filter);
 
+/**
+ * @brief applies a configuration to bmp280, the power mode, standby time, IIR filter, oversampling 
+ * settings and compensation back-end.  Register field changes are collected in the register shadow 
+ * and each changed register is written once, unchanged registers are not written.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @param[in] bmp280_config configuration of the bmp280 device, the I2C and cache settings are ignored.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE while streaming.
+ */
+esp_err_t i2c_bmp280_reconfigure(i2c_bmp280_handle_t bmp280_handle, const i2c_bmp280_config_t *bmp280_config);
+
 /**
  * @brief issues soft-reset sensor and initializes registers for bmp280.
  *
@@ -417,6 +643,16 @@ esp_err_t i2c_bmp280_set_iir_filter(i2c_bmp280_handle_t bmp280_handle, const i2c
  */
 esp_err_t i2c_bmp280_reset(i2c_bmp280_handle_t bmp280_handle);
 
+/**
+ * @brief re-initializes bmp280 after a bus fault or power glitch, the device is soft-reset and the 
+ * configured registers are written again.  A started forced measurement is discarded and normal 
+ * mode streaming is restarted.
+ *
+ * @param[in] bmp280_handle bmp280 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_bmp280_reinit(i2c_bmp280_handle_t bmp280_handle);
+
 /**
  * @brief removes an bmp280 device from master bus.
  *
@@ -38,6 +38,7 @@
 #include <stdio.h>
 #include <esp_log.h>
 #include <esp_check.h>
+#include <esp_timer.h>
 #include <driver/i2c_master.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
@@ -62,10 +63,84 @@ static char uint32_to_binary_buffer[UINT32_TO_BINARY_BUFFER_SIZE];
 */
 static const char *TAG = "i2c_master_ext";
 
+/**
+ * @brief I2C device statistics entry, a device address and its registered handle.
+ */
+typedef struct {
+    i2c_master_dev_handle_t dev_handle; /*!< registered device handle, NULL when unregistered */
+    i2c_master_stats_t      stats;      /*!< statistics of the device address */
+} i2c_stats_entry_t;
+
+/* device statistics, shared with the I2C interrupt of asynchronous devices */
+static i2c_stats_entry_t    s_stats[I2C_STATS_DEVICES_MAX];
+static uint8_t              s_stats_size = 0;
+static portMUX_TYPE         s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
 /*
 * functions and subrountines
 */
 
+/**
+ * @brief Counts a completed transaction of a device handle, unregistered handles aren't counted.  
+ * The caller holds the statistics lock.
+ */
+static inline void i2c_master_stats_count(i2c_master_dev_handle_t handle, const size_t bytes, const esp_err_t result, const int64_t latency_us) {
+    i2c_master_stats_t *stats = NULL;
+    uint8_t             bucket = 0;
+
+    for (uint8_t i = 0; i < s_stats_size; i++) {
+        if (s_stats[i].dev_handle == handle) {
+            stats = &s_stats[i].stats;
+            break;
+        }
+    }
+    if (stats == NULL) return;
+
+    const uint32_t latency = (latency_us > 0) ? (uint32_t)latency_us : 0;
+
+    while (bucket < I2C_STATS_LATENCY_BUCKETS - 1 && latency >= I2C_STATS_LATENCY_BUCKET_US(bucket)) bucket++;
+
+    stats->transactions++;
+    stats->latency_hist[bucket]++;
+    stats->latency_sum_us += latency;
+    if (latency > stats->latency_max_us) stats->latency_max_us = latency;
+
+    if (result == ESP_OK) {
+        stats->bytes += bytes;
+    } else if (result == ESP_ERR_TIMEOUT) {
+        stats->timeouts++;
+    } else {
+        stats->nacks++;
+    }
+}
+
+/**
+ * @brief Runs a blocking transmit, receive or write-read transaction by the sizes given and counts 
+ * it in the device statistics.
+ */
+static inline esp_err_t i2c_master_stats_transfer(i2c_master_dev_handle_t handle, const uint8_t *write_buffer, const size_t write_size, 
+                                                    uint8_t *read_buffer, const size_t read_size, const int xfer_timeout_ms) {
+    esp_err_t ret;
+
+    const int64_t start_us = esp_timer_get_time();
+
+    if (write_size && read_size) {
+        ret = i2c_master_transmit_receive(handle, write_buffer, write_size, read_buffer, read_size, xfer_timeout_ms);
+    } else if (write_size) {
+        ret = i2c_master_transmit(handle, write_buffer, write_size, xfer_timeout_ms);
+    } else {
+        ret = i2c_master_receive(handle, read_buffer, read_size, xfer_timeout_ms);
+    }
+
+    const int64_t latency_us = esp_timer_get_time() - start_us;
+
+    taskENTER_CRITICAL(&s_stats_lock);
+    i2c_master_stats_count(handle, write_size + read_size, ret, latency_us);
+    taskEXIT_CRITICAL(&s_stats_lock);
+
+    return ret;
+}
+
 const char *uint8_to_binary(uint8_t n) {
     uint8_to_binary_buffer[8] = '\0';
 
@@ -135,7 +210,7 @@ esp_err_t i2c_master_bus_read_uint8(i2c_master_dev_handle_t handle, const uint8_
 
     ESP_ARG_CHECK( handle && data ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle, tx, I2C_UINT8_SIZE, rx, I2C_UINT8_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_uint8 failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit_receive(handle, tx, I2C_UINT8_SIZE, rx, I2C_UINT8_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_uint8 failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_read_uint8 - rx[0] %02x", rx[0]);
 
@@ -150,7 +225,7 @@ esp_err_t i2c_master_bus_read_uint16(i2c_master_dev_handle_t handle, const uint8
 
     ESP_ARG_CHECK( handle && data ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle, tx, I2C_UINT8_SIZE, rx, I2C_UINT16_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_uint16 failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit_receive(handle, tx, I2C_UINT8_SIZE, rx, I2C_UINT16_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_uint16 failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_read_uint16 - rx[0] %02x | rx[1] %02x", rx[0], rx[1]);
 
@@ -164,7 +239,7 @@ esp_err_t i2c_master_bus_read_byte16(i2c_master_dev_handle_t handle, const uint8
 
     ESP_ARG_CHECK( handle && data ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle, tx, I2C_UINT8_SIZE, *data, I2C_UINT16_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_byte16 failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit_receive(handle, tx, I2C_UINT8_SIZE, *data, I2C_UINT16_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_byte16 failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_read_uint16 - data[0] %02x | data[1] %02x", *data[0], *data[1]);
 
@@ -176,7 +251,7 @@ esp_err_t i2c_master_bus_read_byte24(i2c_master_dev_handle_t handle, const uint8
 
     ESP_ARG_CHECK( handle && data ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle, tx, I2C_UINT8_SIZE, *data, I2C_UINT24_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_byte24 failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit_receive(handle, tx, I2C_UINT8_SIZE, *data, I2C_UINT24_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_byte24 failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_read_uint24 - data[0] %02x | data[1] %02x | data[2] %02x", *data[0], *data[1], *data[2]);
 
@@ -188,7 +263,7 @@ esp_err_t i2c_master_bus_read16_byte24(i2c_master_dev_handle_t handle, const uin
 
     ESP_ARG_CHECK( handle && data ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle, tx.bytes, I2C_UINT16_SIZE, *data, I2C_UINT24_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read16_byte24 failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit_receive(handle, tx.bytes, I2C_UINT16_SIZE, *data, I2C_UINT24_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read16_byte24 failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_read16_uint24 - data[0] %02x | data[1] %02x | data[2] %02x", *data[0], *data[1], *data[2]);
 
@@ -201,7 +276,7 @@ esp_err_t i2c_master_bus_read_uint32(i2c_master_dev_handle_t handle, const uint8
 
     ESP_ARG_CHECK( handle && data ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle, tx, I2C_UINT8_SIZE, rx, I2C_UINT32_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_uint32 failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit_receive(handle, tx, I2C_UINT8_SIZE, rx, I2C_UINT32_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_uint32 failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_read_uint32 - rx[0] %02x | rx[1] %02x | rx[2] %02x | rx[3] %02x", rx[0], rx[1], rx[2], rx[3]);
 
@@ -215,7 +290,7 @@ esp_err_t i2c_master_bus_read_byte32(i2c_master_dev_handle_t handle, const uint8
 
     ESP_ARG_CHECK( handle && data ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle, tx, I2C_UINT8_SIZE, *data, I2C_UINT32_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_byte32 failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit_receive(handle, tx, I2C_UINT8_SIZE, *data, I2C_UINT32_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_byte32 failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_read_uint32 - rx[0] %02x | rx[1] %02x | rx[2] %02x | rx[3] %02x", *data[0], *data[1], *data[2], *data[3]);
 
@@ -227,7 +302,7 @@ esp_err_t i2c_master_bus_read_byte48(i2c_master_dev_handle_t handle, const uint8
 
     ESP_ARG_CHECK( handle && data ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle, tx, I2C_UINT8_SIZE, *data, I2C_UINT48_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_byte48 failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit_receive(handle, tx, I2C_UINT8_SIZE, *data, I2C_UINT48_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_byte48 failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_read_uint48 - rx[0] %02x | rx[1] %02x | rx[2] %02x | rx[3] %02x | rx[4] %02x | rx[5] %02x", *data[0], *data[1], *data[2], *data[3], *data[4], *data[5]);
 
@@ -239,7 +314,7 @@ esp_err_t i2c_master_bus_read16_byte48(i2c_master_dev_handle_t handle, const uin
 
     ESP_ARG_CHECK( handle && data ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle, tx.bytes, I2C_UINT16_SIZE, *data, I2C_UINT48_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read16_byte48 failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit_receive(handle, tx.bytes, I2C_UINT16_SIZE, *data, I2C_UINT48_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read16_byte48 failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_read16_uint48 - rx[0] %02x | rx[1] %02x | rx[2] %02x | rx[3] %02x | rx[4] %02x | rx[5] %02x", *data[0], *data[1], *data[2], *data[3], *data[4], *data[5]);
 
@@ -251,7 +326,7 @@ esp_err_t i2c_master_bus_read_byte64(i2c_master_dev_handle_t handle, const uint8
 
     ESP_ARG_CHECK( handle && data ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle, tx, I2C_UINT8_SIZE, *data, I2C_UINT64_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_byte48 failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit_receive(handle, tx, I2C_UINT8_SIZE, *data, I2C_UINT64_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read_byte48 failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_read_uint64 - rx[0] %02x | rx[1] %02x | rx[2] %02x | rx[3] %02x | rx[4] %02x | rx[5] %02x | rx[6] %02x | rx[7] %02x", *data[0], *data[1], *data[2], *data[3], *data[4], *data[5], *data[6], *data[7]);
 
@@ -263,7 +338,7 @@ esp_err_t i2c_master_bus_read16_byte64(i2c_master_dev_handle_t handle, const uin
 
     ESP_ARG_CHECK( handle && data ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit_receive(handle, tx.bytes, I2C_UINT16_SIZE, *data, I2C_UINT64_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read16_byte48 failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit_receive(handle, tx.bytes, I2C_UINT16_SIZE, *data, I2C_UINT64_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_read16_byte48 failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_read16_uint64 - rx[0] %02x | rx[1] %02x | rx[2] %02x | rx[3] %02x | rx[4] %02x | rx[5] %02x | rx[6] %02x | rx[7] %02x", *data[0], *data[1], *data[2], *data[3], *data[4], *data[5], *data[6], *data[7]);
 
@@ -276,7 +351,7 @@ esp_err_t i2c_master_bus_write_cmd(i2c_master_dev_handle_t handle, const uint8_t
 
     ESP_ARG_CHECK( handle ); // ignore `command` given a range of 0x00 to 0xff is acceptable
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(handle, tx, I2C_UINT8_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_write_cmd failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit(handle, tx, I2C_UINT8_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_write_cmd failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_write_cmd - tx[0] %02x", tx[0]);
 
@@ -288,7 +363,7 @@ esp_err_t i2c_master_bus_write16_cmd(i2c_master_dev_handle_t handle, const uint1
 
     ESP_ARG_CHECK( handle ); // ignore `command` given a range of 0x00 to 0xff is acceptable
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(handle, tx.bytes, I2C_UINT16_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_write16_cmd failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit(handle, tx.bytes, I2C_UINT16_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_write16_cmd failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_write16_cmd - tx[0] %02x | tx[1] %02x ", tx.bytes[0], tx.bytes[1]);
 
@@ -300,7 +375,7 @@ esp_err_t i2c_master_bus_write_uint8(i2c_master_dev_handle_t handle, const uint8
 
     ESP_ARG_CHECK( handle ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(handle, tx, I2C_UINT16_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_write_uint8 failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit(handle, tx, I2C_UINT16_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_write_uint8 failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_write_uint8 - tx[0] %02x | tx[1] %02x", tx[0], tx[1]);
 
@@ -317,9 +392,665 @@ esp_err_t i2c_master_bus_write_uint16(i2c_master_dev_handle_t handle, const uint
     tx[1] = data & 0x00FF;  // lsb
     tx[2] = data >> 8;      // msb
 
-    ESP_RETURN_ON_ERROR( i2c_master_transmit(handle, tx, I2C_UINT24_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_write_uint16 failed" );
+    ESP_RETURN_ON_ERROR( i2c_master_bus_transmit(handle, tx, I2C_UINT24_SIZE, I2C_XFR_TIMEOUT_MS), TAG, "i2c_master_bus_write_uint16 failed" );
 
     ESP_LOGD(TAG, "i2c_master_bus_write_uint8 - tx[0] %02x | tx[1] %02x | tx[2] %02x", tx[0], tx[1], tx[2]);
 
     return ESP_OK;
 }
+
+esp_err_t i2c_master_bus_transmit(i2c_master_dev_handle_t handle, const uint8_t *write_buffer, const size_t write_size, const int xfer_timeout_ms) {
+    ESP_ARG_CHECK( handle && write_buffer && write_size );
+
+    return i2c_master_stats_transfer(handle, write_buffer, write_size, NULL, 0, xfer_timeout_ms);
+}
+
+esp_err_t i2c_master_bus_receive(i2c_master_dev_handle_t handle, uint8_t *read_buffer, const size_t read_size, const int xfer_timeout_ms) {
+    ESP_ARG_CHECK( handle && read_buffer && read_size );
+
+    return i2c_master_stats_transfer(handle, NULL, 0, read_buffer, read_size, xfer_timeout_ms);
+}
+
+esp_err_t i2c_master_bus_transmit_receive(i2c_master_dev_handle_t handle, const uint8_t *write_buffer, const size_t write_size, uint8_t *read_buffer, const size_t read_size, const int xfer_timeout_ms) {
+    ESP_ARG_CHECK( handle && write_buffer && write_size && read_buffer && read_size );
+
+    return i2c_master_stats_transfer(handle, write_buffer, write_size, read_buffer, read_size, xfer_timeout_ms);
+}
+
+/**
+ * @brief Queues a register operation into an I2C batch, the first queueing error is kept.
+ */
+static inline i2c_batch_op_t *i2c_master_batch_queue(i2c_batch_t *const batch, const i2c_batch_op_types_t type, const uint8_t reg_addr, const uint8_t size) {
+    if (batch->ops_size >= I2C_BATCH_OPS_MAX) {
+        if (batch->queue_result == ESP_OK) batch->queue_result = ESP_ERR_NO_MEM;
+        return NULL;
+    }
+
+    i2c_batch_op_t *op = &batch->ops[batch->ops_size++];
+    op->type     = type;
+    op->reg_addr = reg_addr;
+    op->rx_data  = NULL;
+    op->size     = size;
+    op->result   = ESP_ERR_INVALID_STATE;
+
+    return op;
+}
+
+esp_err_t i2c_master_batch_init(i2c_batch_t *const batch, i2c_master_dev_handle_t handle) {
+    ESP_ARG_CHECK( batch && handle );
+
+    batch->dev_handle   = handle;
+    batch->ops_size     = 0;
+    batch->queue_result = ESP_OK;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_batch_read(i2c_batch_t *const batch, const uint8_t reg_addr, uint8_t *const data, const uint8_t size) {
+    ESP_ARG_CHECK( batch && data && size ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
+
+    i2c_batch_op_t *op = i2c_master_batch_queue(batch, I2C_BATCH_OP_READ, reg_addr, size);
+    ESP_RETURN_ON_FALSE( op, ESP_ERR_NO_MEM, TAG, "i2c_master_batch_read failed, batch is full" );
+
+    op->rx_data = data;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_batch_write(i2c_batch_t *const batch, const uint8_t reg_addr, const uint8_t *const data, const uint8_t size) {
+    ESP_ARG_CHECK( batch && data && size && size <= I2C_BATCH_WRITE_MAX ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
+
+    i2c_batch_op_t *op = i2c_master_batch_queue(batch, I2C_BATCH_OP_WRITE, reg_addr, size);
+    ESP_RETURN_ON_FALSE( op, ESP_ERR_NO_MEM, TAG, "i2c_master_batch_write failed, batch is full" );
+
+    memcpy(op->tx_data, data, size);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_batch_write_uint8(i2c_batch_t *const batch, const uint8_t reg_addr, const uint8_t data) {
+    return i2c_master_batch_write(batch, reg_addr, &data, I2C_UINT8_SIZE);
+}
+
+esp_err_t i2c_master_batch_execute(i2c_batch_t *const batch) {
+    uint8_t   tx[I2C_UINT8_SIZE + I2C_BATCH_WRITE_MAX];
+    esp_err_t ret = ESP_OK;
+
+    ESP_ARG_CHECK( batch && batch->dev_handle );
+
+    /* a batch with queueing errors is incomplete, it isn't executed */
+    ESP_RETURN_ON_ERROR( batch->queue_result, TAG, "i2c_master_batch_execute failed, batch is incomplete" );
+
+    /* run register operations back-to-back, stop at the first failed operation */
+    for (uint8_t i = 0; i < batch->ops_size && ret == ESP_OK; i++) {
+        i2c_batch_op_t *op = &batch->ops[i];
+
+        tx[0] = op->reg_addr;
+
+        if (op->type == I2C_BATCH_OP_READ) {
+            op->result = i2c_master_bus_transmit_receive(batch->dev_handle, tx, I2C_UINT8_SIZE, op->rx_data, op->size, I2C_XFR_TIMEOUT_MS);
+        } else {
+            memcpy(&tx[1], op->tx_data, op->size);
+            op->result = i2c_master_bus_transmit(batch->dev_handle, tx, I2C_UINT8_SIZE + op->size, I2C_XFR_TIMEOUT_MS);
+        }
+
+        ESP_LOGD(TAG, "i2c_master_batch_execute - op %u %s reg %02x (%u bytes): %s", i, (op->type == I2C_BATCH_OP_READ) ? "read" : "write", op->reg_addr, op->size, esp_err_to_name(op->result));
+
+        ret = op->result;
+    }
+
+    ESP_RETURN_ON_ERROR( ret, TAG, "i2c_master_batch_execute failed" );
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Gets a shadowed register by register address, NULL when the register isn't shadowed.
+ */
+static inline i2c_shadow_reg_t *i2c_master_shadow_find(i2c_shadow_t *const shadow, const uint8_t reg_addr) {
+    for (uint8_t i = 0; i < shadow->regs_size; i++) {
+        if (shadow->regs[i].reg_addr == reg_addr) return &shadow->regs[i];
+    }
+    return NULL;
+}
+
+esp_err_t i2c_master_shadow_init(i2c_shadow_t *const shadow, i2c_master_dev_handle_t handle, const bool verify) {
+    ESP_ARG_CHECK( shadow && handle );
+
+    shadow->dev_handle = handle;
+    shadow->regs_size  = 0;
+    shadow->verify     = verify;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_shadow_add(i2c_shadow_t *const shadow, const uint8_t reg_addr, uint8_t *const value, const uint8_t mask) {
+    ESP_ARG_CHECK( shadow && value ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
+
+    ESP_RETURN_ON_FALSE( shadow->regs_size < I2C_SHADOW_REGS_MAX, ESP_ERR_NO_MEM, TAG, "i2c_master_shadow_add failed, shadow is full" );
+
+    i2c_shadow_reg_t *reg = &shadow->regs[shadow->regs_size++];
+    reg->reg_addr = reg_addr;
+    reg->value    = value;
+    reg->mask     = mask;
+    reg->dirty    = false;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_shadow_refresh(i2c_shadow_t *const shadow) {
+    i2c_batch_t batch;
+
+    ESP_ARG_CHECK( shadow && shadow->dev_handle );
+
+    /* read shadowed registers back-to-back */
+    ESP_RETURN_ON_ERROR( i2c_master_batch_init(&batch, shadow->dev_handle), TAG, "i2c_master_shadow_refresh failed" );
+    for (uint8_t i = 0; i < shadow->regs_size; i++) {
+        i2c_master_batch_read(&batch, shadow->regs[i].reg_addr, shadow->regs[i].value, I2C_UINT8_SIZE);
+    }
+    ESP_RETURN_ON_ERROR( i2c_master_batch_execute(&batch), TAG, "i2c_master_shadow_refresh failed" );
+
+    for (uint8_t i = 0; i < shadow->regs_size; i++) shadow->regs[i].dirty = false;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_shadow_read(i2c_shadow_t *const shadow, const uint8_t reg_addr) {
+    ESP_ARG_CHECK( shadow && shadow->dev_handle );
+
+    i2c_shadow_reg_t *reg = i2c_master_shadow_find(shadow, reg_addr);
+    ESP_RETURN_ON_FALSE( reg, ESP_ERR_NOT_FOUND, TAG, "i2c_master_shadow_read failed, register %02x isn't shadowed", reg_addr );
+
+    ESP_RETURN_ON_ERROR( i2c_master_bus_read_uint8(shadow->dev_handle, reg_addr, reg->value), TAG, "i2c_master_shadow_read failed" );
+
+    reg->dirty = false;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_shadow_update(i2c_shadow_t *const shadow, const uint8_t reg_addr, const uint8_t field_mask, const uint8_t field_value) {
+    ESP_ARG_CHECK( shadow );
+
+    i2c_shadow_reg_t *reg = i2c_master_shadow_find(shadow, reg_addr);
+    ESP_RETURN_ON_FALSE( reg, ESP_ERR_NOT_FOUND, TAG, "i2c_master_shadow_update failed, register %02x isn't shadowed", reg_addr );
+
+    const uint8_t value = (uint8_t)(((*reg->value & ~field_mask) | (field_value & field_mask)) & reg->mask);
+
+    if (value != *reg->value) {
+        *reg->value = value;
+        reg->dirty  = true;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_shadow_mark_dirty(i2c_shadow_t *const shadow, const uint8_t reg_addr) {
+    ESP_ARG_CHECK( shadow );
+
+    i2c_shadow_reg_t *reg = i2c_master_shadow_find(shadow, reg_addr);
+    ESP_RETURN_ON_FALSE( reg, ESP_ERR_NOT_FOUND, TAG, "i2c_master_shadow_mark_dirty failed, register %02x isn't shadowed", reg_addr );
+
+    reg->dirty = true;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_shadow_flush(i2c_shadow_t *const shadow) {
+    uint8_t     read_back[I2C_SHADOW_REGS_MAX];
+    i2c_batch_t batch;
+    bool        verified = true;
+
+    ESP_ARG_CHECK( shadow && shadow->dev_handle );
+
+    ESP_RETURN_ON_ERROR( i2c_master_batch_init(&batch, shadow->dev_handle), TAG, "i2c_master_shadow_flush failed" );
+
+    /* queue one write per dirty register, writable bits only */
+    for (uint8_t i = 0; i < shadow->regs_size; i++) {
+        i2c_shadow_reg_t *reg = &shadow->regs[i];
+        if (reg->dirty == false) continue;
+        *reg->value &= reg->mask;
+        i2c_master_batch_write_uint8(&batch, reg->reg_addr, *reg->value);
+    }
+
+    /* nothing to write */
+    if (batch.ops_size == 0) return ESP_OK;
+
+    /* queue read-backs of the written registers */
+    if (shadow->verify == true) {
+        for (uint8_t i = 0; i < shadow->regs_size; i++) {
+            if (shadow->regs[i].dirty == true) i2c_master_batch_read(&batch, shadow->regs[i].reg_addr, &read_back[i], I2C_UINT8_SIZE);
+        }
+    }
+
+    /* attempt to write, and read back, registers back-to-back, registers stay dirty on failure */
+    ESP_RETURN_ON_ERROR( i2c_master_batch_execute(&batch), TAG, "i2c_master_shadow_flush failed" );
+
+    /* clean registers and keep device values of mismatched registers */
+    for (uint8_t i = 0; i < shadow->regs_size; i++) {
+        i2c_shadow_reg_t *reg = &shadow->regs[i];
+        if (reg->dirty == false) continue;
+        reg->dirty = false;
+        if (shadow->verify == true && (read_back[i] & reg->mask) != *reg->value) {
+            ESP_LOGW(TAG, "i2c_master_shadow_flush - reg %02x wrote %02x, read back %02x", reg->reg_addr, *reg->value, read_back[i]);
+            *reg->value = read_back[i];
+            verified    = false;
+        }
+    }
+
+    ESP_RETURN_ON_FALSE( verified, ESP_ERR_INVALID_RESPONSE, TAG, "i2c_master_shadow_flush failed, register verification mismatch" );
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_shadow_write(i2c_shadow_t *const shadow, const uint8_t reg_addr, const uint8_t value) {
+    ESP_ARG_CHECK( shadow && shadow->dev_handle );
+
+    i2c_shadow_reg_t *reg = i2c_master_shadow_find(shadow, reg_addr);
+    ESP_RETURN_ON_FALSE( reg, ESP_ERR_NOT_FOUND, TAG, "i2c_master_shadow_write failed, register %02x isn't shadowed", reg_addr );
+
+    /* write through, the register is written even if the shadow is unchanged */
+    *reg->value = value;
+    reg->dirty  = true;
+
+    return i2c_master_shadow_flush(shadow);
+}
+
+/**
+ * @brief I2C transaction done callback of an asynchronous device, transactions of a device complete 
+ * in submission order and the oldest in-flight operation is completed.
+ */
+static bool i2c_master_async_on_trans_done(i2c_master_dev_handle_t i2c_dev, const i2c_master_event_data_t *evt_data, void *arg) {
+    i2c_async_t                *async      = (i2c_async_t *)arg;
+    const esp_err_t             result     = (evt_data->event == I2C_EVENT_DONE) ? ESP_OK : ESP_FAIL;
+    i2c_master_async_callback_t callback   = NULL;
+    void                       *user_ctx   = NULL;
+    int64_t                     submit_us  = 0;
+    uint8_t                     size       = 0;
+    BaseType_t                  task_woken = pdFALSE;
+
+    /* pop the oldest in-flight operation */
+    taskENTER_CRITICAL_ISR(&async->lock);
+    if (async->ops_size > 0) {
+        callback        = async->ops[async->ops_head].callback;
+        user_ctx        = async->ops[async->ops_head].user_ctx;
+        submit_us       = async->ops[async->ops_head].submit_us;
+        size            = async->ops[async->ops_head].size;
+        async->ops_head = (async->ops_head + 1) % I2C_ASYNC_QUEUE_DEPTH;
+        async->ops_size--;
+        if (result != ESP_OK && async->result == ESP_OK) async->result = result;
+    }
+    taskEXIT_CRITICAL_ISR(&async->lock);
+
+    if (size) {
+        const int64_t latency_us = esp_timer_get_time() - submit_us;
+        taskENTER_CRITICAL_ISR(&s_stats_lock);
+        i2c_master_stats_count(i2c_dev, size, result, latency_us);
+        taskEXIT_CRITICAL_ISR(&s_stats_lock);
+    }
+
+    if (callback) callback(i2c_dev, result, user_ctx);
+
+    vTaskNotifyGiveFromISR(async->task_handle, &task_woken);
+
+    return task_woken == pdTRUE;
+}
+
+/**
+ * @brief Reserves an in-flight slot and submits a register operation, the slot is released when 
+ * the transaction is not queued.
+ */
+static inline esp_err_t i2c_master_async_submit(i2c_async_t *const async, const uint8_t reg_addr, const uint8_t *const tx_data, const uint8_t tx_size, 
+                                                uint8_t *const rx_data, const uint8_t rx_size, i2c_master_async_callback_t callback, void *user_ctx) {
+    i2c_async_op_t *op = NULL;
+    esp_err_t       ret;
+
+    /* reserve the in-flight slot after the newest operation */
+    taskENTER_CRITICAL(&async->lock);
+    if (async->ops_size < I2C_ASYNC_QUEUE_DEPTH) {
+        op = &async->ops[(async->ops_head + async->ops_size) % I2C_ASYNC_QUEUE_DEPTH];
+        async->ops_size++;
+    }
+    taskEXIT_CRITICAL(&async->lock);
+
+    ESP_RETURN_ON_FALSE( op, ESP_ERR_NO_MEM, TAG, "i2c_master_async_submit failed, in-flight queue is full" );
+
+    op->tx_data[0] = reg_addr;
+    if (tx_size) memcpy(&op->tx_data[1], tx_data, tx_size);
+    op->callback   = callback;
+    op->user_ctx   = user_ctx;
+    op->size       = I2C_UINT8_SIZE + tx_size + rx_size;
+    op->submit_us  = esp_timer_get_time();
+
+    /* transactions are counted in the statistics on completion */
+    if (rx_size) {
+        ret = i2c_master_transmit_receive(async->dev_handle, op->tx_data, I2C_UINT8_SIZE, rx_data, rx_size, I2C_XFR_TIMEOUT_MS);
+    } else {
+        ret = i2c_master_transmit(async->dev_handle, op->tx_data, I2C_UINT8_SIZE + tx_size, I2C_XFR_TIMEOUT_MS);
+    }
+
+    /* a transaction not queued never completes, count it and release its slot, the newest one */
+    if (ret != ESP_OK) {
+        const int64_t latency_us = esp_timer_get_time() - op->submit_us;
+        taskENTER_CRITICAL(&s_stats_lock);
+        i2c_master_stats_count(async->dev_handle, op->size, ret, latency_us);
+        taskEXIT_CRITICAL(&s_stats_lock);
+        taskENTER_CRITICAL(&async->lock);
+        async->ops_size--;
+        taskEXIT_CRITICAL(&async->lock);
+    }
+
+    ESP_LOGD(TAG, "i2c_master_async_submit - %s reg %02x (%u bytes): %s", rx_size ? "read" : "write", reg_addr, rx_size ? rx_size : tx_size, esp_err_to_name(ret));
+
+    ESP_RETURN_ON_ERROR( ret, TAG, "i2c_master_async_submit failed" );
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_async_init(i2c_async_t *const async, i2c_master_dev_handle_t handle) {
+    const i2c_master_event_callbacks_t cbs = { .on_trans_done = i2c_master_async_on_trans_done };
+
+    ESP_ARG_CHECK( async && handle );
+
+    memset(async, 0, sizeof(i2c_async_t));
+    async->task_handle = xTaskGetCurrentTaskHandle();
+    async->result      = ESP_OK;
+    portMUX_INITIALIZE(&async->lock);
+
+    ESP_RETURN_ON_ERROR( i2c_master_register_event_callbacks(handle, &cbs, async), TAG, "i2c_master_async_init failed, the bus must be created with a transactions queue depth" );
+
+    async->dev_handle  = handle;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_async_read(i2c_async_t *const async, const uint8_t reg_addr, uint8_t *const data, const uint8_t size, i2c_master_async_callback_t callback, void *user_ctx) {
+    ESP_ARG_CHECK( async && async->dev_handle && data && size ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
+
+    return i2c_master_async_submit(async, reg_addr, NULL, 0, data, size, callback, user_ctx);
+}
+
+esp_err_t i2c_master_async_write(i2c_async_t *const async, const uint8_t reg_addr, const uint8_t *const data, const uint8_t size, i2c_master_async_callback_t callback, void *user_ctx) {
+    ESP_ARG_CHECK( async && async->dev_handle && data && size && size <= I2C_BATCH_WRITE_MAX ); // ignore `reg_addr` given a range of 0x00 to 0xff is acceptable
+
+    return i2c_master_async_submit(async, reg_addr, data, size, NULL, 0, callback, user_ctx);
+}
+
+esp_err_t i2c_master_async_wait_all_done(i2c_async_t *const async, const uint32_t timeout_ms) {
+    const TickType_t timeout_ticks = pdMS_TO_TICKS(timeout_ms);
+    const TickType_t start_ticks   = xTaskGetTickCount();
+    esp_err_t        result;
+
+    ESP_ARG_CHECK( async && async->dev_handle );
+
+    /* completions notify the waiting task, set before the in-flight operations are checked */
+    async->task_handle = xTaskGetCurrentTaskHandle();
+
+    /* every completion notifies the task, stale notifications only cost a loop */
+    while (async->ops_size > 0) {
+        const TickType_t elapsed_ticks = xTaskGetTickCount() - start_ticks;
+        if (elapsed_ticks >= timeout_ticks) return ESP_ERR_TIMEOUT;
+        ulTaskNotifyTake(pdTRUE, timeout_ticks - elapsed_ticks);
+    }
+
+    /* report and clear the first failed completion */
+    taskENTER_CRITICAL(&async->lock);
+    result        = async->result;
+    async->result = ESP_OK;
+    taskEXIT_CRITICAL(&async->lock);
+
+    return result;
+}
+
+esp_err_t i2c_master_async_deinit(i2c_async_t *const async) {
+    const i2c_master_event_callbacks_t cbs = { .on_trans_done = NULL };
+
+    ESP_ARG_CHECK( async && async->dev_handle );
+
+    ESP_RETURN_ON_FALSE( async->ops_size == 0, ESP_ERR_INVALID_STATE, TAG, "i2c_master_async_deinit failed, operations are in-flight" );
+
+    ESP_RETURN_ON_ERROR( i2c_master_register_event_callbacks(async->dev_handle, &cbs, NULL), TAG, "i2c_master_async_deinit failed" );
+
+    async->dev_handle = NULL;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Gets the statistics entry of a device address, NULL when the address isn't registered.  
+ * The caller holds the statistics lock.
+ */
+static inline i2c_stats_entry_t *i2c_master_stats_find(const uint16_t device_address) {
+    for (uint8_t i = 0; i < s_stats_size; i++) {
+        if (s_stats[i].stats.device_address == device_address) return &s_stats[i];
+    }
+    return NULL;
+}
+
+esp_err_t i2c_master_stats_register(i2c_master_dev_handle_t handle, const uint16_t device_address) {
+    esp_err_t ret = ESP_OK;
+
+    ESP_ARG_CHECK( handle );
+
+    taskENTER_CRITICAL(&s_stats_lock);
+    i2c_stats_entry_t *entry = i2c_master_stats_find(device_address);
+    if (entry == NULL && s_stats_size < I2C_STATS_DEVICES_MAX) {
+        entry = &s_stats[s_stats_size++];
+        memset(entry, 0, sizeof(i2c_stats_entry_t));
+        entry->stats.device_address = device_address;
+    }
+    if (entry) {
+        entry->dev_handle = handle;
+    } else {
+        ret = ESP_ERR_NO_MEM;
+    }
+    taskEXIT_CRITICAL(&s_stats_lock);
+
+    ESP_RETURN_ON_ERROR( ret, TAG, "i2c_master_stats_register failed, statistics are full" );
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_stats_unregister(i2c_master_dev_handle_t handle) {
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    ESP_ARG_CHECK( handle );
+
+    taskENTER_CRITICAL(&s_stats_lock);
+    for (uint8_t i = 0; i < s_stats_size; i++) {
+        if (s_stats[i].dev_handle == handle) {
+            s_stats[i].dev_handle = NULL;
+            ret = ESP_OK;
+        }
+    }
+    taskEXIT_CRITICAL(&s_stats_lock);
+
+    return ret;
+}
+
+esp_err_t i2c_master_stats_get(const uint16_t device_address, i2c_master_stats_t *const stats) {
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    ESP_ARG_CHECK( stats );
+
+    taskENTER_CRITICAL(&s_stats_lock);
+    i2c_stats_entry_t *entry = i2c_master_stats_find(device_address);
+    if (entry) {
+        *stats = entry->stats;
+        ret    = ESP_OK;
+    }
+    taskEXIT_CRITICAL(&s_stats_lock);
+
+    return ret;
+}
+
+esp_err_t i2c_master_stats_get_all(i2c_master_stats_t *const stats, uint8_t *const stats_size) {
+    ESP_ARG_CHECK( stats && stats_size );
+
+    taskENTER_CRITICAL(&s_stats_lock);
+    for (uint8_t i = 0; i < s_stats_size; i++) stats[i] = s_stats[i].stats;
+    *stats_size = s_stats_size;
+    taskEXIT_CRITICAL(&s_stats_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_stats_get_all_and_reset(i2c_master_stats_t *const stats, uint8_t *const stats_size) {
+    ESP_ARG_CHECK( stats && stats_size );
+
+    /* copy and clear in one critical section, transactions counted in between aren't lost */
+    taskENTER_CRITICAL(&s_stats_lock);
+    for (uint8_t i = 0; i < s_stats_size; i++) {
+        const uint16_t device_address = s_stats[i].stats.device_address;
+        stats[i] = s_stats[i].stats;
+        memset(&s_stats[i].stats, 0, sizeof(i2c_master_stats_t));
+        s_stats[i].stats.device_address = device_address;
+    }
+    *stats_size = s_stats_size;
+    taskEXIT_CRITICAL(&s_stats_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_stats_reset(void) {
+    taskENTER_CRITICAL(&s_stats_lock);
+    for (uint8_t i = 0; i < s_stats_size; i++) {
+        const uint16_t device_address = s_stats[i].stats.device_address;
+        memset(&s_stats[i].stats, 0, sizeof(i2c_master_stats_t));
+        s_stats[i].stats.device_address = device_address;
+    }
+    taskEXIT_CRITICAL(&s_stats_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_stats_count_retry(i2c_master_dev_handle_t handle) {
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    ESP_ARG_CHECK( handle );
+
+    taskENTER_CRITICAL(&s_stats_lock);
+    for (uint8_t i = 0; i < s_stats_size; i++) {
+        if (s_stats[i].dev_handle == handle) {
+            s_stats[i].stats.retries++;
+            ret = ESP_OK;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL(&s_stats_lock);
+
+    return ret;
+}
+
+esp_err_t i2c_master_recovery_init(i2c_recovery_t *const recovery, const i2c_recovery_config_t *const config, i2c_master_bus_handle_t bus_handle) {
+    ESP_ARG_CHECK( recovery && config && bus_handle );
+
+    memset(recovery, 0, sizeof(i2c_recovery_t));
+    recovery->config     = *config;
+    recovery->bus_handle = bus_handle;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_recovery_set_device(i2c_recovery_t *const recovery, i2c_master_dev_handle_t dev_handle, i2c_master_recovery_reinit_t reinit, void *device_ctx) {
+    ESP_ARG_CHECK( recovery && dev_handle );
+
+    recovery->dev_handle = dev_handle;
+    recovery->reinit     = reinit;
+    recovery->device_ctx = device_ctx;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_recovery_reset(i2c_recovery_t *const recovery) {
+    ESP_ARG_CHECK( recovery && recovery->bus_handle );
+
+    /* clock the bus free, a device holding SDA low mid-byte releases it */
+    recovery->health.bus_resets++;
+    ESP_RETURN_ON_ERROR( i2c_master_bus_reset(recovery->bus_handle), TAG, "i2c_master_recovery_reset failed, bus reset failed" );
+
+    /* restore the device state lost with the interrupted transaction */
+    if (recovery->reinit) {
+        recovery->health.reinits++;
+        ESP_RETURN_ON_ERROR( recovery->reinit(recovery->device_ctx), TAG, "i2c_master_recovery_reset failed, device re-initialization failed" );
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Checks whether an operation error is a bus or transfer error, a not acknowledged or 
+ * timed out transaction, that a retry with recovery can clear.
+ */
+static inline bool i2c_master_recovery_is_retryable(const esp_err_t result) {
+    return result == ESP_FAIL || result == ESP_ERR_TIMEOUT;
+}
+
+esp_err_t i2c_master_recovery_retry(i2c_recovery_t *const recovery, const esp_err_t result, i2c_master_recovery_operation_t operation, void *op_ctx) {
+    esp_err_t ret = result;
+    uint8_t   retry;
+
+    ESP_ARG_CHECK( recovery && operation );
+
+    /* only bus and transfer errors are retried, e.g. an invalid argument or state fails at once */
+    for (retry = 0; i2c_master_recovery_is_retryable(ret) && retry < recovery->config.retries; retry++) {
+        recovery->health.last_error = ret;
+        if (recovery->dev_handle) i2c_master_stats_count_retry(recovery->dev_handle);
+
+        /* back off exponentially, a transient glitch or busy device clears itself */
+        uint32_t backoff_ms = (retry < 31) ? recovery->config.backoff_ms << retry : UINT32_MAX;
+        if (backoff_ms > recovery->config.backoff_max_ms || backoff_ms < recovery->config.backoff_ms) backoff_ms = recovery->config.backoff_max_ms;
+        vTaskDelay(pdMS_TO_TICKS(backoff_ms));
+
+        /* a timeout is a held bus, a repeated failure may be a device out of step, reset both */
+        if (ret == ESP_ERR_TIMEOUT || retry > 0) {
+            const esp_err_t reset_ret = i2c_master_recovery_reset(recovery);
+            ESP_LOGW(TAG, "i2c_master_recovery_retry - bus reset and device re-initialization: %s", esp_err_to_name(reset_ret));
+        }
+
+        ESP_LOGW(TAG, "i2c_master_recovery_retry - retry %u of %u after %s", retry + 1, recovery->config.retries, esp_err_to_name(ret));
+
+        ret = operation(op_ctx);
+    }
+
+    /* update device health by the operation */
+    if (ret != ESP_OK) {
+        recovery->health.state      = I2C_DEVICE_HEALTH_FAILED;
+        recovery->health.last_error = ret;
+        recovery->health.failures++;
+    } else if (retry > 0 || recovery->health.failures > 0) {
+        recovery->health.state      = I2C_DEVICE_HEALTH_DEGRADED;
+        recovery->health.failures   = 0;
+        recovery->health.recoveries++;
+    } else {
+        recovery->health.state      = I2C_DEVICE_HEALTH_OK;
+    }
+
+    return ret;
+}
+
+esp_err_t i2c_master_recovery_execute(i2c_recovery_t *const recovery, i2c_master_recovery_operation_t operation, void *op_ctx) {
+    ESP_ARG_CHECK( recovery && operation );
+
+    return i2c_master_recovery_retry(recovery, operation(op_ctx), operation, op_ctx);
+}
+
+esp_err_t i2c_master_recovery_get_health(i2c_recovery_t *const recovery, i2c_device_health_t *const health) {
+    ESP_ARG_CHECK( recovery && health );
+
+    *health = recovery->health;
+
+    return ESP_OK;
+}
+
+const char *i2c_device_health_state_to_string(const i2c_device_health_states_t state) {
+    switch (state) {
+        case I2C_DEVICE_HEALTH_OK:
+            return "Ok";
+        case I2C_DEVICE_HEALTH_DEGRADED:
+            return "Degraded";
+        case I2C_DEVICE_HEALTH_FAILED:
+            return "Failed";
+        default:
+            return "Unknown";
+    }
+}
@@ -41,6 +41,8 @@
 #include <stdbool.h>
 #include <esp_err.h>
 #include <driver/i2c_master.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 
 
@@ -66,6 +68,199 @@ typedef uint8_t             i2c_uint24_t[I2C_UINT24_SIZE];
 typedef uint8_t             i2c_uint16_t[I2C_UINT16_SIZE];
 typedef uint8_t             i2c_uint8_t[I2C_UINT8_SIZE];
 
+#define I2C_BATCH_OPS_MAX       (16)    //!< maximum number of register operations in a batch
+#define I2C_BATCH_WRITE_MAX     (8)     //!< maximum number of data bytes of a batched register write
+
+/**
+ * @brief I2C batch register operation types enumerator.
+ */
+typedef enum {
+    I2C_BATCH_OP_READ = 0,  //!< register read, a write-read I2C transaction
+    I2C_BATCH_OP_WRITE      //!< register write, a write I2C transaction
+} i2c_batch_op_types_t;
+
+/**
+ * @brief I2C batch register operation structure.
+ */
+typedef struct {
+    i2c_batch_op_types_t    type;                           /*!< register operation type */
+    uint8_t                 reg_addr;                       /*!< device register address (1-byte) */
+    uint8_t                *rx_data;                        /*!< read destination, register reads only */
+    uint8_t                 tx_data[I2C_BATCH_WRITE_MAX];   /*!< data copied at queueing, register writes only */
+    uint8_t                 size;                           /*!< number of data bytes to read or write */
+    esp_err_t               result;                         /*!< result of the operation, ESP_ERR_INVALID_STATE until executed */
+} i2c_batch_op_t;
+
+/**
+ * @brief I2C batch structure, register operations of a device queued with `i2c_master_batch_read` 
+ * and `i2c_master_batch_write` and run back-to-back by `i2c_master_batch_execute`.  Batches are 
+ * small and are declared on the stack.
+ */
+typedef struct {
+    i2c_master_dev_handle_t dev_handle;                     /*!< device handle of the batched operations */
+    i2c_batch_op_t          ops[I2C_BATCH_OPS_MAX];         /*!< queued register operations */
+    uint8_t                 ops_size;                       /*!< number of queued register operations */
+    esp_err_t               queue_result;                   /*!< first queueing error, the batch is not executed when set */
+} i2c_batch_t;
+
+#define I2C_SHADOW_REGS_MAX     (8)     //!< maximum number of shadowed registers of a device
+
+/**
+ * @brief I2C shadowed register structure.
+ */
+typedef struct {
+    uint8_t                 reg_addr;   /*!< device register address (1-byte) */
+    uint8_t                *value;      /*!< shadow value, storage owned by the caller e.g. a register union of the device handle */
+    uint8_t                 mask;       /*!< writable bits, bits outside the mask are written as 0 */
+    bool                    dirty;      /*!< shadow value changed and not yet written to the device */
+} i2c_shadow_reg_t;
+
+/**
+ * @brief I2C register shadow structure, a write-through cache of the 8-bit configuration registers 
+ * of a device.  Field updates are applied to the shadow and marked dirty, a flush writes each dirty 
+ * register once, and reads are served from the shadow unless refreshed from the device.  Registers 
+ * with bits changed by the device itself must be refreshed before they are trusted.
+ */
+typedef struct {
+    i2c_master_dev_handle_t dev_handle;                     /*!< device handle of the shadowed registers */
+    i2c_shadow_reg_t        regs[I2C_SHADOW_REGS_MAX];      /*!< shadowed registers, flushed in the order added */
+    uint8_t                 regs_size;                      /*!< number of shadowed registers */
+    bool                    verify;                         /*!< read back and compare registers after they are written */
+} i2c_shadow_t;
+
+#define I2C_ASYNC_QUEUE_DEPTH   (4)     //!< maximum number of in-flight asynchronous register operations of a device
+
+/**
+ * @brief I2C asynchronous register operation completion callback, runs in ISR context from the 
+ * I2C interrupt in completion order.  The callback must be short and ISR safe.
+ * 
+ * @param handle device handle of the operation
+ * @param result ESP_OK when the operation completed, ESP_FAIL when it was not acknowledged
+ * @param user_ctx user context given when the operation was submitted
+ */
+typedef void (*i2c_master_async_callback_t)(i2c_master_dev_handle_t handle, const esp_err_t result, void *user_ctx);
+
+/**
+ * @brief I2C asynchronous register operation structure.
+ */
+typedef struct {
+    uint8_t                     tx_data[I2C_UINT8_SIZE + I2C_BATCH_WRITE_MAX];  /*!< register address and write data, kept until the operation completes */
+    i2c_master_async_callback_t callback;                                       /*!< completion callback, optional */
+    void                       *user_ctx;                                       /*!< completion callback user context */
+    int64_t                     submit_us;                                      /*!< submission time, the operation latency includes its time queued */
+    uint8_t                     size;                                           /*!< number of bytes of the transaction, register address included */
+} i2c_async_op_t;
+
+/**
+ * @brief I2C asynchronous device structure, a bounded in-flight queue of register operations of 
+ * a device on a bus created in asynchronous mode (`trans_queue_depth` set).  Every completion 
+ * notifies the task that last waited on it, see `i2c_master_async_wait_all_done`.
+ */
+typedef struct {
+    i2c_master_dev_handle_t     dev_handle;                     /*!< device handle of the operations */
+    volatile TaskHandle_t       task_handle;                    /*!< task notified on completions, the waiting task */
+    i2c_async_op_t              ops[I2C_ASYNC_QUEUE_DEPTH];     /*!< in-flight register operations, ring buffer */
+    uint8_t                     ops_head;                       /*!< oldest in-flight operation */
+    volatile uint8_t            ops_size;                       /*!< number of in-flight operations */
+    volatile esp_err_t          result;                         /*!< first failed completion since the last wait */
+    portMUX_TYPE                lock;                           /*!< in-flight queue lock, shared with the I2C interrupt */
+} i2c_async_t;
+
+#define I2C_STATS_DEVICES_MAX           (8)     //!< maximum number of device addresses with statistics
+#define I2C_STATS_LATENCY_BUCKETS       (10)    //!< number of transaction latency histogram buckets
+#define I2C_STATS_LATENCY_BUCKET0_US    (64)    //!< upper bound of the first latency bucket in micro-seconds, bounds double per bucket
+
+/**
+ * @brief Upper bound, exclusive, of latency histogram bucket `b` in micro-seconds.  The last bucket 
+ * is unbounded.
+ */
+#define I2C_STATS_LATENCY_BUCKET_US(b)  ((uint32_t)I2C_STATS_LATENCY_BUCKET0_US << (b))
+
+/**
+ * @brief I2C device statistics structure, transactions of a device address since registration 
+ * or the last reset.  A transaction is a transmit, receive or write-read of the device, its 
+ * latency is measured from the call, or submission when asynchronous, to completion.
+ */
+typedef struct {
+    uint16_t    device_address;                             /*!< device address of the statistics */
+    uint32_t    transactions;                               /*!< number of transactions, failed ones included */
+    uint32_t    bytes;                                      /*!< number of bytes written and read by acknowledged transactions */
+    uint32_t    nacks;                                      /*!< number of transactions not acknowledged or otherwise failed */
+    uint32_t    timeouts;                                   /*!< number of transactions timed out */
+    uint32_t    retries;                                    /*!< number of transactions retried after a failure */
+    uint32_t    latency_hist[I2C_STATS_LATENCY_BUCKETS];    /*!< transaction latency histogram, see `I2C_STATS_LATENCY_BUCKET_US` */
+    uint32_t    latency_max_us;                             /*!< maximum transaction latency in micro-seconds */
+    uint64_t    latency_sum_us;                             /*!< sum of transaction latencies in micro-seconds, for the mean latency */
+} i2c_master_stats_t;
+
+/**
+ * @brief I2C device health states enumerator.
+ */
+typedef enum {
+    I2C_DEVICE_HEALTH_OK = 0,   //!< last operation succeeded on its first attempt
+    I2C_DEVICE_HEALTH_DEGRADED, //!< last operation succeeded after a retry, or after a failed operation
+    I2C_DEVICE_HEALTH_FAILED    //!< last operation failed after every retry
+} i2c_device_health_states_t;
+
+/**
+ * @brief I2C recovery operation, an idempotent device operation run and retried by 
+ * `i2c_master_recovery_execute`, e.g. a complete measurement.
+ *
+ * @param op_ctx operation context
+ * @return esp_err_t ESP_OK on success.
+ */
+typedef esp_err_t (*i2c_master_recovery_operation_t)(void *op_ctx);
+
+/**
+ * @brief I2C recovery device re-initialization hook, restores a device to its configured 
+ * state after a bus reset, e.g. soft-reset and rewrite of its configuration registers.
+ *
+ * @param device_ctx device context, typically the driver device handle
+ * @return esp_err_t ESP_OK on success.
+ */
+typedef esp_err_t (*i2c_master_recovery_reinit_t)(void *device_ctx);
+
+/**
+ * @brief I2C recovery configuration structure.
+ */
+typedef struct {
+    uint8_t     retries;            /*!< retries of a failed operation, 0 to run it once */
+    uint32_t    backoff_ms;         /*!< delay before the first retry in milliseconds, doubles per retry */
+    uint32_t    backoff_max_ms;     /*!< maximum delay before a retry in milliseconds */
+} i2c_recovery_config_t;
+
+#define I2C_RECOVERY_CONFIG_DEFAULT {   \
+    .retries        = 3,                \
+    .backoff_ms     = 10,               \
+    .backoff_max_ms = 250 }
+
+/**
+ * @brief I2C device health structure.
+ */
+typedef struct {
+    i2c_device_health_states_t  state;          /*!< health state by the last operation */
+    esp_err_t                   last_error;     /*!< error of the last failed attempt, ESP_OK when none failed */
+    uint32_t                    failures;       /*!< consecutive operations failed after every retry */
+    uint32_t                    recoveries;     /*!< operations succeeded after a retry or a failed operation */
+    uint32_t                    bus_resets;     /*!< bus resets, SCL clock pulses that free a held SDA line */
+    uint32_t                    reinits;        /*!< device re-initializations */
+} i2c_device_health_t;
+
+/**
+ * @brief I2C recovery structure, the retry policy and health of a device.  A failed 
+ * operation is retried after an exponential backoff, the bus is reset when the 
+ * failure is a timeout, a held bus, or the operation failed again, and the device 
+ * is re-initialized after a bus reset.
+ */
+typedef struct {
+    i2c_recovery_config_t           config;         /*!< retry policy */
+    i2c_master_bus_handle_t         bus_handle;     /*!< bus handle of the device, reset to free the bus */
+    i2c_master_dev_handle_t         dev_handle;     /*!< device handle, retries are counted in its statistics, NULL before the device is added */
+    i2c_master_recovery_reinit_t    reinit;         /*!< device re-initialization hook, optional */
+    void                           *device_ctx;     /*!< device re-initialization hook context */
+    i2c_device_health_t             health;         /*!< device health */
+} i2c_recovery_t;
+
 /* 4-byte conversion to float IEEE754 */
 typedef union {
     uint8_t bytes[4];
@@ -280,6 +475,377 @@ esp_err_t i2c_master_bus_write_uint8(i2c_master_dev_handle_t handle, const uint8
  */
 esp_err_t i2c_master_bus_write_uint16(i2c_master_dev_handle_t handle, const uint8_t reg_addr, const uint16_t data);
 
+/**
+ * @brief I2C device transmit, `i2c_master_transmit` counted in the device statistics.  Drivers 
+ * use it for transactions that aren't register operations.
+ *
+ * @param[in] handle device handle
+ * @param[in] write_buffer data to write
+ * @param[in] write_size number of bytes to write
+ * @param[in] xfer_timeout_ms transaction timeout in milliseconds
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_master_bus_transmit(i2c_master_dev_handle_t handle, const uint8_t *write_buffer, const size_t write_size, const int xfer_timeout_ms);
+
+/**
+ * @brief I2C device receive, `i2c_master_receive` counted in the device statistics.
+ *
+ * @param[in] handle device handle
+ * @param[out] read_buffer data read from device
+ * @param[in] read_size number of bytes to read
+ * @param[in] xfer_timeout_ms transaction timeout in milliseconds
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_master_bus_receive(i2c_master_dev_handle_t handle, uint8_t *read_buffer, const size_t read_size, const int xfer_timeout_ms);
+
+/**
+ * @brief I2C device write-read, `i2c_master_transmit_receive` counted in the device statistics.
+ *
+ * @param[in] handle device handle
+ * @param[in] write_buffer data to write
+ * @param[in] write_size number of bytes to write
+ * @param[out] read_buffer data read from device
+ * @param[in] read_size number of bytes to read
+ * @param[in] xfer_timeout_ms transaction timeout in milliseconds
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_master_bus_transmit_receive(i2c_master_dev_handle_t handle, const uint8_t *write_buffer, const size_t write_size, uint8_t *read_buffer, const size_t read_size, const int xfer_timeout_ms);
+
+/**
+ * @brief Initializes an empty I2C batch of register operations for a device.
+ *
+ * @param[out] batch batch to initialize
+ * @param[in] handle device handle
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_master_batch_init(i2c_batch_t *const batch, i2c_master_dev_handle_t handle);
+
+/**
+ * @brief Queues a register read (1-byte register address) of `size` bytes into an I2C batch.  The data 
+ * is available once the batch is executed.
+ *
+ * @param[in,out] batch batch of register operations
+ * @param[in] reg_addr device register address (1-byte)
+ * @param[out] data data read from device, must remain valid until the batch is executed
+ * @param[in] size number of bytes to read
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM when the batch is full.
+ */
+esp_err_t i2c_master_batch_read(i2c_batch_t *const batch, const uint8_t reg_addr, uint8_t *const data, const uint8_t size);
+
+/**
+ * @brief Queues a register write (1-byte register address) of `size` bytes into an I2C batch.  The data 
+ * is copied into the batch.
+ *
+ * @param[in,out] batch batch of register operations
+ * @param[in] reg_addr device register address (1-byte)
+ * @param[in] data data to write, up to `I2C_BATCH_WRITE_MAX` bytes
+ * @param[in] size number of bytes to write
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM when the batch is full.
+ */
+esp_err_t i2c_master_batch_write(i2c_batch_t *const batch, const uint8_t reg_addr, const uint8_t *const data, const uint8_t size);
+
+/**
+ * @brief Queues a register write (1-byte register address) of `uint8_t` data into an I2C batch.
+ *
+ * @param[in,out] batch batch of register operations
+ * @param[in] reg_addr device register address (1-byte)
+ * @param[in] data data to write (1-byte)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM when the batch is full.
+ */
+esp_err_t i2c_master_batch_write_uint8(i2c_batch_t *const batch, const uint8_t reg_addr, const uint8_t data);
+
+/**
+ * @brief Runs the queued register operations of an I2C batch back-to-back, in queued order and 
+ * without delays between operations.  Execution stops at the first failed operation, the result 
+ * of each operation is set in the batch and operations not run keep ESP_ERR_INVALID_STATE.  Use 
+ * `i2c_master_batch_init` to reuse the batch.
+ *
+ * @param[in,out] batch batch of register operations
+ * @return esp_err_t ESP_OK when all operations succeed, otherwise the result of the first failed 
+ * operation or the first queueing error.
+ */
+esp_err_t i2c_master_batch_execute(i2c_batch_t *const batch);
+
+/**
+ * @brief Initializes an empty I2C register shadow of a device.
+ *
+ * @param[out] shadow register shadow to initialize
+ * @param[in] handle I2C device handle
+ * @param[in] verify read back and compare registers after they are written
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_master_shadow_init(i2c_shadow_t *const shadow, i2c_master_dev_handle_t handle, const bool verify);
+
+/**
+ * @brief Adds a register (1-byte register address) to an I2C register shadow.  The shadow value is 
+ * kept in `value`, refresh the shadow to load it from the device.
+ *
+ * @param[in,out] shadow register shadow
+ * @param[in] reg_addr device register address
+ * @param[in] value shadow value storage, must remain valid with the shadow
+ * @param[in] mask writable bits of the register
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM when `I2C_SHADOW_REGS_MAX` registers are shadowed.
+ */
+esp_err_t i2c_master_shadow_add(i2c_shadow_t *const shadow, const uint8_t reg_addr, uint8_t *const value, const uint8_t mask);
+
+/**
+ * @brief Reads all shadowed registers from the device back-to-back, dirty values are discarded.
+ *
+ * @param[in,out] shadow register shadow
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_master_shadow_refresh(i2c_shadow_t *const shadow);
+
+/**
+ * @brief Reads a shadowed register from the device, a dirty value is discarded.
+ *
+ * @param[in,out] shadow register shadow
+ * @param[in] reg_addr device register address
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when the register isn't shadowed.
+ */
+esp_err_t i2c_master_shadow_read(i2c_shadow_t *const shadow, const uint8_t reg_addr);
+
+/**
+ * @brief Updates the bits of `field_mask` of a shadowed register to `field_value` without an I2C 
+ * transaction.  The register is marked dirty when its shadow value changes.
+ *
+ * @param[in,out] shadow register shadow
+ * @param[in] reg_addr device register address
+ * @param[in] field_mask bits to update
+ * @param[in] field_value value of the updated bits, in register position
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when the register isn't shadowed.
+ */
+esp_err_t i2c_master_shadow_update(i2c_shadow_t *const shadow, const uint8_t reg_addr, const uint8_t field_mask, const uint8_t field_value);
+
+/**
+ * @brief Marks a shadowed register dirty, it is written by the next flush even if unchanged.
+ *
+ * @param[in,out] shadow register shadow
+ * @param[in] reg_addr device register address
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when the register isn't shadowed.
+ */
+esp_err_t i2c_master_shadow_mark_dirty(i2c_shadow_t *const shadow, const uint8_t reg_addr);
+
+/**
+ * @brief Writes the dirty shadowed registers back-to-back in the order they were added, one write 
+ * per register, and verifies them when enabled.  Nothing is written when no register is dirty.
+ *
+ * @param[in,out] shadow register shadow
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_RESPONSE when a verified register differs, 
+ * the shadow then holds the device value.
+ */
+esp_err_t i2c_master_shadow_flush(i2c_shadow_t *const shadow);
+
+/**
+ * @brief Writes a shadowed register through to the device, unconditionally, with the pending dirty 
+ * registers.  Use it for registers whose bits are changed by the device itself, e.g. a power mode 
+ * returning to sleep.
+ *
+ * @param[in,out] shadow register shadow
+ * @param[in] reg_addr device register address
+ * @param[in] value register value
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_RESPONSE when the verified register differs.
+ */
+esp_err_t i2c_master_shadow_write(i2c_shadow_t *const shadow, const uint8_t reg_addr, const uint8_t value);
+
+/**
+ * @brief Initializes asynchronous register operations of a device and registers its I2C transaction 
+ * done callback.  All transactions of a bus created with `trans_queue_depth` are asynchronous, devices 
+ * driven with the blocking `i2c_master_bus_*` functions need a bus of their own.  Operations are 
+ * submitted by the initializing task only.
+ *
+ * @param[out] async asynchronous device to initialize, must remain valid until `i2c_master_async_deinit`
+ * @param[in] handle I2C device handle on an asynchronous bus
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when the bus is not asynchronous.
+ */
+esp_err_t i2c_master_async_init(i2c_async_t *const async, i2c_master_dev_handle_t handle);
+
+/**
+ * @brief Submits a register read (1-byte register address) of `size` bytes.  The call returns once 
+ * the transaction is queued, the data is available when the operation completes.
+ *
+ * @param[in,out] async asynchronous device
+ * @param[in] reg_addr device register address to read from
+ * @param[out] data data read from device, must remain valid until the operation completes
+ * @param[in] size number of bytes to read
+ * @param[in] callback completion callback, runs in ISR context, NULL for notifications only
+ * @param[in] user_ctx completion callback user context
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM when `I2C_ASYNC_QUEUE_DEPTH` operations are in-flight.
+ */
+esp_err_t i2c_master_async_read(i2c_async_t *const async, const uint8_t reg_addr, uint8_t *const data, const uint8_t size, i2c_master_async_callback_t callback, void *user_ctx);
+
+/**
+ * @brief Submits a register write (1-byte register address) of `size` bytes.  The data is copied, 
+ * the call returns once the transaction is queued.
+ *
+ * @param[in,out] async asynchronous device
+ * @param[in] reg_addr device register address to write to
+ * @param[in] data data to write, up to `I2C_BATCH_WRITE_MAX` bytes
+ * @param[in] size number of bytes to write
+ * @param[in] callback completion callback, runs in ISR context, NULL for notifications only
+ * @param[in] user_ctx completion callback user context
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM when `I2C_ASYNC_QUEUE_DEPTH` operations are in-flight.
+ */
+esp_err_t i2c_master_async_write(i2c_async_t *const async, const uint8_t reg_addr, const uint8_t *const data, const uint8_t size, i2c_master_async_callback_t callback, void *user_ctx);
+
+/**
+ * @brief Waits for the in-flight register operations of a device to complete.  Uses the notifications 
+ * of the calling task, completions notify the task that waits.
+ *
+ * @param[in,out] async asynchronous device
+ * @param[in] timeout_ms maximum time to wait in milliseconds
+ * @return esp_err_t ESP_OK when all operations completed, ESP_ERR_TIMEOUT when operations are still 
+ * in-flight, or the first failed completion since the last wait.
+ */
+esp_err_t i2c_master_async_wait_all_done(i2c_async_t *const async, const uint32_t timeout_ms);
+
+/**
+ * @brief Unregisters the I2C transaction done callback of an asynchronous device.
+ *
+ * @param[in,out] async asynchronous device without in-flight operations
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when operations are in-flight.
+ */
+esp_err_t i2c_master_async_deinit(i2c_async_t *const async);
+
+/**
+ * @brief Registers a device for statistics, transactions of the device handle are counted under 
+ * its device address.  Registering an address again binds it to the new handle and keeps its 
+ * statistics, e.g. when a driver is initialized again.
+ *
+ * @param[in] handle device handle
+ * @param[in] device_address device address of the handle
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM when `I2C_STATS_DEVICES_MAX` addresses are registered.
+ */
+esp_err_t i2c_master_stats_register(i2c_master_dev_handle_t handle, const uint16_t device_address);
+
+/**
+ * @brief Unregisters a device handle from statistics, the statistics of its device address are 
+ * kept.  Drivers unregister before the device is removed from the bus.
+ *
+ * @param[in] handle device handle
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when the handle isn't registered.
+ */
+esp_err_t i2c_master_stats_unregister(i2c_master_dev_handle_t handle);
+
+/**
+ * @brief Gets a snapshot of the statistics of a device address.
+ *
+ * @param[in] device_address device address
+ * @param[out] stats device statistics
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when the address was never registered.
+ */
+esp_err_t i2c_master_stats_get(const uint16_t device_address, i2c_master_stats_t *const stats);
+
+/**
+ * @brief Gets a snapshot of the statistics of every registered device address.
+ *
+ * @param[out] stats device statistics, `I2C_STATS_DEVICES_MAX` entries
+ * @param[out] stats_size number of device statistics
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_master_stats_get_all(i2c_master_stats_t *const stats, uint8_t *const stats_size);
+
+/**
+ * @brief Gets a snapshot of the statistics of every registered device address and resets 
+ * them atomically, for periodic rollups that must not lose transactions between reads.
+ *
+ * @param[out] stats device statistics, `I2C_STATS_DEVICES_MAX` entries
+ * @param[out] stats_size number of device statistics
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_master_stats_get_all_and_reset(i2c_master_stats_t *const stats, uint8_t *const stats_size);
+
+/**
+ * @brief Resets the statistics of every registered device address, registrations are kept.
+ *
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_master_stats_reset(void);
+
+/**
+ * @brief Counts a retried transaction of a device, for drivers and helpers retrying failed 
+ * transactions.
+ *
+ * @param[in] handle device handle
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND when the handle isn't registered.
+ */
+esp_err_t i2c_master_stats_count_retry(i2c_master_dev_handle_t handle);
+
+/**
+ * @brief Initializes the recovery of a device on a bus with a retry policy, the device 
+ * is set once it is added, see `i2c_master_recovery_set_device`.
+ *
+ * @param[out] recovery recovery to initialize
+ * @param[in] config retry policy
+ * @param[in] bus_handle bus handle of the device
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_master_recovery_init(i2c_recovery_t *const recovery, const i2c_recovery_config_t *const config, i2c_master_bus_handle_t bus_handle);
+
+/**
+ * @brief Sets the device and re-initialization hook of a recovery.
+ *
+ * @param[in,out] recovery recovery
+ * @param[in] dev_handle device handle, retries are counted in its statistics
+ * @param[in] reinit device re-initialization hook, NULL when the device has no state to restore
+ * @param[in] device_ctx device re-initialization hook context
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_master_recovery_set_device(i2c_recovery_t *const recovery, i2c_master_dev_handle_t dev_handle, i2c_master_recovery_reinit_t reinit, void *device_ctx);
+
+/**
+ * @brief Runs an operation with the retry policy of a recovery and updates the device health.  
+ * An attempt failed with a bus or transfer error, ESP_FAIL (not acknowledged) or ESP_ERR_TIMEOUT, 
+ * is retried after `backoff_ms << retry` milliseconds, up to `backoff_max_ms`, any other error 
+ * fails the operation at once.  Before a retry the bus is reset when the attempt timed out or an 
+ * earlier retry failed, and the device is re-initialized after the bus reset.
+ *
+ * @param[in,out] recovery recovery
+ * @param[in] operation operation to run, it must be safe to run again after a failure
+ * @param[in] op_ctx operation context
+ * @return esp_err_t ESP_OK on success, otherwise the error of the last attempt.
+ */
+esp_err_t i2c_master_recovery_execute(i2c_recovery_t *const recovery, i2c_master_recovery_operation_t operation, void *op_ctx);
+
+/**
+ * @brief Completes an operation whose first attempt ran elsewhere, e.g. as steps of a scheduled 
+ * request, with the retry policy of a recovery and updates the device health.  The operation is 
+ * retried as by `i2c_master_recovery_execute` when the first attempt failed.
+ *
+ * @param[in,out] recovery recovery
+ * @param[in] result result of the first attempt
+ * @param[in] operation operation to retry, it must be safe to run again after a failure
+ * @param[in] op_ctx operation context
+ * @return esp_err_t ESP_OK on success, otherwise the error of the last attempt.
+ */
+esp_err_t i2c_master_recovery_retry(i2c_recovery_t *const recovery, const esp_err_t result, i2c_master_recovery_operation_t operation, void *op_ctx);
+
+/**
+ * @brief Resets the bus of a recovery, the SCL line is clocked to free a SDA line held by a 
+ * device, and re-initializes the device.
+ *
+ * @param[in,out] recovery recovery
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_master_recovery_reset(i2c_recovery_t *const recovery);
+
+/**
+ * @brief Gets the health of the device of a recovery.
+ *
+ * @param[in] recovery recovery
+ * @param[out] health device health
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_master_recovery_get_health(i2c_recovery_t *const recovery, i2c_device_health_t *const health);
+
+/**
+ * @brief Converts a device health state to a string.
+ *
+ * @param[in] state device health state
+ * @return const char* device health state name.
+ */
+const char *i2c_device_health_state_to_string(const i2c_device_health_states_t state);
+
 #ifdef __cplusplus
 }
 #endif
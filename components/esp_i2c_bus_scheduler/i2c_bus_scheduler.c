@@ -0,0 +1,244 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_bus_scheduler.c
+ *
+ * I2C bus scheduler library
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <stdlib.h>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <esp_rom_sys.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <i2c_bus_scheduler.h>
+
+/*
+ * macro definitions
+*/
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/*
+* static constant declerations
+*/
+static const char *TAG = "i2c_bus_scheduler";
+
+/**
+ * @brief delays the task until the due time, whole ticks are delayed and the remainder
+ * of a tick is busy-waited to start a device step at its due time.  a poll is delayed
+ * by whole ticks, rounded up, and the remainder isn't busy-waited.
+ *
+ * @param[in] due_us due time in micro-seconds.
+ * @param[in] poll due time of a poll step.
+ */
+static inline void i2c_bus_scheduler_delay_until(const int64_t due_us, const bool poll) {
+    const int64_t tick_us = (int64_t)portTICK_PERIOD_MS * 1000;
+    int64_t       delay_us = due_us - esp_timer_get_time();
+
+    /* a poll step runs on the tick it is due */
+    if(poll == true) {
+        if(delay_us > 0) {
+            vTaskDelay((TickType_t)((delay_us + tick_us - 1) / tick_us));
+        }
+        return;
+    }
+
+    /* a delay of n ticks may end early by up to a tick, the remainder is recomputed */
+    while(delay_us >= tick_us) {
+        vTaskDelay((TickType_t)(delay_us / tick_us));
+        delay_us = due_us - esp_timer_get_time();
+    }
+
+    if(delay_us > 0) {
+        esp_rom_delay_us((uint32_t)delay_us);
+    }
+}
+
+/**
+ * @brief gets the pending device with the earliest due time, ties run in add order.
+ *
+ * @param[in] scheduler_handle i2c bus scheduler handle.
+ * @return i2c_bus_scheduler_device_t* earliest due device, NULL when no request is pending.
+ */
+static inline i2c_bus_scheduler_device_t* i2c_bus_scheduler_get_next_device(i2c_bus_scheduler_handle_t scheduler_handle) {
+    i2c_bus_scheduler_device_t *next_device = NULL;
+
+    for(uint8_t i = 0; i < scheduler_handle->devices_size; i++) {
+        i2c_bus_scheduler_device_t *device = &scheduler_handle->devices[i];
+        if(device->pending == false) continue;
+        if(next_device == NULL || device->due_us < next_device->due_us) {
+            next_device = device;
+        }
+    }
+
+    return next_device;
+}
+
+esp_err_t i2c_bus_scheduler_init(i2c_bus_scheduler_handle_t *scheduler_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler_handle );
+
+    /* validate memory availability for i2c bus scheduler handle */
+    i2c_bus_scheduler_handle_t out_handle = (i2c_bus_scheduler_handle_t)calloc(1, sizeof(i2c_bus_scheduler_t));
+    ESP_RETURN_ON_FALSE( out_handle, ESP_ERR_NO_MEM, TAG, "no memory for i2c bus scheduler handle, i2c bus scheduler handle initialization failed" );
+
+    /* set output instance */
+    *scheduler_handle = out_handle;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bus_scheduler_add_device(i2c_bus_scheduler_handle_t scheduler_handle,
+                                    const i2c_bus_scheduler_device_config_t *device_config,
+                                    uint8_t *const device_index) {
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler_handle && device_config && device_config->step );
+
+    /* validate device capacity */
+    ESP_RETURN_ON_FALSE( scheduler_handle->devices_size < I2C_BUS_SCHEDULER_DEVICES_MAX, ESP_ERR_NO_MEM, TAG, "i2c bus scheduler is full, add device failed" );
+
+    /* copy configuration, the device has no request before the first cycle */
+    i2c_bus_scheduler_device_t *device = &scheduler_handle->devices[scheduler_handle->devices_size];
+    device->config  = *device_config;
+    device->pending = false;
+    device->last_us = INT64_MIN / 2;
+    device->result  = ESP_ERR_INVALID_STATE;
+
+    /* set output index */
+    if(device_index) *device_index = scheduler_handle->devices_size;
+
+    scheduler_handle->devices_size++;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bus_scheduler_run_cycle(i2c_bus_scheduler_handle_t scheduler_handle) {
+    i2c_bus_scheduler_device_t *device;
+    esp_err_t                   ret         = ESP_OK;
+    int64_t                     start_us    = 0;
+    int64_t                     end_us      = 0;
+    int64_t                     busy_us     = 0;
+    uint32_t                    steps       = 0;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler_handle );
+
+    /* queue a request of every device, due after the turnaround from its last step of the previous cycle */
+    const int64_t now_us = esp_timer_get_time();
+    for(uint8_t i = 0; i < scheduler_handle->devices_size; i++) {
+        device = &scheduler_handle->devices[i];
+        device->step    = 0;
+        device->pending = true;
+        device->poll    = false;
+        device->due_us  = device->last_us + device->config.turnaround_us;
+        if(device->due_us < now_us) device->due_us = now_us;
+    }
+
+    /* run the earliest due device step until every request is complete */
+    while((device = i2c_bus_scheduler_get_next_device(scheduler_handle)) != NULL) {
+        uint32_t  delay_us = I2C_BUS_SCHEDULER_STEP_DONE;
+
+        /* delay task until the device is due */
+        i2c_bus_scheduler_delay_until(device->due_us, device->poll);
+
+        /* run device step, the time spent in the step is time on the bus */
+        const int64_t step_start_us = esp_timer_get_time();
+        const esp_err_t result = device->config.step(device->config.device_ctx, device->step, &delay_us);
+        const int64_t step_end_us = esp_timer_get_time();
+
+        if(steps == 0) start_us = step_start_us;
+        end_us   = step_end_us;
+        busy_us += step_end_us - step_start_us;
+        steps++;
+
+        device->last_us = step_end_us;
+
+        /* complete the request on error or on the last step, otherwise schedule the next step */
+        if(result != ESP_OK || delay_us == I2C_BUS_SCHEDULER_STEP_DONE) {
+            device->pending = false;
+            device->result  = result;
+            if(result != ESP_OK) {
+                ESP_LOGW(TAG, "%s device step %" PRIu32 " failed (%s)", device->config.name ? device->config.name : "i2c", device->step, esp_err_to_name(result));
+                if(ret == ESP_OK) ret = result;
+            }
+        } else if(delay_us == I2C_BUS_SCHEDULER_STEP_POLL) {
+            /* poll the device again after the next tick, at least the turnaround time after the step */
+            const uint32_t tick_us = (uint32_t)portTICK_PERIOD_MS * 1000U;
+            device->step++;
+            device->poll   = true;
+            device->due_us = step_end_us + ((tick_us > device->config.turnaround_us) ? tick_us : device->config.turnaround_us);
+        } else {
+            device->step++;
+            device->poll   = false;
+            device->due_us = step_end_us + ((delay_us > device->config.turnaround_us) ? delay_us : device->config.turnaround_us);
+        }
+    }
+
+    /* set cycle statistics */
+    scheduler_handle->cycle_stats.steps       = steps;
+    scheduler_handle->cycle_stats.cycle_us    = (uint32_t)(end_us - start_us);
+    scheduler_handle->cycle_stats.busy_us     = (uint32_t)busy_us;
+    scheduler_handle->cycle_stats.idle_us     = (uint32_t)((end_us - start_us) - busy_us);
+    scheduler_handle->cycle_stats.utilization = (end_us > start_us) ? 100.0f * (float)busy_us / (float)(end_us - start_us) : 0.0f;
+
+    return ret;
+}
+
+esp_err_t i2c_bus_scheduler_get_device_result(i2c_bus_scheduler_handle_t scheduler_handle,
+                                    const uint8_t device_index,
+                                    esp_err_t *const result) {
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler_handle && result && device_index < scheduler_handle->devices_size );
+
+    /* set device result */
+    *result = scheduler_handle->devices[device_index].result;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bus_scheduler_get_cycle_stats(i2c_bus_scheduler_handle_t scheduler_handle,
+                                    i2c_bus_scheduler_cycle_stats_t *const cycle_stats) {
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler_handle && cycle_stats );
+
+    /* copy cycle statistics */
+    *cycle_stats = scheduler_handle->cycle_stats;
+
+    return ESP_OK;
+}
+
+esp_err_t i2c_bus_scheduler_del(i2c_bus_scheduler_handle_t scheduler_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( scheduler_handle );
+
+    free(scheduler_handle);
+
+    return ESP_OK;
+}
@@ -0,0 +1,193 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file i2c_bus_scheduler.h
+ *
+ * I2C bus scheduler library
+ *
+ * Interleaves the requests of several devices on an i2c master bus.  A device
+ * request is a sequence of steps, e.g. trigger a conversion then read the data,
+ * and every step reports how long the device needs before its next step.  The
+ * scheduler runs whichever device is due first and waits only for the earliest
+ * due device, every step of a device is at least the device's turnaround time
+ * after its previous step.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __I2C_BUS_SCHEDULER_H__
+#define __I2C_BUS_SCHEDULER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief I2C bus scheduler definitions.
+ */
+#define I2C_BUS_SCHEDULER_DEVICES_MAX   (8)             /*!< maximum number of devices per scheduler */
+#define I2C_BUS_SCHEDULER_STEP_DONE     UINT32_MAX      /*!< step delay of the last step of a device request */
+#define I2C_BUS_SCHEDULER_STEP_POLL     (UINT32_MAX - 1) /*!< step delay of a device that isn't ready, the step is run again after the next tick without busy-waiting */
+
+/**
+ * @brief I2C bus scheduler device step function.  Runs step `step` of the device
+ * request, the i2c transactions of the step, and sets the minimum time from the
+ * end of the step to the next step, e.g. the conversion time after a trigger,
+ * `I2C_BUS_SCHEDULER_STEP_POLL` to poll a device that isn't ready, or
+ * `I2C_BUS_SCHEDULER_STEP_DONE` when the request is complete.  The request ends
+ * when the step returns an error.
+ *
+ * @param device_ctx Device context of the device configuration.
+ * @param step Step number, 0 for the first step of a request.
+ * @param delay_us Minimum delay in micro-seconds before the next step, the device turnaround time applies when shorter.
+ * @return esp_err_t ESP_OK on success.
+ */
+typedef esp_err_t (*i2c_bus_scheduler_step_t)(void *device_ctx, const uint32_t step, uint32_t *const delay_us);
+
+/**
+ * @brief I2C bus scheduler device configuration structure.
+ */
+typedef struct i2c_bus_scheduler_device_config_tag {
+    const char*                 name;           /*!< device name for logging */
+    uint32_t                    turnaround_us;  /*!< minimum time from the end of a device step to the next step of the device in micro-seconds */
+    i2c_bus_scheduler_step_t    step;           /*!< device step function */
+    void*                       device_ctx;     /*!< device context passed to the step function */
+} i2c_bus_scheduler_device_config_t;
+
+/**
+ * @brief I2C bus scheduler device structure.
+ */
+typedef struct i2c_bus_scheduler_device_tag {
+    i2c_bus_scheduler_device_config_t   config;     /*!< device configuration */
+    uint32_t                            step;       /*!< next step of the pending request */
+    bool                                pending;    /*!< device request is pending in the cycle */
+    bool                                poll;       /*!< next step polls the device, the due time isn't busy-waited */
+    int64_t                             due_us;     /*!< earliest start time of the next step */
+    int64_t                             last_us;    /*!< end time of the last step, the turnaround is kept across cycles */
+    esp_err_t                           result;     /*!< result of the device request of the last cycle */
+} i2c_bus_scheduler_device_t;
+
+/**
+ * @brief I2C bus scheduler cycle statistics structure.  A cycle runs the requests
+ * of every device from the start of the first step to the end of the last step.
+ */
+typedef struct i2c_bus_scheduler_cycle_stats_tag {
+    uint32_t    steps;          /*!< number of device steps */
+    uint32_t    cycle_us;       /*!< cycle time in micro-seconds */
+    uint32_t    busy_us;        /*!< time spent in device steps, on the bus, in micro-seconds */
+    uint32_t    idle_us;        /*!< time waited for device turnaround and conversion times in micro-seconds */
+    float       utilization;    /*!< bus utilization, busy time over cycle time, in percent */
+} i2c_bus_scheduler_cycle_stats_t;
+
+/**
+ * @brief I2C bus scheduler structure.
+ */
+struct i2c_bus_scheduler_t {
+    i2c_bus_scheduler_device_t      devices[I2C_BUS_SCHEDULER_DEVICES_MAX]; /*!< devices in add order, ties of due devices run in add order */
+    uint8_t                         devices_size;                           /*!< number of devices */
+    i2c_bus_scheduler_cycle_stats_t cycle_stats;                            /*!< statistics of the last cycle */
+};
+
+/**
+ * @brief I2C bus scheduler type definition.
+ */
+typedef struct i2c_bus_scheduler_t i2c_bus_scheduler_t;
+
+/**
+ * @brief I2C bus scheduler handle definition.
+ */
+typedef struct i2c_bus_scheduler_t *i2c_bus_scheduler_handle_t;
+
+/**
+ * @brief Initializes an i2c bus scheduler handle without devices.
+ *
+ * @param[out] scheduler_handle I2C bus scheduler handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_bus_scheduler_init(i2c_bus_scheduler_handle_t *scheduler_handle);
+
+/**
+ * @brief Adds a device to an i2c bus scheduler.
+ *
+ * @param[in] scheduler_handle I2C bus scheduler handle.
+ * @param[in] device_config Device configuration.
+ * @param[out] device_index Index of the device, NULL when not required.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM when `I2C_BUS_SCHEDULER_DEVICES_MAX` devices are added.
+ */
+esp_err_t i2c_bus_scheduler_add_device(i2c_bus_scheduler_handle_t scheduler_handle,
+                                    const i2c_bus_scheduler_device_config_t *device_config,
+                                    uint8_t *const device_index);
+
+/**
+ * @brief Runs a cycle, a request of every device, to completion.  The device
+ * steps are interleaved by due time and the task is delayed only until the
+ * earliest due device, whole ticks are delayed and the remainder is busy-waited.
+ * A poll step is delayed by whole ticks only, the remainder isn't busy-waited.
+ * A failed device request doesn't stop the requests of the other devices.
+ *
+ * @param[in] scheduler_handle I2C bus scheduler handle.
+ * @return esp_err_t ESP_OK on success, otherwise the first failed device result.
+ */
+esp_err_t i2c_bus_scheduler_run_cycle(i2c_bus_scheduler_handle_t scheduler_handle);
+
+/**
+ * @brief Gets the result of a device request of the last cycle.
+ *
+ * @param[in] scheduler_handle I2C bus scheduler handle.
+ * @param[in] device_index Index of the device.
+ * @param[out] result Result of the device request, ESP_ERR_INVALID_STATE before the first cycle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_bus_scheduler_get_device_result(i2c_bus_scheduler_handle_t scheduler_handle,
+                                    const uint8_t device_index,
+                                    esp_err_t *const result);
+
+/**
+ * @brief Gets the statistics, including the bus utilization, of the last cycle.
+ *
+ * @param[in] scheduler_handle I2C bus scheduler handle.
+ * @param[out] cycle_stats Cycle statistics.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_bus_scheduler_get_cycle_stats(i2c_bus_scheduler_handle_t scheduler_handle,
+                                    i2c_bus_scheduler_cycle_stats_t *const cycle_stats);
+
+/**
+ * @brief Frees an i2c bus scheduler handle, the devices aren't removed from the bus.
+ *
+ * @param[in] scheduler_handle I2C bus scheduler handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_bus_scheduler_del(i2c_bus_scheduler_handle_t scheduler_handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __I2C_BUS_SCHEDULER_H__
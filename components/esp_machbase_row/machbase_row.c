@@ -0,0 +1,169 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file machbase_row.c
+ *
+ * MACHBASE row serializer libary
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_types.h>
+
+#include <math.h>
+#include <string.h>
+
+#include <machbase_row.h>
+
+/*
+ * macro definitions
+*/
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/*
+* static constant declerations
+*/
+static const char *TAG = "machbase_row";
+
+/* decimal digit pairs "00" to "99" */
+static const char s_digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/* scale of the serialized decimals, 10^MACHBASE_ROW_VALUE_DECIMALS */
+static const double s_value_scale = 1e6;
+
+/* magnitude limit of the fixed-point value format, larger values are formatted in exponent notation */
+static const double s_value_limit = 1e12;
+
+size_t machbase_row_format_uint64(uint64_t value, char *const buffer) {
+    char   digits[MACHBASE_ROW_VALUE_SIZE_MAX];
+    size_t index = sizeof(digits);
+
+    /* write digit pairs from the least significant digits */
+    while(value >= 100) {
+        const uint32_t pair = (uint32_t)(value % 100) * 2;
+        value /= 100;
+        digits[--index] = s_digit_pairs[pair + 1];
+        digits[--index] = s_digit_pairs[pair];
+    }
+    if(value >= 10) {
+        const uint32_t pair = (uint32_t)value * 2;
+        digits[--index] = s_digit_pairs[pair + 1];
+        digits[--index] = s_digit_pairs[pair];
+    } else {
+        digits[--index] = (char)('0' + value);
+    }
+
+    const size_t len = sizeof(digits) - index;
+    memcpy(buffer, digits + index, len);
+    return len;
+}
+
+size_t machbase_row_format_float(const float value, char *const buffer) {
+    /* json has no representation of nan or infinity */
+    if(!isfinite(value)) {
+        memcpy(buffer, "null", 4);
+        return 4;
+    }
+
+    double magnitude = fabs((double)value);
+
+    /* out of range of the fixed-point format, not expected of environmental samples */
+    if(magnitude >= s_value_limit) {
+        return (size_t)snprintf(buffer, MACHBASE_ROW_VALUE_SIZE_MAX, "%.*e", MACHBASE_ROW_VALUE_DECIMALS - 1, value);
+    }
+
+    /* scale to a fixed-point integer, rounded to the nearest decimal with ties to even as `%f` */
+    uint64_t scaled   = (uint64_t)llrint(magnitude * s_value_scale);
+    uint64_t integer  = scaled / (uint64_t)s_value_scale;
+    uint32_t fraction = (uint32_t)(scaled % (uint64_t)s_value_scale);
+    size_t   len      = 0;
+
+    if(signbit(value)) buffer[len++] = '-';
+
+    len += machbase_row_format_uint64(integer, buffer + len);
+    buffer[len++] = '.';
+
+    /* write zero-padded fraction digits from the least significant digit */
+    for(int8_t i = MACHBASE_ROW_VALUE_DECIMALS - 1; i >= 0; i--) {
+        buffer[len + i] = (char)('0' + (fraction % 10));
+        fraction /= 10;
+    }
+    len += MACHBASE_ROW_VALUE_DECIMALS;
+
+    return len;
+}
+
+esp_err_t machbase_row_template_init(const char *device_id, 
+                                    const char *parameter, 
+                                    machbase_row_template_t *const row_template) {
+    /* validate arguments */
+    ESP_ARG_CHECK( device_id && parameter && row_template );
+
+    /* attempt to construct row head and tail */
+    int head_len = snprintf(row_template->head, sizeof(row_template->head), "[\"%s.%s\",", device_id, parameter);
+    int tail_len = snprintf(row_template->tail, sizeof(row_template->tail), ",\"%s\",\"%s\"]", parameter, device_id);
+    ESP_RETURN_ON_FALSE( head_len > 0 && head_len < (int)sizeof(row_template->head), ESP_ERR_INVALID_SIZE, TAG, "device identifier and parameter exceed row head size, row template initialization failed" );
+    ESP_RETURN_ON_FALSE( tail_len > 0 && tail_len < (int)sizeof(row_template->tail), ESP_ERR_INVALID_SIZE, TAG, "device identifier and parameter exceed row tail size, row template initialization failed" );
+
+    row_template->head_len = (uint8_t)head_len;
+    row_template->tail_len = (uint8_t)tail_len;
+
+    return ESP_OK;
+}
+
+size_t machbase_row_size_max(const machbase_row_template_t *const row_template) {
+    /* head, timestamp, separator, value and tail */
+    return row_template->head_len + MACHBASE_ROW_VALUE_SIZE_MAX + 1 + MACHBASE_ROW_VALUE_SIZE_MAX + row_template->tail_len;
+}
+
+size_t machbase_row_serialize(const machbase_row_template_t *const row_template, 
+                            const uint64_t timestamp, 
+                            const float value, 
+                            char *const buffer, 
+                            const size_t buffer_size) {
+    /* validate buffer size against the longest row */
+    if(buffer_size < machbase_row_size_max(row_template)) return 0;
+
+    size_t len = 0;
+
+    memcpy(buffer, row_template->head, row_template->head_len);
+    len += row_template->head_len;
+
+    len += machbase_row_format_uint64(timestamp, buffer + len);
+    buffer[len++] = ',';
+    len += machbase_row_format_float(value, buffer + len);
+
+    memcpy(buffer + len, row_template->tail, row_template->tail_len);
+    len += row_template->tail_len;
+
+    return len;
+}
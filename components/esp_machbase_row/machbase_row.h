@@ -0,0 +1,129 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file machbase_row.h
+ *
+ * MACHBASE row serializer libary
+ * 
+ * Serializes environmental samples as MACHBASE append rows, e.g. 
+ * `["<device>.<parameter>",<timestamp>,<value>,"<parameter>","<device>"]`, without 
+ * heap allocation or `printf` formatting.  The constant head and tail of a row are 
+ * precomputed once per device and parameter into a row template.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __MACHBASE_ROW_H__
+#define __MACHBASE_ROW_H__
+
+#include <stdio.h>
+#include <esp_check.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief MACHBASE row definitions.
+ */
+#define MACHBASE_ROW_HEAD_SIZE          (64)    /*!< row template head buffer size, `["<device>.<parameter>",` */
+#define MACHBASE_ROW_TAIL_SIZE          (64)    /*!< row template tail buffer size, `,"<parameter>","<device>"]` */
+#define MACHBASE_ROW_VALUE_DECIMALS     (6)     /*!< number of decimals of a serialized value, same as `%f` */
+#define MACHBASE_ROW_VALUE_SIZE_MAX     (20)    /*!< maximum length of a serialized timestamp or value */
+
+/**
+ * @brief MACHBASE row template structure.  The constant parts of a row 
+ * for a device and parameter.
+ */
+typedef struct machbase_row_template_tag {
+    char        head[MACHBASE_ROW_HEAD_SIZE];   /*!< row head, `["<device>.<parameter>",` */
+    uint8_t     head_len;                       /*!< row head length in bytes */
+    char        tail[MACHBASE_ROW_TAIL_SIZE];   /*!< row tail, `,"<parameter>","<device>"]` */
+    uint8_t     tail_len;                       /*!< row tail length in bytes */
+} machbase_row_template_t;
+
+/**
+ * @brief Initializes a row template by device identifier and parameter name.
+ * 
+ * @param device_id Unique device identifier.
+ * @param parameter Parameter name.
+ * @param row_template Row template to initialize.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_SIZE when the device identifier and 
+ * parameter name do not fit the template buffers.
+ */
+esp_err_t machbase_row_template_init(const char *device_id, 
+                                    const char *parameter, 
+                                    machbase_row_template_t *const row_template);
+
+/**
+ * @brief Gets the maximum length of a row serialized with a row template.
+ * 
+ * @param row_template Row template.
+ * @return size_t Maximum row length in bytes.
+ */
+size_t machbase_row_size_max(const machbase_row_template_t *const row_template);
+
+/**
+ * @brief Serializes a row into a buffer.  The buffer is not null terminated.  A 
+ * non-finite value is serialized as `null`.
+ * 
+ * @param row_template Row template.
+ * @param timestamp Sample time-stamp in nano-seconds.
+ * @param value Sample value.
+ * @param buffer Buffer to serialize the row into.
+ * @param buffer_size Buffer size in bytes.
+ * @return size_t Row length in bytes, 0 when the row does not fit the buffer.
+ */
+size_t machbase_row_serialize(const machbase_row_template_t *const row_template, 
+                            const uint64_t timestamp, 
+                            const float value, 
+                            char *const buffer, 
+                            const size_t buffer_size);
+
+/**
+ * @brief Formats an unsigned integer as decimal digits.  The buffer is not null terminated.
+ * 
+ * @param value Unsigned integer value.
+ * @param buffer Buffer of at least `MACHBASE_ROW_VALUE_SIZE_MAX` bytes.
+ * @return size_t Number of characters written.
+ */
+size_t machbase_row_format_uint64(uint64_t value, char *const buffer);
+
+/**
+ * @brief Formats a float with `MACHBASE_ROW_VALUE_DECIMALS` decimals, or `null` when 
+ * the value is not finite.  The buffer is not null terminated.
+ * 
+ * @param value Float value.
+ * @param buffer Buffer of at least `MACHBASE_ROW_VALUE_SIZE_MAX` bytes.
+ * @return size_t Number of characters written.
+ */
+size_t machbase_row_format_float(const float value, char *const buffer);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MACHBASE_ROW_H__
@@ -68,23 +68,144 @@ const char* pressure_tendency_code_to_string(const pressure_tendency_codes_t cod
     }
 }
 
-esp_err_t pressure_tendency_init(const uint16_t samples_size, 
+/**
+ * @brief Allocates a pressure tendency history buffer.
+ * 
+ * @param history Pressure tendency history.
+ * @param bucket_span Number of samples averaged per bucket.
+ * @param buckets_size Number of buckets retained.
+ * @return esp_err_t ESP_OK on success.
+ */
+static inline esp_err_t pressure_tendency_history_init(pressure_tendency_history_t *const history, const uint16_t bucket_span, const uint16_t buckets_size) {
+    history->buckets = (float*)calloc(buckets_size, sizeof(float));
+    ESP_RETURN_ON_FALSE( history->buckets, ESP_ERR_NO_MEM, TAG, "no memory for pressure tendency history buckets, pressure tendency history initialization failed" );
+
+    history->bucket_span  = bucket_span;
+    history->buckets_size = buckets_size;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Accumulates a sample into the history bucket accumulator and closes the bucket 
+ * once it spans `bucket_span` samples.  NaN samples are excluded from the average, a 
+ * bucket without finite samples is NaN.
+ * 
+ * @param history Pressure tendency history.
+ * @param samples_count Samples count including the sample.
+ * @param sample Air pressure sample.
+ */
+static inline void pressure_tendency_history_push(pressure_tendency_history_t *const history, const uint32_t samples_count, const float sample) {
+    if (!isnan(sample)) {
+        history->accum_sum += sample;
+        history->accum_count++;
+    }
+
+    /* is the bucket complete? */
+    if (samples_count % history->bucket_span != 0) return;
+
+    uint32_t bucket = (samples_count / history->bucket_span) - 1;
+
+    history->buckets[bucket % history->buckets_size] = (history->accum_count == 0) ? NAN : (float)(history->accum_sum / history->accum_count);
+    history->accum_sum   = 0.0;
+    history->accum_count = 0;
+}
+
+/**
+ * @brief Gets the bucket centre position, in samples, of a history bucket.
+ * 
+ * @param history Pressure tendency history.
+ * @param bucket Bucket number.
+ * @return double Bucket centre position in samples.
+ */
+static inline double pressure_tendency_history_centre(const pressure_tendency_history_t *const history, const uint32_t bucket) {
+    return (double)bucket * history->bucket_span + (history->bucket_span - 1) / 2.0;
+}
+
+/**
+ * @brief Gets the sample value at a sample position from a history buffer.
+ * 
+ * @param history Pressure tendency history.
+ * @param samples_count Samples count.
+ * @param position Sample position, 0 is the first sample since initialization or reset.
+ * @param value Sample value at the position.
+ * @return true when the position is covered by the history buffer.
+ */
+static inline bool pressure_tendency_history_value(const pressure_tendency_history_t *const history, const uint32_t samples_count, const double position, float *const value) {
+    uint32_t buckets = samples_count / history->bucket_span;
+
+    /* any complete buckets yet? */
+    if (buckets == 0) return false;
+
+    uint32_t oldest = (buckets > history->buckets_size) ? buckets - history->buckets_size : 0;
+    uint32_t newest = buckets - 1;
+
+    /* is the position between the retained bucket centres?  a position preceding the 
+    oldest bucket centre is left to a coarser history unless no bucket was dropped yet */
+    if (position > pressure_tendency_history_centre(history, newest)) return false;
+    if (position < pressure_tendency_history_centre(history, oldest) && oldest > 0) return false;
+
+    /* a single bucket represents its whole span */
+    if (oldest == newest) {
+        *value = history->buckets[oldest % history->buckets_size];
+        return true;
+    }
+
+    /* linear interpolation between adjacent bucket centres, positions preceding the
+    first bucket centre are extrapolated from the first two buckets */
+    uint32_t bucket = (position <= pressure_tendency_history_centre(history, oldest)) ? oldest :
+        (uint32_t)((position - (history->bucket_span - 1) / 2.0) / history->bucket_span);
+    if (bucket >= newest) {
+        *value = history->buckets[newest % history->buckets_size];
+        return true;
+    }
+
+    float  lower    = history->buckets[bucket % history->buckets_size];
+    float  upper    = history->buckets[(bucket + 1) % history->buckets_size];
+    double fraction = (position - pressure_tendency_history_centre(history, bucket)) / history->bucket_span;
+
+    *value = (float)(lower + (upper - lower) * fraction);
+
+    return true;
+}
+
+/**
+ * @brief Frees a pressure tendency history buffer.
+ * 
+ * @param history Pressure tendency history.
+ */
+static inline void pressure_tendency_history_del(pressure_tendency_history_t *const history) {
+    if(history->buckets) 
+        free(history->buckets);
+    history->buckets = NULL;
+}
+
+esp_err_t pressure_tendency_init(const pressure_tendency_config_t *pressure_tendency_config, 
                             pressure_tendency_handle_t *pressure_tendency_handle) {
     esp_err_t  ret = ESP_OK;
 
     /* validate arguments */
-    ESP_GOTO_ON_FALSE( samples_size > 2, ESP_ERR_INVALID_ARG, err, TAG, "samples size must be greater than 2, pressure tendency handle initialization failed" );
+    ESP_GOTO_ON_FALSE( pressure_tendency_config, ESP_ERR_INVALID_ARG, err, TAG, "configuration is null, pressure tendency handle initialization failed" );
+    ESP_GOTO_ON_FALSE( pressure_tendency_config->sampling_period > 0 && (60 % pressure_tendency_config->sampling_period) == 0, ESP_ERR_INVALID_ARG, err, TAG, "sampling period must be a divisor of 60-seconds, pressure tendency handle initialization failed" );
+    ESP_GOTO_ON_FALSE( pressure_tendency_config->history_period >= PRESSURE_TENDENCY_PERIOD_MIN, ESP_ERR_INVALID_ARG, err, TAG, "history period must be at least 3-hrs, pressure tendency handle initialization failed" );
 
     /* validate memory availability for pressure tendency handle */
     pressure_tendency_handle_t out_handle = (pressure_tendency_handle_t)calloc(1, sizeof(pressure_tendency_t)); 
     ESP_GOTO_ON_FALSE( out_handle, ESP_ERR_NO_MEM, err, TAG, "no memory for pressure tendency handle, pressure tendency handle initialization failed" );
 
-    /* validate memory availability for sampples array */
-    out_handle->samples = (float*)calloc(samples_size, sizeof(float));
-    ESP_GOTO_ON_FALSE( out_handle->samples, ESP_ERR_NO_MEM, err_out_handle, TAG, "no memory for pressure tendency handle samples, pressure tendency handle initialization failed" );
+    /* size history buffers, the averaged histories retain two extra buckets to interpolate at the edge of their period */
+    const uint16_t samples_per_min = 60 / pressure_tendency_config->sampling_period;
+    const uint16_t min_buckets     = PRESSURE_TENDENCY_MIN_PERIOD_MIN + 2;
+    const uint16_t ten_buckets     = ((pressure_tendency_config->history_period + PRESSURE_TENDENCY_TEN_BUCKET_MIN - 1) / PRESSURE_TENDENCY_TEN_BUCKET_MIN) + 2;
+
+    /* validate memory availability for history buffers */
+    ESP_GOTO_ON_ERROR( pressure_tendency_history_init(&out_handle->raw_history, 1, PRESSURE_TENDENCY_RAW_PERIOD_MIN * samples_per_min), err_out_handle, TAG, "no memory for pressure tendency full-rate history, pressure tendency handle initialization failed" );
+    ESP_GOTO_ON_ERROR( pressure_tendency_history_init(&out_handle->min_history, samples_per_min, min_buckets), err_out_handle, TAG, "no memory for pressure tendency 1-minute history, pressure tendency handle initialization failed" );
+    ESP_GOTO_ON_ERROR( pressure_tendency_history_init(&out_handle->ten_history, PRESSURE_TENDENCY_TEN_BUCKET_MIN * samples_per_min, ten_buckets), err_out_handle, TAG, "no memory for pressure tendency 10-minute history, pressure tendency handle initialization failed" );
 
     /* copy configuration */
-    out_handle->samples_size = samples_size;
+    out_handle->sampling_period = pressure_tendency_config->sampling_period;
+    out_handle->history_period  = pressure_tendency_config->history_period;
 
     /* set output instance */
     *pressure_tendency_handle = out_handle;
@@ -92,11 +213,51 @@ esp_err_t pressure_tendency_init(const uint16_t samples_size,
     return ESP_OK;
 
     err_out_handle:
+        pressure_tendency_history_del(&out_handle->raw_history);
+        pressure_tendency_history_del(&out_handle->min_history);
+        pressure_tendency_history_del(&out_handle->ten_history);
         free(out_handle);
     err:
         return ret;
 }
 
+esp_err_t pressure_tendency_get_change(pressure_tendency_handle_t pressure_tendency_handle, 
+                                const uint16_t lookback_period, 
+                                float *const change) {
+    float latest    = NAN;
+    float reference = NAN;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( pressure_tendency_handle && change );
+    ESP_RETURN_ON_FALSE( lookback_period > 0 && lookback_period <= pressure_tendency_handle->history_period, ESP_ERR_INVALID_ARG, TAG, "lookback period exceeds history period, pressure tendency get change failed" );
+
+    uint32_t lookback_samples = ((uint32_t)lookback_period * 60U) / pressure_tendency_handle->sampling_period;
+
+    /* do we have a sample from the lookback period ago? */
+    if (pressure_tendency_handle->samples_count <= lookback_samples) {
+        *change = NAN;
+        return ESP_OK;
+    }
+
+    /* latest sample position and the reference sample position lookback samples before it */
+    uint32_t latest_position    = pressure_tendency_handle->samples_count - 1;
+    double   reference_position = latest_position - lookback_samples;
+
+    pressure_tendency_history_value(&pressure_tendency_handle->raw_history, pressure_tendency_handle->samples_count, latest_position, &latest);
+
+    /* finest history that covers the reference position */
+    if (!pressure_tendency_history_value(&pressure_tendency_handle->raw_history, pressure_tendency_handle->samples_count, reference_position, &reference) &&
+        !pressure_tendency_history_value(&pressure_tendency_handle->min_history, pressure_tendency_handle->samples_count, reference_position, &reference) &&
+        !pressure_tendency_history_value(&pressure_tendency_handle->ten_history, pressure_tendency_handle->samples_count, reference_position, &reference)) {
+        *change = NAN;
+        return ESP_OK;
+    }
+
+    *change = latest - reference;
+
+    return ESP_OK;
+}
+
 esp_err_t pressure_tendency_analysis(pressure_tendency_handle_t pressure_tendency_handle, 
                                     const float sample, 
                                     pressure_tendency_codes_t *const code,
@@ -104,25 +265,20 @@ esp_err_t pressure_tendency_analysis(pressure_tendency_handle_t pressure_tendenc
     /* validate arguments */
     ESP_ARG_CHECK(pressure_tendency_handle);
 
-    // have we filled the array?
-    if (pressure_tendency_handle->samples_count < pressure_tendency_handle->samples_size) {
-        // no! add this observation to the array
-        pressure_tendency_handle->samples[pressure_tendency_handle->samples_count] = sample;
+    // bump n
+    pressure_tendency_handle->samples_count++;
 
-        // bump n
-        pressure_tendency_handle->samples_count++;
-    } else {
-        // yes! the array is full so we have to make space
-        for (uint16_t i = 1; i < pressure_tendency_handle->samples_size; i++) {
-            pressure_tendency_handle->samples[i-1] = pressure_tendency_handle->samples[i];
-        }
+    /* push sample onto the full-rate, 1-minute and 10-minute histories */
+    pressure_tendency_history_push(&pressure_tendency_handle->raw_history, pressure_tendency_handle->samples_count, sample);
+    pressure_tendency_history_push(&pressure_tendency_handle->min_history, pressure_tendency_handle->samples_count, sample);
+    pressure_tendency_history_push(&pressure_tendency_handle->ten_history, pressure_tendency_handle->samples_count, sample);
 
-        // now we can fill in the last slot
-        pressure_tendency_handle->samples[pressure_tendency_handle->samples_size-1] = sample;
-    }
+    /* subtract pressure from 3-hrs ago from latest pressure */
+    float delta;
+    ESP_RETURN_ON_ERROR( pressure_tendency_get_change(pressure_tendency_handle, PRESSURE_TENDENCY_PERIOD_MIN, &delta), TAG, "get 3-hr change for analysis failed" );
 
-    // is the array full yet?
-    if (pressure_tendency_handle->samples_count < pressure_tendency_handle->samples_size) {
+    // do we have 3-hrs of samples yet?
+    if (isnan(delta)) {
         // no! we are still training
         *code = PRESSURE_TENDENCY_CODE_UNKNOWN;
         *change = NAN;
@@ -130,9 +286,6 @@ esp_err_t pressure_tendency_analysis(pressure_tendency_handle_t pressure_tendenc
         return ESP_OK;
     }
 
-    /* subtract pressure from 3-hrs ago from latest pressure */
-    float delta = pressure_tendency_handle->samples[pressure_tendency_handle->samples_size-1] - pressure_tendency_handle->samples[0];
-
     /* evaluate delta aka 3-hr change in pressure */
     /* if the absolute variance is less than 1 hPa, air pressure is steady */
     /* if the delta is negative, and absolute variance is greater than 1 hPa, air pressure is falling */
@@ -164,9 +317,17 @@ esp_err_t pressure_tendency_reset(pressure_tendency_handle_t pressure_tendency_h
     /* validate arguments */
     ESP_ARG_CHECK(pressure_tendency_handle);
 
-    /* purge samples */
-    for(uint16_t i = 0; i < pressure_tendency_handle->samples_size; i++) {
-        pressure_tendency_handle->samples[i] = NAN;
+    pressure_tendency_history_t *histories[] = { &pressure_tendency_handle->raw_history, 
+                                                 &pressure_tendency_handle->min_history, 
+                                                 &pressure_tendency_handle->ten_history };
+
+    /* purge history buffers and accumulators */
+    for(uint8_t h = 0; h < 3; h++) {
+        for(uint16_t i = 0; i < histories[h]->buckets_size; i++) {
+            histories[h]->buckets[i] = NAN;
+        }
+        histories[h]->accum_sum   = 0.0;
+        histories[h]->accum_count = 0;
     }
 
     /* reset samples counter */
@@ -178,8 +339,9 @@ esp_err_t pressure_tendency_reset(pressure_tendency_handle_t pressure_tendency_h
 esp_err_t pressure_tendency_del(pressure_tendency_handle_t pressure_tendency_handle) {
     /* validate arguments */
     ESP_ARG_CHECK(pressure_tendency_handle);
-    if(pressure_tendency_handle->samples) 
-        free(pressure_tendency_handle->samples);
+    pressure_tendency_history_del(&pressure_tendency_handle->raw_history);
+    pressure_tendency_history_del(&pressure_tendency_handle->min_history);
+    pressure_tendency_history_del(&pressure_tendency_handle->ten_history);
     free(pressure_tendency_handle);
     return ESP_OK;
 }
\ No newline at end of file
@@ -54,12 +54,46 @@ typedef enum pressure_tendency_codes_tag { /*!< 3-hr Change */
 } pressure_tendency_codes_t;
 
 /**
- * @brief Pressure tendency structure.
+ * @brief Pressure tendency definitions.
+ */
+#define PRESSURE_TENDENCY_PERIOD_MIN        UINT16_C(180)   /*!< pressure tendency period, 3-hrs, in minutes */
+#define PRESSURE_TENDENCY_RAW_PERIOD_MIN    UINT16_C(5)     /*!< pressure tendency full-rate history period in minutes */
+#define PRESSURE_TENDENCY_MIN_PERIOD_MIN    UINT16_C(60)    /*!< pressure tendency 1-minute averages history period in minutes */
+#define PRESSURE_TENDENCY_TEN_BUCKET_MIN    UINT16_C(10)    /*!< pressure tendency coarse history bucket span in minutes */
+
+/**
+ * @brief Pressure tendency configuration structure.
+ */
+typedef struct pressure_tendency_config_tag {
+    uint16_t    sampling_period;    /*!< pressure tendency sampling period in seconds, must be a divisor of 60-seconds */
+    uint16_t    history_period;     /*!< pressure tendency history period in minutes, the maximum lookback of `pressure_tendency_get_change`, must be at least `PRESSURE_TENDENCY_PERIOD_MIN` */
+} pressure_tendency_config_t;
+
+/**
+ * @brief Pressure tendency history structure.  A circular buffer of bucket averages 
+ * where bucket `b` averages samples `[b * bucket_span, (b + 1) * bucket_span)` and 
+ * is stored at index `b % buckets_size`.
+ */
+typedef struct pressure_tendency_history_tag {
+    uint16_t    bucket_span;        /*!< number of samples averaged per bucket */
+    uint16_t    buckets_size;       /*!< number of buckets retained */
+    uint16_t    accum_count;        /*!< number of finite samples in the bucket accumulator */
+    double      accum_sum;          /*!< bucket accumulator sum of finite samples */
+    float*      buckets;            /*!< bucket averages circular buffer */
+} pressure_tendency_history_t;
+
+/**
+ * @brief Pressure tendency structure.  Samples are kept as a multi-resolution history:
+ * full-rate samples for the last few minutes, 1-minute averages for the last hour, 
+ * and 10-minute averages for the configured history period.
  */
 struct pressure_tendency_t {
-    uint16_t    samples_count; /*!< pressure tendency samples count, state machine variable */
-    uint16_t    samples_size;  /*!< pressure tendency samples size, state machine variable */
-    float*      samples;       /*!< pressure tendency samples array, state machine variable */
+    uint16_t                        sampling_period;    /*!< pressure tendency sampling period in seconds, state machine variable */
+    uint16_t                        history_period;     /*!< pressure tendency history period in minutes, state machine variable */
+    uint32_t                        samples_count;      /*!< pressure tendency samples count since initialization or reset, state machine variable */
+    pressure_tendency_history_t     raw_history;        /*!< pressure tendency full-rate samples history, state machine variable */
+    pressure_tendency_history_t     min_history;        /*!< pressure tendency 1-minute averages history, state machine variable */
+    pressure_tendency_history_t     ten_history;        /*!< pressure tendency 10-minute averages history, state machine variable */
 };
 
 /**
@@ -81,16 +115,17 @@ typedef struct pressure_tendency_t *pressure_tendency_handle_t;
 const char* pressure_tendency_code_to_string(const pressure_tendency_codes_t code);
 
 /**
- * @brief Initializes a pressure tendency handle by size of the 3-hr samples 
- * to analyze.  The size of the samples is calculated from the sampling rate.  
- * As an example, if the sampling rate is once every minute, the 
- * size of the samples buffer should be 180 e.g., three (3) hours.
+ * @brief Initializes a pressure tendency handle by sampling period and history 
+ * period.  The history buffers are sized from the sampling period and history 
+ * period.  As an example, if the sampling period is every 6-seconds and the history 
+ * period is 180 minutes, the handle retains 50 full-rate samples, 62 1-minute 
+ * averages and 20 10-minute averages instead of 1,801 samples.
  * 
- * @param samples_size Pressure tendency samples buffer size. 
+ * @param pressure_tendency_config Pressure tendency configuration.
  * @param pressure_tendency_handle Pressure tendency handle.
  * @return esp_err_t ESP_OK on success.
  */
-esp_err_t pressure_tendency_init(const uint16_t samples_size, 
+esp_err_t pressure_tendency_init(const pressure_tendency_config_t *pressure_tendency_config, 
                             pressure_tendency_handle_t *pressure_tendency_handle);
 /**
  * @brief Analyzes historical samples and pressure tendency appears after three 
@@ -110,6 +145,23 @@ esp_err_t pressure_tendency_analysis(pressure_tendency_handle_t pressure_tendenc
                                 pressure_tendency_codes_t *const code,
                                 float *const change);
 
+/**
+ * @brief Gets the air pressure change over a lookback period from the samples 
+ * history, e.g. 60, 180 or 360 minutes, without copying the samples.  The change 
+ * is the latest sample less the sample at the lookback period.  The sample at the 
+ * lookback period is exact within the full-rate history and is otherwise linearly 
+ * interpolated between the centres of the 1-minute or 10-minute averages.
+ * 
+ * @param pressure_tendency_handle Pressure tendency handle.
+ * @param lookback_period Lookback period in minutes, must not exceed the configured history period.
+ * @param change Air pressure change over the lookback period, NaN when there is an 
+ * insufficient number of samples.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t pressure_tendency_get_change(pressure_tendency_handle_t pressure_tendency_handle, 
+                                const uint16_t lookback_period, 
+                                float *const change);
+
 /**
  * @brief Purges pressure tendency samples array and resets samples counter.
  * 
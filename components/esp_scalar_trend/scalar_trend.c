@@ -152,6 +152,103 @@ const char* scalar_trend_code_to_string(const scalar_trend_codes_t code) {
     }
 }
 
+/**
+ * @brief Converts a sample to its running sums contribution.  NaN samples contribute
+ * nothing to the running sums and are tracked by the NaN samples counter instead.
+ * 
+ * @param scalar_trend_handle Scalar trend handle.
+ * @param sample Scalar sample.
+ * @return double Sample relative to the running sums offset, or 0 when the sample is NaN.
+ */
+static inline double scalar_trend_sample_value(scalar_trend_handle_t scalar_trend_handle, const float sample) {
+    if(isnan(sample)) return 0.0;
+    return (double)sample - scalar_trend_handle->samples_offset;
+}
+
+/**
+ * @brief Recomputes the running sums from the samples circular buffer.  This is called 
+ * once per buffer revolution to discard floating-point drift accumulated by the 
+ * incremental updates and to re-centre the running sums offset.
+ * 
+ * @param scalar_trend_handle Scalar trend handle.
+ */
+static inline void scalar_trend_resync_sums(scalar_trend_handle_t scalar_trend_handle) {
+    /* re-centre offset on the newest finite sample */
+    for (uint16_t i = scalar_trend_handle->samples_count; i > 0; i--) {
+        float y = scalar_trend_handle->samples[(scalar_trend_handle->samples_head + i - 1) % scalar_trend_handle->samples_size];
+        if(!isnan(y)) {
+            scalar_trend_handle->samples_offset = y;
+            break;
+        }
+    }
+
+    scalar_trend_handle->sum_y  = 0.0;
+    scalar_trend_handle->sum_yy = 0.0;
+    scalar_trend_handle->sum_xy = 0.0;
+
+    for (uint16_t i = 0; i < scalar_trend_handle->samples_count; i++) {
+        double y = scalar_trend_sample_value(scalar_trend_handle, scalar_trend_handle->samples[(scalar_trend_handle->samples_head + i) % scalar_trend_handle->samples_size]);
+
+        scalar_trend_handle->sum_y  += y;
+        scalar_trend_handle->sum_yy += y * y;
+        scalar_trend_handle->sum_xy += i * y;
+    }
+}
+
+/**
+ * @brief Pushes a sample onto the samples circular buffer and updates the running sums.
+ * 
+ * The regression x-axis is the sample position in chronological order, oldest sample 
+ * at x = 0.  When the buffer is full the oldest sample leaves at x = 0 and every 
+ * remaining sample shifts one position to the left, which reduces ∑(xy) by ∑(y) of 
+ * the remaining samples, and the new sample enters at x = n-1.
+ * 
+ * @param scalar_trend_handle Scalar trend handle.
+ * @param sample Scalar sample.
+ */
+static inline void scalar_trend_push_sample(scalar_trend_handle_t scalar_trend_handle, const float sample) {
+    /* set offset on the first finite sample, running sums are 0 when there are no finite samples */
+    if(!isnan(sample) && scalar_trend_handle->samples_count == scalar_trend_handle->samples_nan_count) {
+        scalar_trend_handle->samples_offset = sample;
+    }
+
+    double y = scalar_trend_sample_value(scalar_trend_handle, sample);
+
+    // have we filled the array?
+    if (scalar_trend_handle->samples_count < scalar_trend_handle->samples_size) {
+        // no! add this observation to the array
+        scalar_trend_handle->samples[scalar_trend_handle->samples_count] = sample;
+
+        scalar_trend_handle->sum_y  += y;
+        scalar_trend_handle->sum_yy += y * y;
+        scalar_trend_handle->sum_xy += scalar_trend_handle->samples_count * y;
+
+        // bump n
+        scalar_trend_handle->samples_count++;
+    } else {
+        // yes! the array is full so the oldest observation is replaced
+        float  oldest   = scalar_trend_handle->samples[scalar_trend_handle->samples_head];
+        double y_oldest = scalar_trend_sample_value(scalar_trend_handle, oldest);
+
+        if(isnan(oldest)) scalar_trend_handle->samples_nan_count--;
+
+        scalar_trend_handle->sum_xy  = scalar_trend_handle->sum_xy - (scalar_trend_handle->sum_y - y_oldest) + (scalar_trend_handle->samples_size - 1) * y;
+        scalar_trend_handle->sum_y   = scalar_trend_handle->sum_y - y_oldest + y;
+        scalar_trend_handle->sum_yy  = scalar_trend_handle->sum_yy - y_oldest * y_oldest + y * y;
+
+        // now we can fill in the oldest slot and advance the head
+        scalar_trend_handle->samples[scalar_trend_handle->samples_head] = sample;
+        scalar_trend_handle->samples_head = (scalar_trend_handle->samples_head + 1) % scalar_trend_handle->samples_size;
+    }
+
+    if(isnan(sample)) scalar_trend_handle->samples_nan_count++;
+
+    /* discard accumulated drift once per buffer revolution */
+    if (scalar_trend_handle->samples_count == scalar_trend_handle->samples_size && scalar_trend_handle->samples_head == 0) {
+        scalar_trend_resync_sums(scalar_trend_handle);
+    }
+}
+
 esp_err_t scalar_trend_init(const uint16_t samples_size, 
                             scalar_trend_handle_t *scalar_trend_handle) {
     esp_err_t  ret = ESP_OK;
@@ -170,6 +267,7 @@ esp_err_t scalar_trend_init(const uint16_t samples_size,
     /* calculate absolute critical t value and copy configuration */
     out_handle->critical_t           = fabs(t_inv(0.05/2, samples_size - 2));
     out_handle->samples_size         = samples_size;
+    out_handle->mode                 = SCALAR_TREND_MODE_INCREMENTAL;
 
     /* set output instance */
     *scalar_trend_handle = out_handle;
@@ -182,28 +280,25 @@ esp_err_t scalar_trend_init(const uint16_t samples_size,
         return ret;
 }
 
+esp_err_t scalar_trend_set_mode(scalar_trend_handle_t scalar_trend_handle, 
+                                const scalar_trend_modes_t mode) {
+    /* validate arguments */
+    ESP_ARG_CHECK(scalar_trend_handle);
+    ESP_RETURN_ON_FALSE( mode == SCALAR_TREND_MODE_INCREMENTAL || mode == SCALAR_TREND_MODE_COMPATIBLE, ESP_ERR_INVALID_ARG, TAG, "invalid mode, scalar trend set mode failed" );
+
+    scalar_trend_handle->mode = mode;
+
+    return ESP_OK;
+}
+
 esp_err_t scalar_trend_analysis(scalar_trend_handle_t scalar_trend_handle, 
                                 const float sample, 
                                 scalar_trend_codes_t *const code) {
     /* validate arguments */
     ESP_ARG_CHECK(scalar_trend_handle);
 
-    // have we filled the array?
-    if (scalar_trend_handle->samples_count < scalar_trend_handle->samples_size) {
-        // no! add this observation to the array
-        scalar_trend_handle->samples[scalar_trend_handle->samples_count] = sample;
-
-        // bump n
-        scalar_trend_handle->samples_count++;
-    } else {
-        // yes! the array is full so we have to make space
-        for (uint16_t i = 1; i < scalar_trend_handle->samples_size; i++) {
-            scalar_trend_handle->samples[i-1] = scalar_trend_handle->samples[i];
-        }
-
-        // now we can fill in the last slot
-        scalar_trend_handle->samples[scalar_trend_handle->samples_size-1] = sample;
-    }
+    /* push sample onto the circular buffer and update running sums */
+    scalar_trend_push_sample(scalar_trend_handle, sample);
 
     // is the array full yet?
     if (scalar_trend_handle->samples_count < scalar_trend_handle->samples_size) {
@@ -218,28 +313,45 @@ esp_err_t scalar_trend_analysis(scalar_trend_handle_t scalar_trend_handle,
      *          (least-squares linear regression)
      */
 
-    double sum_x = 0.0;     // ∑(x)
-    double sum_xx = 0.0;    // ∑(x²)
-    double sum_y = 0.0;     // ∑(y)
-    double sum_xy = 0.0;    // ∑(xy)
+    double sum_x;           // ∑(x)
+    double sum_xx;          // ∑(x²)
+    double slope;
+    double intercept;
+    double SSE;             // ∑((y-ŷ)²)
     
     // we need n in lots of places and it's convenient as a double
     double n = 1.0 * scalar_trend_handle->samples_size;
 
-    // iterate to calculate the above values
-    for (size_t i = 0; i < scalar_trend_handle->samples_size; i++) {
-        double x = 1.0 * i;
-        double y = scalar_trend_handle->samples[i];
+    if (scalar_trend_handle->mode == SCALAR_TREND_MODE_COMPATIBLE) {
+        double sum_y = 0.0;     // ∑(y)
+        double sum_xy = 0.0;    // ∑(xy)
 
-        sum_x = sum_x + x;
-        sum_xx = sum_xx + x * x;
-        sum_y = sum_y + y;
-        sum_xy = sum_xy + x * y;
-    }
+        sum_x  = 0.0;
+        sum_xx = 0.0;
+
+        // iterate oldest to newest to calculate the above values
+        for (size_t i = 0; i < scalar_trend_handle->samples_size; i++) {
+            double x = 1.0 * i;
+            double y = scalar_trend_handle->samples[(scalar_trend_handle->samples_head + i) % scalar_trend_handle->samples_size];
 
-    // calculate the slope and intercept
-    double slope = (sum_x*sum_y - n*sum_xy) / (sum_x*sum_x - n*sum_xx);
-    double intercept = (sum_y -slope*sum_x) / n;
+            sum_x = sum_x + x;
+            sum_xx = sum_xx + x * x;
+            sum_y = sum_y + y;
+            sum_xy = sum_xy + x * y;
+        }
+
+        // calculate the slope and intercept
+        slope = (sum_x*sum_y - n*sum_xy) / (sum_x*sum_x - n*sum_xx);
+        intercept = (sum_y -slope*sum_x) / n;
+    } else {
+        // x is 0..n-1 when the array is full, ∑(x) and ∑(x²) are closed form
+        sum_x  = n * (n - 1.0) / 2.0;
+        sum_xx = (n - 1.0) * n * (2.0 * n - 1.0) / 6.0;
+
+        // calculate the slope and intercept, intercept is relative to the running sums offset
+        slope = (sum_x*scalar_trend_handle->sum_y - n*scalar_trend_handle->sum_xy) / (sum_x*sum_x - n*sum_xx);
+        intercept = (scalar_trend_handle->sum_y -slope*sum_x) / n;
+    }
 
     /*
      * Step 2 : Perform an hypothesis test on the equation of the linear
@@ -303,13 +415,27 @@ esp_err_t scalar_trend_analysis(scalar_trend_handle_t scalar_trend_handle,
      *      
      */
 
-    double SSE = 0.0;        // ∑((y-ŷ)²)
+    if (scalar_trend_handle->mode == SCALAR_TREND_MODE_COMPATIBLE) {
+        SSE = 0.0;
+
+        // iterate oldest to newest
+        for (uint16_t i = 0; i < scalar_trend_handle->samples_size; i++) {
+            double y = scalar_trend_handle->samples[(scalar_trend_handle->samples_head + i) % scalar_trend_handle->samples_size];
+            double residual = y - (intercept + slope * i);
+            SSE = SSE + residual * residual;
+        }
+    } else {
+        // a NaN sample yields a NaN test statistic and a steady trend in compatible mode
+        if (scalar_trend_handle->samples_nan_count > 0) {
+            *code = SCALAR_TREND_CODE_STEADY;
+            return ESP_OK;
+        }
 
-    // iterate
-    for (uint16_t i = 0; i < scalar_trend_handle->samples_size; i++) {
-        double y = scalar_trend_handle->samples[i];
-        double residual = y - (intercept + slope * i);
-        SSE = SSE + residual * residual;
+        // SSE = Syy - b₁·Sxy, clamped to absorb rounding on near-perfect fits
+        double s_yy = scalar_trend_handle->sum_yy - scalar_trend_handle->sum_y * scalar_trend_handle->sum_y / n;
+        double s_xy = scalar_trend_handle->sum_xy - sum_x * scalar_trend_handle->sum_y / n;
+        SSE = s_yy - slope * s_xy;
+        if (SSE < 0.0) SSE = 0.0;
     }
 
     /*    
@@ -357,8 +483,14 @@ esp_err_t scalar_trend_reset(scalar_trend_handle_t scalar_trend_handle) {
         scalar_trend_handle->samples[i] = NAN;
     }
 
-    /* reset samples counter */
-    scalar_trend_handle->samples_count = 0;
+    /* reset samples counter, circular buffer index and running sums */
+    scalar_trend_handle->samples_count     = 0;
+    scalar_trend_handle->samples_head      = 0;
+    scalar_trend_handle->samples_nan_count = 0;
+    scalar_trend_handle->samples_offset    = 0.0;
+    scalar_trend_handle->sum_y             = 0.0;
+    scalar_trend_handle->sum_yy            = 0.0;
+    scalar_trend_handle->sum_xy            = 0.0;
 
     return ESP_OK;
 }
@@ -59,13 +59,31 @@ typedef enum scalar_trend_codes_tag {        /*!< 1-hr Change */
 } scalar_trend_codes_t;
 
 /**
- * @brief Scalar trend structure.
+ * @brief Scalar trend analysis modes enumerator.
+ */
+typedef enum scalar_trend_modes_tag {
+    SCALAR_TREND_MODE_INCREMENTAL = 0, /*!< regression from running sums, constant time per sample (default) */
+    SCALAR_TREND_MODE_COMPATIBLE  = 1  /*!< regression recomputed over all samples per call, identical results to the original two-pass analysis */
+} scalar_trend_modes_t;
+
+/**
+ * @brief Scalar trend structure.  Samples are stored in a circular buffer, `samples_head` 
+ * is the index of the oldest sample once the buffer is full.  Running sums are kept 
+ * relative to `samples_offset` to limit cancellation errors with large scalar values 
+ * (e.g. air pressure in hPa).
  */
 struct scalar_trend_t {
-    double      critical_t;    /*!< scalar trend samples absolute critical t value, state machine variable */
-    uint16_t    samples_count; /*!< scalar trend samples count, state machine variable */
-    uint16_t    samples_size;  /*!< scalar trend samples size, state machine variable */
-    float*      samples;       /*!< scalar trend samples array, state machine variable */
+    double                  critical_t;         /*!< scalar trend samples absolute critical t value, state machine variable */
+    scalar_trend_modes_t    mode;               /*!< scalar trend analysis mode, state machine variable */
+    uint16_t                samples_count;      /*!< scalar trend samples count, state machine variable */
+    uint16_t                samples_size;       /*!< scalar trend samples size, state machine variable */
+    uint16_t                samples_head;       /*!< scalar trend samples circular buffer index of the oldest sample, state machine variable */
+    uint16_t                samples_nan_count;  /*!< scalar trend number of NaN samples in the circular buffer, state machine variable */
+    double                  samples_offset;     /*!< scalar trend reference offset of the running sums, state machine variable */
+    double                  sum_y;              /*!< scalar trend running ∑(y), state machine variable */
+    double                  sum_yy;             /*!< scalar trend running ∑(y²), state machine variable */
+    double                  sum_xy;             /*!< scalar trend running ∑(xy), state machine variable */
+    float*                  samples;            /*!< scalar trend samples circular buffer, state machine variable */
 };
 
 /**
@@ -114,6 +132,17 @@ esp_err_t scalar_trend_analysis(scalar_trend_handle_t scalar_trend_handle,
                                 const float sample, 
                                 scalar_trend_codes_t *const code);
 
+/**
+ * @brief Sets the scalar trend analysis mode.  The running sums are maintained in 
+ * either mode, the mode can be changed at any time without resetting the handle.
+ * 
+ * @param scalar_trend_handle Scalar trend handle.
+ * @param mode Scalar trend analysis mode.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t scalar_trend_set_mode(scalar_trend_handle_t scalar_trend_handle, 
+                                const scalar_trend_modes_t mode);
+
 /**
  * @brief Purges scalar trend samples array and resets samples counter.
  * 
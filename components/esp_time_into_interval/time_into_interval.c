@@ -44,20 +44,36 @@
 #include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
-#include <freertos/semphr.h>
 
 #define TIME_INTO_INTERVAL_NAME_MAX_SIZE         (25)        //!< 25-characters for user-defined time-into-interval name
+#define TIME_INTO_INTERVAL_UTC_OFFSET_SPAN_USEC  (15ULL * 60U * 1000000U) //!< utc offset transitions, dst and time zone, are on a 15-minute utc boundary
 
 /*
  * macro definitions
 */
 #define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
 
+/**
+ * @brief Time-into-interval utc offset cache structure.
+ */
+typedef struct time_into_interval_utc_offset_cache_tag {
+    int64_t     utc_offset_usec;    /*!< local time offset from utc in micro-seconds */
+    uint64_t    valid_from_usec;    /*!< unix epoch timestamp (UTC) the utc offset is valid from in micro-seconds */
+    uint64_t    valid_until_usec;   /*!< unix epoch timestamp (UTC) the utc offset is valid until, exclusive, in micro-seconds */
+    bool        valid;              /*!< utc offset is computed */
+} time_into_interval_utc_offset_cache_t;
+
 /*
 * static constant declerations
 */
 static const char *TAG = "time_into_interval";
 
+/*
+* static variable declerations
+*/
+static time_into_interval_utc_offset_cache_t s_utc_offset_cache = { 0 };
+static portMUX_TYPE                          s_utc_offset_lock  = portMUX_INITIALIZER_UNLOCKED;
+
 
 /**
  * @brief Gets a 16-bit hash-code utilizing epoch timestamp as the seed.
@@ -69,42 +85,85 @@ static inline uint16_t time_into_interval_get_hash_code(void) {
     return ((seed_hash>>16) ^ (seed_hash)) & 0xFFFF;
 }
 
-uint64_t time_into_interval_normalize_interval_to_sec(const time_into_interval_types_t interval_type, const uint16_t interval) {
-    uint64_t interval_sec = 0;
+/**
+ * @brief Publishes the owner state, the next event and the last task delay event, to lock-free
+ * readers.  The inactive state is written and the sequence is incremented to make it the active 
+ * state, a writer preempted while writing doesn't hold back readers of the active state.
+ * 
+ * @param time_into_interval_handle Time-into-interval handle.
+ */
+static inline void time_into_interval_publish_state(time_into_interval_handle_t time_into_interval_handle) {
+    const uint32_t              sequence = __atomic_load_n(&time_into_interval_handle->sequence, __ATOMIC_RELAXED);
+    time_into_interval_state_t *state    = &time_into_interval_handle->state[(sequence + 1U) & 1U];
 
-    // normalize interval to sec
-    switch(interval_type) {
-        case TIME_INTO_INTERVAL_SEC:
-            interval_sec = interval;
-            break;
-        case TIME_INTO_INTERVAL_MIN:
-            interval_sec = (interval * 60U);  // 1-minute has 60-seconds
-            break;
-        case TIME_INTO_INTERVAL_HR:
-            interval_sec = (interval * (60U * 60U)); // 1-hour has 60-minutes, 1-minute has 60-seconds
-            break;
-    }
+    /* order the sequence store of the previous publish before the writes of the inactive state, a reader copying it detects the writes */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    state->epoch_timestamp = time_into_interval_handle->epoch_timestamp;
+    state->event           = time_into_interval_handle->event;
+
+    __atomic_store_n(&time_into_interval_handle->sequence, sequence + 1U, __ATOMIC_RELEASE);
+}
 
-    return interval_sec;
+/**
+ * @brief Reads the published state, the copy is retried when the owner published twice while copying.
+ * 
+ * @param time_into_interval_handle Time-into-interval handle.
+ * @param state Published time-into-interval state.
+ */
+static inline void time_into_interval_read_state(time_into_interval_handle_t time_into_interval_handle, time_into_interval_state_t *const state) {
+    uint32_t sequence;
+
+    do {
+        sequence = __atomic_load_n(&time_into_interval_handle->sequence, __ATOMIC_ACQUIRE);
+        *state   = time_into_interval_handle->state[sequence & 1U];
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while(sequence != __atomic_load_n(&time_into_interval_handle->sequence, __ATOMIC_RELAXED));
+}
+
+/**
+ * @brief Alarm timer callback of the time-into-interval task delay, notifies the delayed task.
+ * 
+ * @param arg Time-into-interval handle.
+ */
+static void time_into_interval_alarm_callback(void *arg) {
+    time_into_interval_handle_t time_into_interval_handle = (time_into_interval_handle_t)arg;
+
+    time_into_interval_handle->alarm = true;
+    xTaskNotifyGive(time_into_interval_handle->task_handle);
+}
+
+uint64_t time_into_interval_normalize_interval_to_sec(const time_into_interval_types_t interval_type, const uint16_t interval) {
+    return time_into_interval_normalize_interval_to_usec(interval_type, interval) / 1000000U;
 }
 
 uint64_t time_into_interval_normalize_interval_to_msec(const time_into_interval_types_t interval_type, const uint16_t interval) {
-    uint64_t interval_msec = 0;
+    return time_into_interval_normalize_interval_to_usec(interval_type, interval) / 1000U;
+}
+
+uint64_t time_into_interval_normalize_interval_to_usec(const time_into_interval_types_t interval_type, const uint16_t interval) {
+    uint64_t interval_usec = 0;
 
-    // normalize interval to sec
+    // normalize interval to usec
     switch(interval_type) {
+        case TIME_INTO_INTERVAL_USEC:
+            interval_usec = interval;
+            break;
+        case TIME_INTO_INTERVAL_MSEC:
+            interval_usec = (uint64_t)interval * 1000U; // 1-milli-second has 1000-micro-seconds
+            break;
         case TIME_INTO_INTERVAL_SEC:
-            interval_msec = interval * 1000U;
+            interval_usec = (uint64_t)interval * 1000000U; // 1-second has 1000000-micro-seconds
             break;
         case TIME_INTO_INTERVAL_MIN:
-            interval_msec = (interval * 60U) * 1000U; // 1-minute has 60-seconds
+            interval_usec = ((uint64_t)interval * 60U) * 1000000U; // 1-minute has 60-seconds
             break;
         case TIME_INTO_INTERVAL_HR:
-            interval_msec = ((interval * 60U) * 60U) * 1000U; // 1-hour has 60-minutes, 1-minute has 60-seconds
+            interval_usec = (((uint64_t)interval * 60U) * 60U) * 1000000U; // 1-hour has 60-minutes, 1-minute has 60-seconds
             break;
     }
 
-    return interval_msec;
+    return interval_usec;
 }
 
 uint64_t time_into_interval_get_epoch_timestamp(void) {
@@ -143,116 +202,155 @@ uint64_t time_into_interval_get_epoch_timestamp_usec(void) {
     return (uint64_t)tv_utc_timestamp.tv_sec * 1000000U + (uint64_t)tv_utc_timestamp.tv_usec;
 }
 
-esp_err_t time_into_interval_set_epoch_timestamp_event(const time_into_interval_types_t interval_type, const uint16_t interval_period, const uint16_t interval_offset, uint64_t *epoch_timestamp) {
-    struct timeval  now_tv;
-    struct tm       now_tm;
-    struct tm       next_tm;
+/**
+ * @brief Converts a proleptic gregorian calendar date to days since the unix epoch.
+ * 
+ * @param year Year.
+ * @param month Month, 1 to 12.
+ * @param day Day of the month, 1 to 31.
+ * @return int64_t Days since 1970-01-01.
+ */
+static inline int64_t time_into_interval_days_from_civil(int64_t year, const int32_t month, const int32_t day) {
+    year -= (month <= 2) ? 1 : 0;
+    const int64_t era = ((year >= 0) ? year : year - 399) / 400;
+    const int64_t yoe = year - era * 400;                                             // year of era [0, 399]
+    const int64_t doy = (153 * (month + ((month > 2) ? -3 : 9)) + 2) / 5 + day - 1;   // day of year [0, 365]
+    const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;                        // day of era [0, 146096]
+    return era * 146097 + doe - 719468;
+}
 
-    /* validate interval period argument */
-    ESP_RETURN_ON_FALSE( (interval_period > 0), ESP_ERR_INVALID_ARG, TAG, "interval period cannot be 0, time-into-interval set epoch time event failed" );
+/**
+ * @brief Gets the local time offset from utc.  The offset is computed with `localtime_r` once per 
+ * 15-minute utc span, utc offset transitions are on 15-minute utc boundaries, and is recomputed when 
+ * the system clock leaves the span e.g. a dst transition or an sntp adjustment.
+ * 
+ * @param now_unix_usec Unix epoch timestamp (UTC) in micro-seconds.
+ * @return int64_t Local time offset from utc in micro-seconds.
+ */
+static inline int64_t time_into_interval_get_utc_offset_usec(const uint64_t now_unix_usec) {
+    time_into_interval_utc_offset_cache_t cache;
+    struct tm                             now_tm;
 
-    /* normalize interval period and offset to milli-seconds */
-    uint64_t interval_period_msec = time_into_interval_normalize_interval_to_msec(interval_type, interval_period);
-    uint64_t interval_offset_msec = time_into_interval_normalize_interval_to_msec(interval_type, interval_offset);
+    taskENTER_CRITICAL(&s_utc_offset_lock);
+    cache = s_utc_offset_cache;
+    taskEXIT_CRITICAL(&s_utc_offset_lock);
 
-    /* validate interval period argument on total days */
-    ESP_RETURN_ON_FALSE( (interval_period_msec <= (28U * 24U * 60U * 60U * 1000U)), ESP_ERR_INVALID_ARG, TAG, "interval period cannot be greater than 28-days, time-into-interval set epoch time event failed" );
+    /* validate the utc offset of the span */
+    if(cache.valid && now_unix_usec >= cache.valid_from_usec && now_unix_usec < cache.valid_until_usec) {
+        return cache.utc_offset_usec;
+    }
 
-    /* validate period and offset intervals */
-    ESP_RETURN_ON_FALSE( ((interval_period_msec - interval_offset_msec) > 0), ESP_ERR_INVALID_ARG, TAG, "interval period must be larger than the interval offset, time-into-interval set epoch time event failed" );
+    // convert now to time-parts localtime from unix time
+    time_t now_unix_time = (time_t)(now_unix_usec / 1000000U);
+    localtime_r(&now_unix_time, &now_tm);
 
-    // get system unix epoch time (gmt)
-    gettimeofday(&now_tv, NULL);
+    // local time-parts as unix time less unix time is the utc offset
+    const int64_t local_unix_time = time_into_interval_days_from_civil((int64_t)now_tm.tm_year + 1900, now_tm.tm_mon + 1, now_tm.tm_mday) * 86400 +
+                                    (int64_t)now_tm.tm_hour * 3600 + (int64_t)now_tm.tm_min * 60 + (int64_t)now_tm.tm_sec;
 
-    // extract system unix time (seconds and milli-seconds)
-    time_t now_unix_time        = now_tv.tv_sec;
-    uint64_t now_unix_time_msec = (uint64_t)now_tv.tv_sec * 1000U + (uint64_t)now_tv.tv_usec / 1000U;
+    cache.utc_offset_usec  = (local_unix_time - (int64_t)now_unix_time) * 1000000;
+    cache.valid_from_usec  = now_unix_usec - (now_unix_usec % TIME_INTO_INTERVAL_UTC_OFFSET_SPAN_USEC);
+    cache.valid_until_usec = cache.valid_from_usec + TIME_INTO_INTERVAL_UTC_OFFSET_SPAN_USEC;
+    cache.valid            = true;
 
-    // convert now tm to time-parts localtime from unix time
-    localtime_r(&now_unix_time, &now_tm);
+    taskENTER_CRITICAL(&s_utc_offset_lock);
+    s_utc_offset_cache = cache;
+    taskEXIT_CRITICAL(&s_utc_offset_lock);
+
+    return cache.utc_offset_usec;
+}
+
+/**
+ * @brief Gets the local time-part the interval boundaries are aligned to, see 
+ * `time_into_interval_set_epoch_timestamp_event`.
+ * 
+ * @param interval_type Time-into-interval type of interval period.
+ * @param interval_period_usec Time-into-interval period in micro-seconds.
+ * @return uint64_t Local time-part span in micro-seconds, a second, minute, hour or day.
+ */
+static inline uint64_t time_into_interval_get_anchor_usec(const time_into_interval_types_t interval_type, const uint64_t interval_period_usec) {
+    uint64_t anchor_usec = 0;
 
-    // initialize next tm structure time-parts localtime based on interval-type
+    // time-part of the interval type
     switch(interval_type) {
+        case TIME_INTO_INTERVAL_USEC:
+        case TIME_INTO_INTERVAL_MSEC:
+            anchor_usec = 1000000U;
+            break;
         case TIME_INTO_INTERVAL_SEC:
-            next_tm.tm_year = now_tm.tm_year;
-            next_tm.tm_mon  = now_tm.tm_mon;
-            next_tm.tm_mday = now_tm.tm_mday;
-            next_tm.tm_hour = now_tm.tm_hour;
-            next_tm.tm_min  = now_tm.tm_min;
-            next_tm.tm_sec  = 0;
+            anchor_usec = 60U * 1000000U;
             break;
         case TIME_INTO_INTERVAL_MIN:
-            next_tm.tm_year = now_tm.tm_year;
-            next_tm.tm_mon  = now_tm.tm_mon;
-            next_tm.tm_mday = now_tm.tm_mday;
-            next_tm.tm_hour = now_tm.tm_hour;
-            next_tm.tm_min  = 0;
-            next_tm.tm_sec  = 0;
+            anchor_usec = 60ULL * 60U * 1000000U;
             break;
         case TIME_INTO_INTERVAL_HR:
-            next_tm.tm_year = now_tm.tm_year;
-            next_tm.tm_mon  = now_tm.tm_mon;
-            next_tm.tm_mday = now_tm.tm_mday;
-            next_tm.tm_hour = 0;
-            next_tm.tm_min  = 0;
-            next_tm.tm_sec  = 0;
+            anchor_usec = 24ULL * 60U * 60U * 1000000U;
             break;
     }
 
-    /* handle interval period by tm structure time-part timespan exceedance */
-    if(interval_period_msec > (60U * 1000U)) {
-        /* over 60-seconds, set minute time-part to 0 */
-        next_tm.tm_min  = 0;
-        next_tm.tm_sec  = 0;
-    } else if(interval_period_msec > (60U * 60U * 1000U)) {
-        /* over 60-minutes, set hour time-part to 0 */
-        next_tm.tm_hour = 0;
-        next_tm.tm_min  = 0;
-        next_tm.tm_sec  = 0;
-    } else if(interval_period_msec > (24U * 60U * 60U * 1000U)) {
-        /* over 24-hours, set day time-part to 0 */
-        next_tm.tm_mday = 0;
-        next_tm.tm_hour = 0;
-        next_tm.tm_min  = 0;
-        next_tm.tm_sec  = 0;
+    /* handle interval period by time-part timespan exceedance, over 1-second to the minute, over 60-seconds to the hour */
+    if(interval_period_usec > 1000000U && anchor_usec < 60U * 1000000U) {
+        anchor_usec = 60U * 1000000U;
     }
-    
+    if(interval_period_usec > (60U * 1000000U) && anchor_usec < 60ULL * 60U * 1000000U) {
+        anchor_usec = 60ULL * 60U * 1000000U;
+    }
+
+    return anchor_usec;
+}
+
+esp_err_t time_into_interval_set_epoch_timestamp_event(const time_into_interval_types_t interval_type, const uint16_t interval_period, const uint16_t interval_offset, uint64_t *epoch_timestamp) {
+    /* validate interval period argument */
+    ESP_RETURN_ON_FALSE( (interval_period > 0), ESP_ERR_INVALID_ARG, TAG, "interval period cannot be 0, time-into-interval set epoch time event failed" );
+
+    /* normalize interval period and offset to micro-seconds */
+    uint64_t interval_period_usec = time_into_interval_normalize_interval_to_usec(interval_type, interval_period);
+    uint64_t interval_offset_usec = time_into_interval_normalize_interval_to_usec(interval_type, interval_offset);
+
+    /* validate interval period argument on total days */
+    ESP_RETURN_ON_FALSE( (interval_period_usec <= (28ULL * 24U * 60U * 60U * 1000000U)), ESP_ERR_INVALID_ARG, TAG, "interval period cannot be greater than 28-days, time-into-interval set epoch time event failed" );
+
+    /* validate period and offset intervals */
+    ESP_RETURN_ON_FALSE( (interval_period_usec > interval_offset_usec), ESP_ERR_INVALID_ARG, TAG, "interval period must be larger than the interval offset, time-into-interval set epoch time event failed" );
+
     // validate if the next task event was computed
     if(*epoch_timestamp != 0) {
         // add task interval to next task event epoch to compute next task event epoch
-        *epoch_timestamp = *epoch_timestamp + interval_period_msec;
-    } else {
-        // convert to unix time (seconds)
-        time_t next_unix_time = mktime(&next_tm);
-
-        // convert unix time to milli-seconds
-        uint64_t next_unix_time_msec = next_unix_time * 1000U;
-
-        // initialize next unix time by adding the task event interval period and offset
-        next_unix_time_msec = next_unix_time_msec + interval_period_msec + interval_offset_msec;
-
-        // compute the delta between now and next unix times
-        int64_t delta_time_msec = next_unix_time_msec - now_unix_time_msec;
-
-        // ensure next task event is ahead in time
-        if(delta_time_msec <= 0) {
-            // next task event is not ahead in time
-            do {
-                // keep adding task event intervals until next task event is ahead in time
-                next_unix_time_msec = next_unix_time_msec + interval_period_msec;
-                
-                // compute the delta between now and next unix times
-                delta_time_msec = next_unix_time_msec - now_unix_time_msec;
-            } while(delta_time_msec <= 0);
-        }
+        *epoch_timestamp = *epoch_timestamp + interval_period_usec;
+
+        return ESP_OK;
+    }
 
-        // set next task event epoch time
-        *epoch_timestamp = next_unix_time_msec;
+    // get system unix epoch timestamp (UTC) and the local time offset from utc
+    const uint64_t now_unix_time_usec = time_into_interval_get_epoch_timestamp_usec();
+    const int64_t  utc_offset_usec    = time_into_interval_get_utc_offset_usec(now_unix_time_usec);
+
+    // floor the local time to the time-part of the interval boundaries and convert back to unix time
+    const int64_t anchor_usec     = (int64_t)time_into_interval_get_anchor_usec(interval_type, interval_period_usec);
+    const int64_t local_time_usec = (int64_t)now_unix_time_usec + utc_offset_usec;
+    int64_t       anchor_rem_usec = local_time_usec % anchor_usec;
+    if(anchor_rem_usec < 0) anchor_rem_usec += anchor_usec;
+
+    // initialize next unix time by adding the task event interval period and offset
+    uint64_t next_unix_time_usec = (uint64_t)(local_time_usec - anchor_rem_usec - utc_offset_usec) + interval_period_usec + interval_offset_usec;
+
+    // ensure next task event is ahead in time, skip the elapsed task event intervals at once
+    if(next_unix_time_usec <= now_unix_time_usec) {
+        next_unix_time_usec += ((now_unix_time_usec - next_unix_time_usec) / interval_period_usec + 1U) * interval_period_usec;
     }
 
+    // set next task event epoch time
+    *epoch_timestamp = next_unix_time_usec;
+
     return ESP_OK;
 }
 
+void time_into_interval_refresh_utc_offset(void) {
+    taskENTER_CRITICAL(&s_utc_offset_lock);
+    s_utc_offset_cache.valid = false;
+    taskEXIT_CRITICAL(&s_utc_offset_lock);
+}
+
 esp_err_t time_into_interval_init(const time_into_interval_config_t *time_into_interval_config, 
                                  time_into_interval_handle_t *time_into_interval_handle) {
     esp_err_t                   ret = ESP_OK;
@@ -263,8 +361,8 @@ esp_err_t time_into_interval_init(const time_into_interval_config_t *time_into_i
     ESP_GOTO_ON_FALSE( (time_into_interval_config->interval_period > 0), ESP_ERR_INVALID_ARG, err, TAG, "time-into-interval interval period cannot be 0, time-into-interval handle initialization failed" );
 
     /* validate period and offset intervals */
-    int64_t interval_delta = time_into_interval_normalize_interval_to_sec(time_into_interval_config->interval_type, time_into_interval_config->interval_period) - 
-                             time_into_interval_normalize_interval_to_sec(time_into_interval_config->interval_type, time_into_interval_config->interval_offset); 
+    int64_t interval_delta = time_into_interval_normalize_interval_to_usec(time_into_interval_config->interval_type, time_into_interval_config->interval_period) - 
+                             time_into_interval_normalize_interval_to_usec(time_into_interval_config->interval_type, time_into_interval_config->interval_offset); 
     ESP_GOTO_ON_FALSE( (interval_delta > 0), ESP_ERR_INVALID_ARG, err, TAG, "time-into-interval interval period must be larger than the interval offset, time-into-interval handle initialization failed" );
     
     /* validate memory availability for time into interval handle */
@@ -278,20 +376,33 @@ esp_err_t time_into_interval_init(const time_into_interval_config_t *time_into_i
     out_handle->interval_period = time_into_interval_config->interval_period;
     out_handle->interval_offset = time_into_interval_config->interval_offset;
     out_handle->hash_code       = time_into_interval_get_hash_code();
-    out_handle->mutex_handle    = xSemaphoreCreateMutex();
+
+    /* create the one-shot alarm timer of the task delay */
+    const esp_timer_create_args_t timer_args = {
+        .callback           = time_into_interval_alarm_callback,
+        .arg                = out_handle,
+        .dispatch_method    = ESP_TIMER_TASK,
+        .name               = out_handle->name,
+    };
+    ESP_GOTO_ON_ERROR( esp_timer_create(&timer_args, &out_handle->timer_handle), err_out_handle, TAG, "unable to create alarm timer, time-into-interval handle initialization failed" );
 
     /* set epoch timestamp of the next scheduled time-into-interval event */
     ESP_GOTO_ON_ERROR( time_into_interval_set_epoch_timestamp_event(out_handle->interval_type, 
                                                             out_handle->interval_period, 
                                                             out_handle->interval_offset, 
                                                             &out_handle->epoch_timestamp), 
-                                                            err_out_handle, TAG, "unable to set epoch timestamp, time-into-interval handle initialization failed" );
+                                                            err_timer_handle, TAG, "unable to set epoch timestamp, time-into-interval handle initialization failed" );
+
+    /* publish the state of the first event */
+    time_into_interval_publish_state(out_handle);
 
     /* set output handle */
     *time_into_interval_handle = out_handle;
 
     return ESP_OK;
 
+    err_timer_handle:
+        esp_timer_delete(out_handle->timer_handle);
     err_out_handle:
         free(out_handle);
     err:
@@ -306,17 +417,14 @@ bool time_into_interval(time_into_interval_handle_t time_into_interval_handle) {
         return state;
     }
 
-    /* lock the mutex */
-    xSemaphoreTake(time_into_interval_handle->mutex_handle, portMAX_DELAY);
-
     // get system unix epoch timestamp (UTC)
-    uint64_t now_unix_msec = time_into_interval_get_epoch_timestamp_msec();
+    uint64_t now_unix_usec = time_into_interval_get_epoch_timestamp_usec();
 
     // compute time delta until next time into interval condition
-    int64_t delta_msec = time_into_interval_handle->epoch_timestamp - now_unix_msec;
+    int64_t delta_usec = time_into_interval_handle->epoch_timestamp - now_unix_usec;
 
     // validate time delta, when delta is <= 0, time has elapsed
-    if(delta_msec <= 0) {
+    if(delta_usec <= 0) {
         // set time-into-interval state to true - intervale has lapsed
         state = true;
 
@@ -325,30 +433,38 @@ bool time_into_interval(time_into_interval_handle_t time_into_interval_handle) {
                                                     time_into_interval_handle->interval_period, 
                                                     time_into_interval_handle->interval_offset, 
                                                     &time_into_interval_handle->epoch_timestamp);
-    }
 
-    /* unlock the mutex */
-    xSemaphoreGive(time_into_interval_handle->mutex_handle);
+        /* publish the state of the next event */
+        time_into_interval_publish_state(time_into_interval_handle);
+    }
     
     return state;
 }
 
 esp_err_t time_into_interval_delay(time_into_interval_handle_t time_into_interval_handle) {
+    esp_err_t ret = ESP_OK;
+    uint32_t  skipped_events = 0;
+
     // validate arguments
     ESP_ARG_CHECK( time_into_interval_handle );
 
-    /* lock the mutex */
-    xSemaphoreTake(time_into_interval_handle->mutex_handle, portMAX_DELAY);
+    /* normalize interval period and offset to micro-seconds */
+    const uint64_t interval_period_usec = time_into_interval_normalize_interval_to_usec(time_into_interval_handle->interval_type, time_into_interval_handle->interval_period);
+    const uint64_t interval_offset_usec = time_into_interval_normalize_interval_to_usec(time_into_interval_handle->interval_type, time_into_interval_handle->interval_offset);
 
     // get system unix epoch timestamp (UTC)
-    uint64_t now_unix_msec = time_into_interval_get_epoch_timestamp_msec();
-
-    // compute time delta until next scan event
-    int64_t delta_msec = time_into_interval_handle->epoch_timestamp - now_unix_msec;
-
-    // validate time is into the future, otherwise, reset next epoch time
-    if(delta_msec < 0) {
-        // reset epoch time of the next schedule task
+    uint64_t now_unix_usec   = time_into_interval_get_epoch_timestamp_usec();
+    uint64_t event_unix_usec = time_into_interval_handle->epoch_timestamp;
+
+    // validate the next event is ahead in time
+    if(event_unix_usec <= now_unix_usec) {
+        // skip the elapsed events, the next event stays on the interval boundaries
+        const uint64_t elapsed_events = (now_unix_usec - event_unix_usec) / interval_period_usec + 1U;
+
+        skipped_events   = (elapsed_events > UINT32_MAX) ? UINT32_MAX : (uint32_t)elapsed_events;
+        event_unix_usec += elapsed_events * interval_period_usec;
+    } else if(event_unix_usec - now_unix_usec > interval_period_usec + interval_offset_usec) {
+        // the system clock was set back, reset epoch time of the next schedule task
         time_into_interval_handle->epoch_timestamp = 0;
 
         // set epoch timestamp of the next scheduled task
@@ -357,49 +473,89 @@ esp_err_t time_into_interval_delay(time_into_interval_handle_t time_into_interva
                                                     time_into_interval_handle->interval_offset, 
                                                     &time_into_interval_handle->epoch_timestamp);
 
-        // compute time delta for next event
-        delta_msec = time_into_interval_handle->epoch_timestamp - now_unix_msec;
+        event_unix_usec = time_into_interval_handle->epoch_timestamp;
     }
+    time_into_interval_handle->epoch_timestamp = event_unix_usec;
+    time_into_interval_handle->task_handle     = xTaskGetCurrentTaskHandle();
 
-    // compute ticks delay from time delta
-    TickType_t delay = (delta_msec / portTICK_PERIOD_MS);
+    /* the alarm timer runs on the monotonic clock, re-arm the alarm when the system clock was set back while waiting */
+    do {
+        time_into_interval_handle->alarm = false;
 
-    /* unlock the mutex */
-    xSemaphoreGive(time_into_interval_handle->mutex_handle);
+        // arm the alarm timer on the interval boundary
+        ESP_GOTO_ON_ERROR( esp_timer_start_once(time_into_interval_handle->timer_handle, event_unix_usec - now_unix_usec), err, TAG, "unable to start alarm timer, time-into-interval delay failed" );
 
-    // delay the task per ticks delay
-    vTaskDelay( delay );
+        // wait for the alarm timer notification
+        while(time_into_interval_handle->alarm == false) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+
+        now_unix_usec = time_into_interval_get_epoch_timestamp_usec();
 
-    /* lock the mutex */
-    xSemaphoreTake(time_into_interval_handle->mutex_handle, portMAX_DELAY);
+        // validate the system clock wasn't set back by more than an interval while waiting
+        if(now_unix_usec < event_unix_usec && event_unix_usec - now_unix_usec > interval_period_usec + interval_offset_usec) {
+            // reset epoch time of the next schedule task
+            time_into_interval_handle->epoch_timestamp = 0;
+
+            // set epoch timestamp of the next scheduled task from the system clock
+            time_into_interval_set_epoch_timestamp_event(time_into_interval_handle->interval_type, 
+                                                        time_into_interval_handle->interval_period, 
+                                                        time_into_interval_handle->interval_offset, 
+                                                        &time_into_interval_handle->epoch_timestamp);
+
+            event_unix_usec = time_into_interval_handle->epoch_timestamp;
+        }
+    } while(now_unix_usec < event_unix_usec);
+
+    /* set event of the task delay */
+    time_into_interval_handle->event.epoch_timestamp_usec = event_unix_usec;
+    time_into_interval_handle->event.lateness_usec        = (int64_t)(now_unix_usec - event_unix_usec);
+    time_into_interval_handle->event.skipped_events       = skipped_events;
 
     // set epoch timestamp of the next scheduled task
     time_into_interval_set_epoch_timestamp_event(time_into_interval_handle->interval_type, 
                                         time_into_interval_handle->interval_period, 
                                         time_into_interval_handle->interval_offset, 
                                         &time_into_interval_handle->epoch_timestamp);
-                                        
-    /* unlock the mutex */
-    xSemaphoreGive(time_into_interval_handle->mutex_handle);
+
+    /* publish the state of the event and the next event */
+    time_into_interval_publish_state(time_into_interval_handle);
 
     return ESP_OK;
+
+    err:
+        return ret;
 }
 
 esp_err_t time_into_interval_get_last_event(time_into_interval_handle_t time_into_interval_handle, uint64_t *epoch_timestamp) {
+    time_into_interval_state_t state;
+
     // validate arguments
-    ESP_ARG_CHECK( time_into_interval_handle );
+    ESP_ARG_CHECK( time_into_interval_handle && epoch_timestamp );
 
-    /* lock the mutex */
-    xSemaphoreTake(time_into_interval_handle->mutex_handle, portMAX_DELAY);
+    /* read the published state */
+    time_into_interval_read_state(time_into_interval_handle, &state);
 
-    /* convert interval into msec */
-    uint64_t interval_msec = time_into_interval_normalize_interval_to_msec(time_into_interval_handle->interval_type, time_into_interval_handle->interval_period);
+    /* convert interval into usec */
+    uint64_t interval_usec = time_into_interval_normalize_interval_to_usec(time_into_interval_handle->interval_type, time_into_interval_handle->interval_period);
 
-    /* set last event epoch timestamp */
-    *epoch_timestamp = time_into_interval_handle->epoch_timestamp - interval_msec;
+    /* set last event epoch timestamp in msec */
+    *epoch_timestamp = (state.epoch_timestamp - interval_usec) / 1000U;
 
-    /* unlock the mutex */
-    xSemaphoreGive(time_into_interval_handle->mutex_handle);
+    return ESP_OK;
+}
+
+esp_err_t time_into_interval_get_delay_event(time_into_interval_handle_t time_into_interval_handle, time_into_interval_event_t *const event) {
+    time_into_interval_state_t state;
+
+    // validate arguments
+    ESP_ARG_CHECK( time_into_interval_handle && event );
+
+    /* read the published state */
+    time_into_interval_read_state(time_into_interval_handle, &state);
+
+    /* copy event of the last task delay */
+    *event = state.event;
 
     return ESP_OK;
 }
@@ -407,8 +563,10 @@ esp_err_t time_into_interval_get_last_event(time_into_interval_handle_t time_int
 esp_err_t time_into_interval_del(time_into_interval_handle_t time_into_interval_handle) {
     /* free resource */
     if(time_into_interval_handle) {
+        esp_timer_stop(time_into_interval_handle->timer_handle);
+        esp_timer_delete(time_into_interval_handle->timer_handle);
         free(time_into_interval_handle);
     }
 
     return ESP_OK;
-}
\ No newline at end of file
+}
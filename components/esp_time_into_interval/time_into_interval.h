@@ -40,25 +40,25 @@
 #include <time.h>
 #include <sys/time.h>
 #include <esp_err.h>
+#include <esp_timer.h>
 
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
-#include <freertos/semphr.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 
-// TODO? - add multi-thread synch (i.e. mutex)??
-
 /**
  * @brief Time into interval types enumerator.
  */
 typedef enum time_into_interval_types_tag {
-    TIME_INTO_INTERVAL_SEC, /*!< Time-into-interval in seconds. */
-    TIME_INTO_INTERVAL_MIN, /*!< Time-into-interval in minutes. */
-    TIME_INTO_INTERVAL_HR   /*!< Time-into-interval in hours. */
+    TIME_INTO_INTERVAL_USEC, /*!< Time-into-interval in micro-seconds. */
+    TIME_INTO_INTERVAL_MSEC, /*!< Time-into-interval in milli-seconds. */
+    TIME_INTO_INTERVAL_SEC,  /*!< Time-into-interval in seconds. */
+    TIME_INTO_INTERVAL_MIN,  /*!< Time-into-interval in minutes. */
+    TIME_INTO_INTERVAL_HR    /*!< Time-into-interval in hours. */
 } time_into_interval_types_t;
 
 
@@ -75,16 +75,40 @@ typedef struct time_into_interval_config_tag {
 
 
 /**
- * @brief Time-into-interval structure.
+ * @brief Time-into-interval event structure, the interval boundary a task delay woke up on.
+ */
+typedef struct time_into_interval_event_tag {
+    uint64_t                         epoch_timestamp_usec; /*!< time-into-interval event, unix epoch timestamp (UTC) of the interval boundary in micro-seconds */
+    int64_t                          lateness_usec;        /*!< time-into-interval event, time from the interval boundary until the task woke up in micro-seconds */
+    uint32_t                         skipped_events;       /*!< time-into-interval event, number of interval boundaries that elapsed before the task delay was called */
+} time_into_interval_event_t;
+
+/**
+ * @brief Time-into-interval published state structure, a copy of the owner state for lock-free readers.
+ */
+typedef struct time_into_interval_state_tag {
+    uint64_t                         epoch_timestamp;      /*!< time-into-interval state, next event unix epoch timestamp (UTC) in micro-seconds */
+    time_into_interval_event_t       event;                /*!< time-into-interval state, last event of the time-into-interval task delay */
+} time_into_interval_state_t;
+
+/**
+ * @brief Time-into-interval structure.  The task that owns the handle, calling `time_into_interval`
+ * or `time_into_interval_delay`, updates the state without a lock and publishes it to readers of
+ * any task through a double-buffered sequence, readers never block.
  */
 struct time_into_interval_t {
     const char*                      name;               /*!< time-into-interval, name, maximum of 25-characters */
-    uint64_t                         epoch_timestamp;    /*!< time-into-interval, next event unix epoch timestamp (UTC) in milli-seconds */
+    uint64_t                         epoch_timestamp;    /*!< time-into-interval, next event unix epoch timestamp (UTC) in micro-seconds */
     time_into_interval_types_t       interval_type;      /*!< time-into-interval, interval type setting */
     uint16_t                         interval_period;    /*!< time-into-interval, a non-zero interval period setting per interval type setting */
     uint16_t                         interval_offset;    /*!< time-into-interval, interval offset setting, per interval type setting, that must be less than the interval period */
     uint16_t                         hash_code;          /*!< hash-code of the time-into-interval handle */
-    SemaphoreHandle_t                mutex_handle;       /*!< mutex handle of the time-into-interval handle */
+    esp_timer_handle_t               timer_handle;       /*!< one-shot alarm timer of the time-into-interval task delay */
+    TaskHandle_t                     task_handle;        /*!< task notified by the alarm timer */
+    volatile bool                    alarm;              /*!< alarm timer elapsed, a notification from another source doesn't end the task delay */
+    time_into_interval_event_t       event;              /*!< last event of the time-into-interval task delay */
+    time_into_interval_state_t       state[2];           /*!< published states, the active state is indexed by the sequence parity */
+    volatile uint32_t                sequence;           /*!< published states sequence, incremented by the owner after writing the inactive state */
 };
 
 /**
@@ -100,7 +124,7 @@ typedef struct time_into_interval_t *time_into_interval_handle_t;
 // https://lloydrochester.com/post/c/c-timestamp-epoch/
 
 /**
- * @brief Normalizes time-into-interval period or offset to seconds.
+ * @brief Normalizes time-into-interval period or offset to seconds, sub-second intervals are truncated.
  * 
  * @param[in] interval_type Time-into-interval type of interval period or offset.
  * @param[in] interval Time-into-interval period or offset for interval type.
@@ -109,7 +133,7 @@ typedef struct time_into_interval_t *time_into_interval_handle_t;
 uint64_t time_into_interval_normalize_interval_to_sec(const time_into_interval_types_t interval_type, const uint16_t interval);
 
 /**
- * @brief Normalizes time-into-interval period or offset to milli-seconds.
+ * @brief Normalizes time-into-interval period or offset to milli-seconds, sub-milli-second intervals are truncated.
  * 
  * @param[in] interval_type Time-into-interval type of interval period or offset.
  * @param[in] interval Time-into-interval period or offset for interval type.
@@ -117,6 +141,15 @@ uint64_t time_into_interval_normalize_interval_to_sec(const time_into_interval_t
  */
 uint64_t time_into_interval_normalize_interval_to_msec(const time_into_interval_types_t interval_type, const uint16_t interval);
 
+/**
+ * @brief Normalizes time-into-interval period or offset to micro-seconds.
+ * 
+ * @param[in] interval_type Time-into-interval type of interval period or offset.
+ * @param[in] interval Time-into-interval period or offset for interval type.
+ * @return uint64_t Normalized time-into-interval period or offset in micro-seconds.
+ */
+uint64_t time_into_interval_normalize_interval_to_usec(const time_into_interval_types_t interval_type, const uint16_t interval);
+
 /**
  * @brief Gets unix epoch timestamp (UTC) in seconds from system clock.
  * 
@@ -142,24 +175,37 @@ uint64_t time_into_interval_get_epoch_timestamp_msec(void);
 uint64_t time_into_interval_get_epoch_timestamp_usec(void);
 
 /**
- * @brief Sets the next epoch event timestamp in milli-seconds from system clock based on 
+ * @brief Sets the next epoch event timestamp in micro-seconds from system clock based on 
  * the time interval type, period, and offset. 
  * 
  * The interval should be divisible by 60 i.e. no remainder if the interval type and period
  * is every 10-seconds, the event will trigger on-time with the system clock i.e. 09:00:00, 
- * 09:00:10, 09:00:20, etc.
+ * 09:00:10, 09:00:20, etc.  Sub-second intervals, milli-second and micro-second interval types,
+ * should divide 1-second i.e. every 20-milli-seconds triggers at 09:00:00.000, 09:00:00.020,
+ * 09:00:00.040, etc.
  * 
  * The interval offset is used to offset the start of the interval period.  If the interval type
  * and period is every 5-minutes with a 1-minute offset, the event will trigger on-time with the
  * system clock i.e. 09:01:00, 09:06:00, 09:11:00, etc.
  * 
+ * Interval boundaries are aligned to the local time second, minute, hour or day per the interval
+ * type and period.  The boundary is computed arithmetically from a cached local time offset from
+ * utc, the offset is recomputed once the system clock leaves its 15-minute utc span e.g. a dst
+ * transition or an sntp adjustment.  A non-zero `epoch_timestamp` is advanced by the interval period.
+ * 
  * @param[in] interval_type Data-logger time interval type.
  * @param[in] interval_period Data-logger time interval period for interval type.
  * @param[in] interval_offset Data-logger time interval offset for interval type.
- * @param[out] epoch_timestamp Unix epoch timestamp (UTC) of next event in milli-seconds.
+ * @param[out] epoch_timestamp Unix epoch timestamp (UTC) of next event in micro-seconds.
  */
 esp_err_t time_into_interval_set_epoch_timestamp_event(const time_into_interval_types_t interval_type, const uint16_t interval_period, const uint16_t interval_offset, uint64_t *epoch_timestamp);
 
+/**
+ * @brief Invalidates the cached local time offset from utc, call after the time zone, `TZ` environment 
+ * variable, is changed.  System clock adjustments and dst transitions refresh the offset on their own.
+ */
+void time_into_interval_refresh_utc_offset(void);
+
 /**
  * @brief Initializes a time-into-interval handle.  A time-into-interval is used 
  * within a FreeRTOS task subroutine for conditional or task delay based on the configured
@@ -198,13 +244,18 @@ bool time_into_interval(time_into_interval_handle_t time_into_interval_handle);
  * be placed after the `for (;;) {` syntax to delay the task based on the configured
  * interval type, period, and offset parameters.
  * 
+ * The task is woken up by a direct-to-task notification from a one-shot esp_timer alarm
+ * armed at the interval boundary in micro-seconds, the alarm is re-armed when the system
+ * clock was set back while waiting.  Interval boundaries that elapsed before the call are
+ * skipped and the task is woken up on the next boundary, see `time_into_interval_get_delay_event`.
+ * 
  * @param time_into_interval_handle Time-into-interval handle.
  * @return esp_err_t ESP_OK on success.
  */
 esp_err_t time_into_interval_delay(time_into_interval_handle_t time_into_interval_handle);
 
 /**
- * @brief Gets epoch timestamp (UTC) of the last event in milli-seconds.
+ * @brief Gets epoch timestamp (UTC) of the last event in milli-seconds, doesn't block.
  * 
  * @param time_into_interval_handle Time-into-interval handle.
  * @param epoch_timestamp Unix epoch timestamp (UTC) in milli-seconds of the last event.
@@ -212,6 +263,17 @@ esp_err_t time_into_interval_delay(time_into_interval_handle_t time_into_interva
  */
 esp_err_t time_into_interval_get_last_event(time_into_interval_handle_t time_into_interval_handle, uint64_t *epoch_timestamp);
 
+/**
+ * @brief Gets the event of the last time-into-interval task delay, the interval boundary
+ * in micro-seconds, the wake-up lateness and the number of skipped interval boundaries,
+ * doesn't block.
+ * 
+ * @param time_into_interval_handle Time-into-interval handle.
+ * @param event Time-into-interval event of the last task delay, zeroed before the first task delay.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t time_into_interval_get_delay_event(time_into_interval_handle_t time_into_interval_handle, time_into_interval_event_t *const event);
+
 /**
  * @brief Deletes the time-into-interval handle and frees up resources.
  * 
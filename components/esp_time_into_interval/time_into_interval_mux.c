@@ -0,0 +1,300 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file time_into_interval_mux.c
+ *
+ * ESP-IDF FreeRTOS task extension
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#include "time_into_interval_mux.h"
+#include <stdlib.h>
+#include <string.h>
+#include <esp_log.h>
+#include <esp_check.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/*
+ * macro definitions
+*/
+#define ESP_ARG_CHECK(VAL) do { if (!(VAL)) return ESP_ERR_INVALID_ARG; } while (0)
+
+/*
+* static constant declerations
+*/
+static const char *TAG = "time_into_interval_mux";
+
+/**
+ * @brief Alarm timer callback of the time-into-interval multiplexer, notifies the dispatching task.
+ *
+ * @param arg Time-into-interval multiplexer handle.
+ */
+static void time_into_interval_mux_alarm_callback(void *arg) {
+    time_into_interval_mux_handle_t mux_handle = (time_into_interval_mux_handle_t)arg;
+
+    mux_handle->alarm = true;
+    xTaskNotifyGive(mux_handle->task_handle);
+}
+
+/**
+ * @brief Compares the next events of two min-heap nodes, ties are ordered by add order.
+ *
+ * @param[in] mux_handle Time-into-interval multiplexer handle.
+ * @param[in] a Min-heap node.
+ * @param[in] b Min-heap node.
+ * @return true when the interval of node `a` is due before the interval of node `b`.
+ */
+static inline bool time_into_interval_mux_heap_less(time_into_interval_mux_handle_t mux_handle, const uint8_t a, const uint8_t b) {
+    const uint64_t a_epoch_timestamp = mux_handle->intervals[mux_handle->heap[a]].epoch_timestamp;
+    const uint64_t b_epoch_timestamp = mux_handle->intervals[mux_handle->heap[b]].epoch_timestamp;
+
+    return (a_epoch_timestamp < b_epoch_timestamp) || (a_epoch_timestamp == b_epoch_timestamp && mux_handle->heap[a] < mux_handle->heap[b]);
+}
+
+/**
+ * @brief Swaps two min-heap nodes.
+ *
+ * @param[in] mux_handle Time-into-interval multiplexer handle.
+ * @param[in] a Min-heap node.
+ * @param[in] b Min-heap node.
+ */
+static inline void time_into_interval_mux_heap_swap(time_into_interval_mux_handle_t mux_handle, const uint8_t a, const uint8_t b) {
+    const uint8_t index = mux_handle->heap[a];
+
+    mux_handle->heap[a] = mux_handle->heap[b];
+    mux_handle->heap[b] = index;
+}
+
+/**
+ * @brief Moves a min-heap node up until its parent is due before it.
+ *
+ * @param[in] mux_handle Time-into-interval multiplexer handle.
+ * @param[in] node Min-heap node.
+ */
+static inline void time_into_interval_mux_heap_sift_up(time_into_interval_mux_handle_t mux_handle, uint8_t node) {
+    while(node > 0) {
+        const uint8_t parent = (node - 1) / 2;
+        if(!time_into_interval_mux_heap_less(mux_handle, node, parent)) break;
+        time_into_interval_mux_heap_swap(mux_handle, node, parent);
+        node = parent;
+    }
+}
+
+/**
+ * @brief Moves a min-heap node down until it is due before its children.
+ *
+ * @param[in] mux_handle Time-into-interval multiplexer handle.
+ * @param[in] node Min-heap node.
+ */
+static inline void time_into_interval_mux_heap_sift_down(time_into_interval_mux_handle_t mux_handle, uint8_t node) {
+    for(;;) {
+        const uint8_t left  = 2 * node + 1;
+        const uint8_t right = left + 1;
+        uint8_t       least = node;
+
+        if(left < mux_handle->intervals_size && time_into_interval_mux_heap_less(mux_handle, left, least)) least = left;
+        if(right < mux_handle->intervals_size && time_into_interval_mux_heap_less(mux_handle, right, least)) least = right;
+        if(least == node) break;
+
+        time_into_interval_mux_heap_swap(mux_handle, node, least);
+        node = least;
+    }
+}
+
+/**
+ * @brief Resynchronizes the next event of every interval to the system clock and rebuilds the min-heap.
+ *
+ * @param[in] mux_handle Time-into-interval multiplexer handle.
+ */
+static inline void time_into_interval_mux_resync(time_into_interval_mux_handle_t mux_handle) {
+    for(uint8_t i = 0; i < mux_handle->intervals_size; i++) {
+        time_into_interval_mux_interval_t *interval = &mux_handle->intervals[i];
+
+        interval->epoch_timestamp = 0;
+        time_into_interval_set_epoch_timestamp_event(interval->config.interval_type, 
+                                                    interval->config.interval_period, 
+                                                    interval->config.interval_offset, 
+                                                    &interval->epoch_timestamp);
+    }
+
+    for(int16_t node = (int16_t)mux_handle->intervals_size / 2 - 1; node >= 0; node--) {
+        time_into_interval_mux_heap_sift_down(mux_handle, (uint8_t)node);
+    }
+}
+
+esp_err_t time_into_interval_mux_init(time_into_interval_mux_handle_t *mux_handle) {
+    esp_err_t                       ret = ESP_OK;
+    time_into_interval_mux_handle_t out_handle;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( mux_handle );
+
+    /* validate memory availability for time-into-interval multiplexer handle */
+    out_handle = (time_into_interval_mux_handle_t)calloc(1, sizeof(time_into_interval_mux_t));
+    ESP_GOTO_ON_FALSE( out_handle, ESP_ERR_NO_MEM, err, TAG, "no memory for time-into-interval multiplexer handle, time-into-interval multiplexer handle initialization failed" );
+
+    /* create the one-shot alarm timer of the earliest next event */
+    const esp_timer_create_args_t timer_args = {
+        .callback           = time_into_interval_mux_alarm_callback,
+        .arg                = out_handle,
+        .dispatch_method    = ESP_TIMER_TASK,
+        .name               = "tii_mux",
+    };
+    ESP_GOTO_ON_ERROR( esp_timer_create(&timer_args, &out_handle->timer_handle), err_out_handle, TAG, "unable to create alarm timer, time-into-interval multiplexer handle initialization failed" );
+
+    /* set output handle */
+    *mux_handle = out_handle;
+
+    return ESP_OK;
+
+    err_out_handle:
+        free(out_handle);
+    err:
+        return ret;
+}
+
+esp_err_t time_into_interval_mux_add_interval(time_into_interval_mux_handle_t mux_handle,
+                                    const time_into_interval_mux_interval_config_t *interval_config,
+                                    uint8_t *const interval_index) {
+    /* validate arguments */
+    ESP_ARG_CHECK( mux_handle && interval_config && interval_config->callback );
+
+    /* validate interval capacity */
+    ESP_RETURN_ON_FALSE( mux_handle->intervals_size < TIME_INTO_INTERVAL_MUX_INTERVALS_MAX, ESP_ERR_NO_MEM, TAG, "time-into-interval multiplexer is full, add interval failed" );
+
+    /* copy configuration and set epoch timestamp of the first event, validates the interval period and offset */
+    const uint8_t index = mux_handle->intervals_size;
+    time_into_interval_mux_interval_t *interval = &mux_handle->intervals[index];
+    memset(interval, 0, sizeof(time_into_interval_mux_interval_t));
+    interval->config      = *interval_config;
+    interval->period_usec = time_into_interval_normalize_interval_to_usec(interval_config->interval_type, interval_config->interval_period);
+    interval->offset_usec = time_into_interval_normalize_interval_to_usec(interval_config->interval_type, interval_config->interval_offset);
+    ESP_RETURN_ON_ERROR( time_into_interval_set_epoch_timestamp_event(interval_config->interval_type, 
+                                                            interval_config->interval_period, 
+                                                            interval_config->interval_offset, 
+                                                            &interval->epoch_timestamp), 
+                                                            TAG, "unable to set epoch timestamp, add interval failed" );
+
+    /* push the interval on the min-heap */
+    mux_handle->heap[index] = index;
+    mux_handle->intervals_size++;
+    time_into_interval_mux_heap_sift_up(mux_handle, index);
+
+    /* set output index */
+    if(interval_index) *interval_index = index;
+
+    return ESP_OK;
+}
+
+esp_err_t time_into_interval_mux_dispatch(time_into_interval_mux_handle_t mux_handle) {
+    esp_err_t                           ret = ESP_OK;
+    time_into_interval_mux_interval_t  *interval;
+
+    /* validate arguments */
+    ESP_ARG_CHECK( mux_handle );
+
+    /* validate intervals */
+    ESP_RETURN_ON_FALSE( mux_handle->intervals_size > 0, ESP_ERR_INVALID_STATE, TAG, "time-into-interval multiplexer has no intervals, dispatch failed" );
+
+    // get system unix epoch timestamp (UTC) and the interval with the earliest next event
+    uint64_t now_unix_usec = time_into_interval_get_epoch_timestamp_usec();
+    interval = &mux_handle->intervals[mux_handle->heap[0]];
+
+    /* the alarm timer runs on the monotonic clock, re-arm the alarm when the system clock was set back while waiting */
+    mux_handle->task_handle = xTaskGetCurrentTaskHandle();
+    for(;;) {
+        // the system clock was set back, before or while waiting, resynchronize the next event of every interval
+        if(interval->epoch_timestamp > now_unix_usec + interval->period_usec + interval->offset_usec) {
+            time_into_interval_mux_resync(mux_handle);
+            interval = &mux_handle->intervals[mux_handle->heap[0]];
+        }
+
+        // validate the earliest next event is due
+        if(now_unix_usec >= interval->epoch_timestamp) break;
+
+        mux_handle->alarm = false;
+
+        // arm the alarm timer on the earliest next event
+        ESP_GOTO_ON_ERROR( esp_timer_start_once(mux_handle->timer_handle, interval->epoch_timestamp - now_unix_usec), err, TAG, "unable to start alarm timer, time-into-interval multiplexer dispatch failed" );
+
+        // wait for the alarm timer notification
+        while(mux_handle->alarm == false) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+
+        now_unix_usec = time_into_interval_get_epoch_timestamp_usec();
+    }
+
+    /* dispatch the due intervals in next event order */
+    while(interval->epoch_timestamp <= now_unix_usec) {
+        // interval boundaries that elapsed after the event are skipped
+        const uint64_t elapsed_events = (now_unix_usec - interval->epoch_timestamp) / interval->period_usec;
+
+        interval->event.epoch_timestamp_usec = interval->epoch_timestamp;
+        interval->event.lateness_usec        = (int64_t)(now_unix_usec - interval->epoch_timestamp);
+        interval->event.skipped_events       = (elapsed_events > UINT32_MAX) ? UINT32_MAX : (uint32_t)elapsed_events;
+
+        // set the next event on the interval boundaries and restore the min-heap before the callback
+        interval->epoch_timestamp += (elapsed_events + 1U) * interval->period_usec;
+        time_into_interval_mux_heap_sift_down(mux_handle, 0);
+
+        interval->config.callback(interval->config.callback_ctx, &interval->event);
+
+        now_unix_usec = time_into_interval_get_epoch_timestamp_usec();
+        interval = &mux_handle->intervals[mux_handle->heap[0]];
+    }
+
+    return ESP_OK;
+
+    err:
+        return ret;
+}
+
+esp_err_t time_into_interval_mux_get_event(time_into_interval_mux_handle_t mux_handle,
+                                    const uint8_t interval_index,
+                                    time_into_interval_event_t *const event) {
+    /* validate arguments */
+    ESP_ARG_CHECK( mux_handle && event && interval_index < mux_handle->intervals_size );
+
+    /* copy last dispatched event of the interval */
+    *event = mux_handle->intervals[interval_index].event;
+
+    return ESP_OK;
+}
+
+esp_err_t time_into_interval_mux_del(time_into_interval_mux_handle_t mux_handle) {
+    /* validate arguments */
+    ESP_ARG_CHECK( mux_handle );
+
+    /* free resource */
+    esp_timer_stop(mux_handle->timer_handle);
+    esp_timer_delete(mux_handle->timer_handle);
+    free(mux_handle);
+
+    return ESP_OK;
+}
@@ -0,0 +1,178 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file time_into_interval_mux.h
+ * @defgroup FreeRTOS task extension
+ * @{
+ *
+ * ESP-IDF FreeRTOS task extension
+ *
+ * Multiplexes many time-into-interval schedules on a single task.  Intervals are
+ * registered with a callback and kept in a min-heap ordered by their next event,
+ * the task sleeps on one esp_timer alarm until the earliest event and dispatches
+ * the callbacks of every due interval.
+ *
+ * Copyright (c) 2024 Eric Gionet (gionet.c.eric@gmail.com)
+ *
+ * MIT Licensed as described in the file LICENSE
+ */
+#ifndef __TIME_INTO_INTERVAL_MUX_H__
+#define __TIME_INTO_INTERVAL_MUX_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+#include <esp_timer.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "time_into_interval.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Time-into-interval multiplexer definitions.
+ */
+#define TIME_INTO_INTERVAL_MUX_INTERVALS_MAX    (16)    /*!< maximum number of intervals per multiplexer */
+
+/**
+ * @brief Time-into-interval multiplexer callback function, invoked from the dispatching
+ * task on every event of the interval.
+ *
+ * @param callback_ctx Callback context of the interval configuration.
+ * @param event Time-into-interval event, the interval boundary, lateness and skipped interval boundaries.
+ */
+typedef void (*time_into_interval_mux_callback_t)(void *callback_ctx, const time_into_interval_event_t *event);
+
+/**
+ * @brief Time-into-interval multiplexer interval configuration structure.
+ */
+typedef struct time_into_interval_mux_interval_config_tag {
+    const char*                         name;               /*!< interval name for logging */
+    time_into_interval_types_t          interval_type;      /*!< interval type setting */
+    uint16_t                            interval_period;    /*!< a non-zero interval period setting per interval type setting */
+    uint16_t                            interval_offset;    /*!< interval offset setting, per interval type setting, that must be less than the interval period */
+    time_into_interval_mux_callback_t   callback;           /*!< callback function invoked on every event of the interval */
+    void*                               callback_ctx;       /*!< callback context passed to the callback function */
+} time_into_interval_mux_interval_config_t;
+
+/**
+ * @brief Time-into-interval multiplexer interval structure.
+ */
+typedef struct time_into_interval_mux_interval_tag {
+    time_into_interval_mux_interval_config_t    config;             /*!< interval configuration */
+    uint64_t                                    period_usec;        /*!< interval period in micro-seconds */
+    uint64_t                                    offset_usec;        /*!< interval offset in micro-seconds */
+    uint64_t                                    epoch_timestamp;    /*!< next event unix epoch timestamp (UTC) in micro-seconds, the min-heap key */
+    time_into_interval_event_t                  event;              /*!< last dispatched event of the interval */
+} time_into_interval_mux_interval_t;
+
+/**
+ * @brief Time-into-interval multiplexer structure.
+ */
+struct time_into_interval_mux_t {
+    time_into_interval_mux_interval_t   intervals[TIME_INTO_INTERVAL_MUX_INTERVALS_MAX];    /*!< intervals in add order */
+    uint8_t                             heap[TIME_INTO_INTERVAL_MUX_INTERVALS_MAX];         /*!< min-heap of interval indexes by next event, ties in add order */
+    uint8_t                             intervals_size;                                     /*!< number of intervals */
+    esp_timer_handle_t                  timer_handle;                                       /*!< one-shot alarm timer of the earliest next event */
+    TaskHandle_t                        task_handle;                                        /*!< dispatching task notified by the alarm timer */
+    volatile bool                       alarm;                                              /*!< alarm timer elapsed, a notification from another source doesn't end the wait */
+};
+
+/**
+ * @brief Time-into-interval multiplexer type definition.
+ */
+typedef struct time_into_interval_mux_t time_into_interval_mux_t;
+
+/**
+ * @brief Time-into-interval multiplexer handle definition.
+ */
+typedef struct time_into_interval_mux_t *time_into_interval_mux_handle_t;
+
+/**
+ * @brief Initializes a time-into-interval multiplexer handle without intervals.
+ *
+ * @param[out] mux_handle Time-into-interval multiplexer handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t time_into_interval_mux_init(time_into_interval_mux_handle_t *mux_handle);
+
+/**
+ * @brief Adds an interval to a time-into-interval multiplexer, the first event is the
+ * next interval boundary synchronized to the system clock, see `time_into_interval_init`.
+ * Intervals are added before dispatching or from a callback of the dispatching task.
+ *
+ * @param[in] mux_handle Time-into-interval multiplexer handle.
+ * @param[in] interval_config Interval configuration.
+ * @param[out] interval_index Index of the interval, NULL when not required.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM when `TIME_INTO_INTERVAL_MUX_INTERVALS_MAX` intervals are added.
+ */
+esp_err_t time_into_interval_mux_add_interval(time_into_interval_mux_handle_t mux_handle,
+                                    const time_into_interval_mux_interval_config_t *interval_config,
+                                    uint8_t *const interval_index);
+
+/**
+ * @brief Delays the task until the earliest next event of the intervals and invokes the
+ * callbacks of every due interval in next event order.  This function should be the body
+ * of the `for (;;) {` task loop of the dispatching task.
+ *
+ * The task is woken up by a direct-to-task notification from a one-shot esp_timer alarm,
+ * interval boundaries that elapsed while the task was busy are skipped and reported in
+ * the event of the interval.
+ *
+ * @param[in] mux_handle Time-into-interval multiplexer handle.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when no interval is added.
+ */
+esp_err_t time_into_interval_mux_dispatch(time_into_interval_mux_handle_t mux_handle);
+
+/**
+ * @brief Gets the last dispatched event of an interval.
+ *
+ * @param[in] mux_handle Time-into-interval multiplexer handle.
+ * @param[in] interval_index Index of the interval.
+ * @param[out] event Time-into-interval event, zeroed before the first event.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t time_into_interval_mux_get_event(time_into_interval_mux_handle_t mux_handle,
+                                    const uint8_t interval_index,
+                                    time_into_interval_event_t *const event);
+
+/**
+ * @brief Deletes the time-into-interval multiplexer handle and frees up resources.
+ *
+ * @param[in] mux_handle Time-into-interval multiplexer handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t time_into_interval_mux_del(time_into_interval_mux_handle_t mux_handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif  // __TIME_INTO_INTERVAL_MUX_H__
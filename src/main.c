@@ -67,21 +67,30 @@
 
 /* components */
 #include <time_into_interval.h>
+#include <time_into_interval_mux.h>
 #include <scalar_trend.h>
 #include <pressure_tendency.h>
 #include <bmp280.h>
 #include <ahtxx.h>
+#include <i2c_bus_scheduler.h>
 #include <nvs_ext.h>
+#include <machbase_row.h>
 
 
 /**
  * @brief MQTT definitions
  */
 
-#define MQTT_PUB_ENV_QUEUE_SIZE                 (30)                        /*!< environmental queue size for MQTT publshing */
+#define MQTT_PUB_ENV_QUEUE_BYTES                (1024)                      /*!< environmental queue size in bytes for MQTT publshing */
+#define MQTT_PUB_ENV_QUEUE_SIZE                 (MQTT_PUB_ENV_QUEUE_BYTES / sizeof(environmental_sample_t)) /*!< environmental queue size in samples for MQTT publshing */
 #define MQTT_PUB_ENV                            "db/append/ENVIRONMENTAL" /*!< environmental for MQTT publshing topic */
+#define MQTT_PUB_DIAG                           "db/append/DIAGNOSTICS"   /*!< device diagnostics for MQTT publshing topic, kept apart from the environmental samples */
 #define MQTT_NET_DEVICE_ID                      "CA.NB.AWS.01-1000"         /*!< unique network device identifier (max 50-chars) */
-#define MQTT_PUB_MSG_BUFFER_SIZE                (200)                       /*!< buffer size for publishing MQTT messages */   
+#define MQTT_PUB_BATCH_SAMPLES_MAX              (8)                         /*!< batch flushed once it holds this many samples, 8 samples per sampling tick */
+#define MQTT_PUB_BATCH_BUFFER_SIZE              (2048)                      /*!< batch flushed before a sample would overflow this many bytes */
+#define MQTT_PUB_BATCH_AGE_MAX_MS               (10000)                     /*!< batch flushed once its oldest sample was queued this many milli-seconds ago */
+#define MQTT_PUB_I2C_STATS_ENABLED              (1)                         /*!< publish hourly i2c device statistics, 0 to log them only */
+#define MQTT_PUB_I2C_STATS_BUFFER_SIZE          (2560)                      /*!< i2c device statistics payload size in bytes, one message per device */
 
 /**
  * @brief FreeRTOS definitions
@@ -123,6 +132,7 @@ typedef enum sample_parameters_tag {
     SAMPLE_ATMOSPHERIC_PRESSURE_TENDENCY,   /*!< Atmospheric pressure tendency (code)*/
     SAMPLE_ATMOSPHERIC_PRESSURE_CHANGE,     /*!< Atmospheric pressure tendency change */
     SAMPLE_ATMOSPHERIC_PRESSURE_TREND,      /*!< Atmospheric pressure trend (code)*/
+    SAMPLE_PARAMETERS_MAX                   /*!< Number of sample parameters */
 } sample_parameters_t;
 
 typedef enum atm_pressure_tendencies_tag {                  /*!< 3-hr Change */
@@ -138,11 +148,12 @@ typedef enum atm_pressure_tendencies_tag {                  /*!< 3-hr Change */
 
 /**
  * @brief Environmental sample structure.  A basic data model to 
- * transmit and receive environmental sample as a queued item.
+ * transmit and receive environmental sample as a queued item.  Samples 
+ * are queued by value, the queue holds a copy of the sample record.
  */
 typedef struct environmental_sample_tag {
-    const char*             device_id;      /*!< unique network device identifier */
     uint64_t                timestamp;      /*!< sample time-stamp in nano-seconds */
+    uint32_t                sequence;       /*!< sample record sequence number, increments by one per queued record */
     sample_parameters_t     parameter;      /*!< sample parameter */
     float                   value;          /*!< sample value */
 } environmental_sample_t;
@@ -154,6 +165,37 @@ typedef struct system_state_tag {
     uint64_t    system_uptime;          /*!< up-time in seconds since system restart */
 } system_state_t;
 
+/**
+ * @brief MQTT publishing batch structure.  Samples are appended as rows 
+ * to a JSON array-of-arrays payload for the MACHBASE append topic.  Rows 
+ * are serialized from templates precomputed per sample parameter.
+ */
+typedef struct mqtt_pub_batch_tag {
+    machbase_row_template_t row_templates[SAMPLE_PARAMETERS_MAX];   /*!< row templates of the network device by sample parameter */
+    char                    payload[MQTT_PUB_BATCH_BUFFER_SIZE];    /*!< batch payload buffer */
+    size_t                  payload_len;    /*!< batch payload length in bytes, excluding the closing bracket */
+    uint16_t                samples_count;  /*!< number of samples in the batch */
+    TickType_t              created_ticks;  /*!< tick count when the first sample was appended to the batch */
+} mqtt_pub_batch_t;
+
+/**
+ * @brief Sensors sampling structure.  The device handles and measurements of a 
+ * sampling cycle, the device context of the i2c bus scheduler device steps and 
+ * of the i2c recovery operations.
+ */
+typedef struct sensors_sampling_tag {
+    i2c_master_bus_handle_t    bus_hdl;               /*!< i2c master bus handle of the devices */
+    const i2c_bmp280_config_t *bmp280_dev_cfg;        /*!< bmp280 device configuration */
+    const i2c_ahtxx_config_t  *ahtxx_dev_cfg;         /*!< ahtxx device configuration */
+    i2c_bmp280_handle_t        bmp280_dev_hdl;        /*!< bmp280 device handle */
+    i2c_ahtxx_handle_t         ahtxx_dev_hdl;         /*!< ahtxx device handle, NULL when a bme280 device samples humidity */
+    float                      bmp280_temperature;    /*!< bmp280 air temperature in degrees celsius */
+    float                      bmp280_pressure;       /*!< bmp280 atmospheric pressure in pascal */
+    float                      bmp280_humidity;       /*!< bme280 relative humidity in percent */
+    float                      ahtxx_temperature;     /*!< ahtxx air temperature in degrees celsius */
+    float                      ahtxx_humidity;        /*!< ahtxx relative humidity in percent */
+} sensors_sampling_t;
+
 /**
  * @brief static constant and global definitions
  */
@@ -174,7 +216,19 @@ static system_state_t  *s_system_state                  = NULL;
 
 static inline uint32_t print_free_heap_size(const uint32_t free_heap_size_last);
 static inline const char* sample_parameter_to_string(const sample_parameters_t type);
-static inline environmental_sample_t* create_sample(const char* device_id, sample_parameters_t type);
+static inline environmental_sample_t create_sample(sample_parameters_t type);
+static inline void queue_sample(environmental_sample_t *const sample, uint32_t *const sequence);
+static inline void publish_batch(mqtt_pub_batch_t *const batch);
+static inline void append_batch(mqtt_pub_batch_t *const batch, const environmental_sample_t *const sample);
+static esp_err_t bmp280_sampling_step(void *device_ctx, const uint32_t step, uint32_t *const delay_us);
+static esp_err_t ahtxx_sampling_step(void *device_ctx, const uint32_t step, uint32_t *const delay_us);
+static esp_err_t bmp280_init_operation(void *op_ctx);
+static esp_err_t ahtxx_init_operation(void *op_ctx);
+static esp_err_t bmp280_sampling_operation(void *op_ctx);
+static esp_err_t ahtxx_sampling_operation(void *op_ctx);
+static esp_err_t bmp280_reinit(void *device_ctx);
+static esp_err_t ahtxx_reinit(void *device_ctx);
+static inline void publish_i2c_stats(const uint64_t timestamp);
 
 /**
  * @brief static function and subroutine definitions
@@ -237,24 +291,180 @@ static inline const char* sample_parameter_to_string(const sample_parameters_t t
 
 
 /**
- * @brief Creates a sample instance by device identifier, parameter type, statistical type, and statistical interval.
+ * @brief Creates a sample record by parameter type.
  * 
- * @param device_id Unique device identifier.
  * @param type Sample parameter type.
- * @param stat_type Statistical processing type.
- * @param stat_interval Statistical processing interval.
- * @return environmental_sample_t* Sample pointer instance.
- */
-static inline environmental_sample_t* create_sample(const char* device_id, sample_parameters_t parameter) {
-    environmental_sample_t* sample = (environmental_sample_t*)calloc(1, sizeof(environmental_sample_t));
-    if(!sample) return NULL;
-    sample->device_id     = device_id;
-    sample->parameter     = parameter;
-    sample->timestamp     = 0;
-    sample->value         = NAN;
+ * @return environmental_sample_t Sample record.
+ */
+static inline environmental_sample_t create_sample(sample_parameters_t parameter) {
+    environmental_sample_t sample = {
+        .timestamp      = 0,
+        .sequence       = 0,
+        .parameter      = parameter,
+        .value          = NAN
+    };
     return sample;
 }
 
+/**
+ * @brief Stamps a sample record with the next sequence number and queues a copy 
+ * of the record for publishing.  The sequence number is consumed even when the 
+ * queue is full, the publisher reports the gap as dropped samples.
+ * 
+ * @param sample Sample record.
+ * @param sequence Sample record sequence counter.
+ */
+static inline void queue_sample(environmental_sample_t *const sample, uint32_t *const sequence) {
+    sample->sequence = (*sequence)++;
+
+    /* attempt to queue a copy of the sample record */
+    if(xQueueSend(s_mqtt_pub_env_queue_hdl, (void *)sample, (TickType_t)0) != pdTRUE) {
+        ESP_LOGE(TAG, "Unable to Send Publish Environmental %s Sample Queue", sample_parameter_to_string(sample->parameter));
+    }
+}
+
+/**
+ * @brief Publishes the batch payload to the MQTT broker when it holds 
+ * samples and empties the batch.
+ * 
+ * @param batch MQTT publishing batch.
+ */
+static inline void publish_batch(mqtt_pub_batch_t *const batch) {
+    if(batch->samples_count == 0) return;
+
+    /* close the array-of-arrays payload */
+    batch->payload[batch->payload_len++] = ']';
+
+    /* publish batch message */
+    esp_mqtt_client_publish(mqtt_client_hdl, MQTT_PUB_ENV, (const char *)batch->payload, batch->payload_len, 0, 0);
+
+    /* empty batch */
+    batch->payload_len   = 0;
+    batch->samples_count = 0;
+}
+
+/**
+ * @brief Appends a sample row to the batch payload.  The batch is published 
+ * beforehand when the row would overflow the payload buffer, and afterwards 
+ * when the batch reaches `MQTT_PUB_BATCH_SAMPLES_MAX` samples.
+ * 
+ * @param batch MQTT publishing batch.
+ * @param sample Sample record.
+ */
+static inline void append_batch(mqtt_pub_batch_t *const batch, const environmental_sample_t *const sample) {
+    const machbase_row_template_t *row_template = &batch->row_templates[sample->parameter];
+
+    /* 
+        serialize mqtt row from sample item received from the queue, reserving the separator and closing bracket
+        sample: ["ca-nb-aws-01-1000.Air-Temperature",1729957661187888000,1002.928162,"Air-Temperature", "ca-nb-aws-01-1000"] 
+    */
+    size_t row_size = (batch->payload_len + 2 < MQTT_PUB_BATCH_BUFFER_SIZE) ? MQTT_PUB_BATCH_BUFFER_SIZE - batch->payload_len - 2 : 0;
+    size_t row_len  = machbase_row_serialize(row_template, sample->timestamp, sample->value, 
+                                            batch->payload + batch->payload_len + 1, row_size);
+
+    /* flush when the row would overflow the payload and serialize into the emptied payload */
+    if(row_len == 0 && batch->samples_count > 0) {
+        publish_batch(batch);
+        row_len = machbase_row_serialize(row_template, sample->timestamp, sample->value, 
+                                        batch->payload + 1, MQTT_PUB_BATCH_BUFFER_SIZE - 2);
+    }
+    if(row_len == 0) {
+        ESP_LOGE(TAG, "Unable to serialize Publish Environmental %s Sample", sample_parameter_to_string(sample->parameter));
+        return;
+    }
+
+    /* open the array-of-arrays payload or separate rows */
+    if(batch->samples_count == 0) {
+        batch->payload[batch->payload_len] = '[';
+        batch->created_ticks = xTaskGetTickCount();
+    } else {
+        batch->payload[batch->payload_len] = ',';
+    }
+
+    batch->payload_len += row_len + 1;
+    batch->samples_count++;
+
+    /* flush by count */
+    if(batch->samples_count >= MQTT_PUB_BATCH_SAMPLES_MAX) publish_batch(batch);
+}
+
+/**
+ * @brief Appends a row of a device statistic to an i2c statistics payload, the 
+ * row is dropped when it would overflow the payload buffer.
+ * 
+ * @param payload Payload buffer of `MQTT_PUB_I2C_STATS_BUFFER_SIZE` bytes.
+ * @param payload_len Payload length in bytes, excluding the closing bracket.
+ * @param device_address I2C device address of the statistic.
+ * @param statistic Statistic name.
+ * @param timestamp Time-stamp in nano-seconds.
+ * @param value Statistic value.
+ */
+static inline void append_i2c_stats_row(char *const payload, size_t *const payload_len, const uint16_t device_address, 
+                                        const char *const statistic, const uint64_t timestamp, const float value) {
+    machbase_row_template_t row_template;
+    char                    parameter[32];
+
+    snprintf(parameter, sizeof(parameter), "I2C-0x%02x-%s", device_address, statistic);
+    if(machbase_row_template_init(MQTT_NET_DEVICE_ID, parameter, &row_template) != ESP_OK) return;
+
+    /* reserve the separator and closing bracket */
+    size_t row_size = (*payload_len + 2 < MQTT_PUB_I2C_STATS_BUFFER_SIZE) ? MQTT_PUB_I2C_STATS_BUFFER_SIZE - *payload_len - 2 : 0;
+    size_t row_len  = machbase_row_serialize(&row_template, timestamp, value, payload + *payload_len + 1, row_size);
+    if(row_len == 0) return;
+
+    /* open the array-of-arrays payload or separate rows */
+    payload[*payload_len] = (*payload_len == 0) ? '[' : ',';
+    *payload_len += row_len + 1;
+}
+
+/**
+ * @brief Logs, and publishes to the diagnostics topic when `MQTT_PUB_I2C_STATS_ENABLED`, 
+ * the i2c device statistics since the last call and resets them.  Each device is published 
+ * as one message of its counters, mean and maximum latency, and latency histogram.
+ * 
+ * @param timestamp Time-stamp in nano-seconds.
+ */
+static inline void publish_i2c_stats(const uint64_t timestamp) {
+    static char         payload[MQTT_PUB_I2C_STATS_BUFFER_SIZE];
+    i2c_master_stats_t  stats[I2C_STATS_DEVICES_MAX];
+    uint8_t             stats_size = 0;
+    char                statistic[24];
+
+    if(i2c_master_stats_get_all_and_reset(stats, &stats_size) != ESP_OK) return;
+
+    for(uint8_t i = 0; i < stats_size; i++) {
+        const i2c_master_stats_t *device = &stats[i];
+        const float latency_mean_us = (device->transactions > 0) ? (float)device->latency_sum_us / (float)device->transactions : NAN;
+        size_t payload_len = 0;
+
+        ESP_LOGI(TAG, "I2C 0x%02x Statistics:        %" PRIu32 " transactions, %" PRIu32 " bytes, %" PRIu32 " nacks, %" PRIu32 " timeouts, %" PRIu32 " retries, %.0f/%" PRIu32 " us mean/max latency", 
+                device->device_address, device->transactions, device->bytes, device->nacks, device->timeouts, device->retries, latency_mean_us, device->latency_max_us);
+
+        if(MQTT_PUB_I2C_STATS_ENABLED == 0) continue;
+
+        append_i2c_stats_row(payload, &payload_len, device->device_address, "Transactions", timestamp, (float)device->transactions);
+        append_i2c_stats_row(payload, &payload_len, device->device_address, "Bytes", timestamp, (float)device->bytes);
+        append_i2c_stats_row(payload, &payload_len, device->device_address, "NACKs", timestamp, (float)device->nacks);
+        append_i2c_stats_row(payload, &payload_len, device->device_address, "Timeouts", timestamp, (float)device->timeouts);
+        append_i2c_stats_row(payload, &payload_len, device->device_address, "Retries", timestamp, (float)device->retries);
+        append_i2c_stats_row(payload, &payload_len, device->device_address, "Latency-Mean", timestamp, latency_mean_us);
+        append_i2c_stats_row(payload, &payload_len, device->device_address, "Latency-Max", timestamp, (float)device->latency_max_us);
+        for(uint8_t b = 0; b < I2C_STATS_LATENCY_BUCKETS; b++) {
+            if(b < I2C_STATS_LATENCY_BUCKETS - 1) {
+                snprintf(statistic, sizeof(statistic), "Latency-LT%" PRIu32 "us", I2C_STATS_LATENCY_BUCKET_US(b));
+            } else {
+                snprintf(statistic, sizeof(statistic), "Latency-GE%" PRIu32 "us", I2C_STATS_LATENCY_BUCKET_US(b - 1));
+            }
+            append_i2c_stats_row(payload, &payload_len, device->device_address, statistic, timestamp, (float)device->latency_hist[b]);
+        }
+
+        if(payload_len == 0) continue;
+
+        /* close the array-of-arrays payload and publish the device message */
+        payload[payload_len++] = ']';
+        esp_mqtt_client_publish(mqtt_client_hdl, MQTT_PUB_DIAG, (const char *)payload, payload_len, 0, 0);
+    }
+}
 
 static inline esp_err_t nvs_write_system_state(system_state_t *system_state) {
     esp_err_t ret = nvs_write_struct("system_state", system_state, sizeof(system_state_t));
@@ -292,6 +502,128 @@ static inline void init_system_state(void) {
 
 }
 
+/**
+ * @brief I2C bus scheduler step of the bmp280 device, starts a forced measurement 
+ * and reads it once the maximum measurement time has elapsed.
+ * 
+ * @param device_ctx Sensors sampling.
+ * @param step Step number.
+ * @param delay_us Minimum delay before the next step in micro-seconds.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t bmp280_sampling_step(void *device_ctx, const uint32_t step, uint32_t *const delay_us) {
+    sensors_sampling_t *sampling = (sensors_sampling_t*)device_ctx;
+
+    /* trigger bmp280 device conversion, the other devices are sampled during the conversion */
+    if(step == 0) {
+        return i2c_bmp280_start_forced_measurement(sampling->bmp280_dev_hdl, delay_us);
+    }
+
+    /* read bmp280 device measurements, a bme280 device reads humidity in the same burst read */
+    *delay_us = I2C_BUS_SCHEDULER_STEP_DONE;
+    return i2c_bmp280_wait_forced_measurements(sampling->bmp280_dev_hdl, &sampling->bmp280_temperature, &sampling->bmp280_pressure,
+                                                (sampling->ahtxx_dev_hdl == NULL) ? &sampling->bmp280_humidity : NULL);
+}
+
+/**
+ * @brief I2C bus scheduler step of the ahtxx device, starts a measurement and polls 
+ * the busy bit once per tick once the typical conversion time has elapsed.
+ * 
+ * @param device_ctx Sensors sampling.
+ * @param step Step number.
+ * @param delay_us Minimum delay before the next step in micro-seconds.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ahtxx_sampling_step(void *device_ctx, const uint32_t step, uint32_t *const delay_us) {
+    sensors_sampling_t *sampling = (sensors_sampling_t*)device_ctx;
+    bool                ready    = false;
+
+    /* trigger ahtxx device conversion */
+    if(step == 0) {
+        *delay_us = I2C_AHTXX_MEASUREMENT_TIME_US;
+        return i2c_ahtxx_start_measurement(sampling->ahtxx_dev_hdl);
+    }
+
+    /* read ahtxx device measurements when ready, otherwise poll again after the next tick */
+    ESP_RETURN_ON_ERROR( i2c_ahtxx_read_if_ready(sampling->ahtxx_dev_hdl, &ready, &sampling->ahtxx_temperature, &sampling->ahtxx_humidity), TAG, "ahtxx read if ready failed" );
+    *delay_us = (ready == true) ? I2C_BUS_SCHEDULER_STEP_DONE : I2C_BUS_SCHEDULER_STEP_POLL;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief I2C recovery operation of the bmp280 device initialization.
+ * 
+ * @param op_ctx Sensors sampling.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t bmp280_init_operation(void *op_ctx) {
+    sensors_sampling_t *sampling = (sensors_sampling_t*)op_ctx;
+
+    return i2c_bmp280_init(sampling->bus_hdl, sampling->bmp280_dev_cfg, &sampling->bmp280_dev_hdl);
+}
+
+/**
+ * @brief I2C recovery operation of the ahtxx device initialization.
+ * 
+ * @param op_ctx Sensors sampling.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ahtxx_init_operation(void *op_ctx) {
+    sensors_sampling_t *sampling = (sensors_sampling_t*)op_ctx;
+
+    return i2c_ahtxx_init(sampling->bus_hdl, sampling->ahtxx_dev_cfg, &sampling->ahtxx_dev_hdl);
+}
+
+/**
+ * @brief I2C recovery operation of the bmp280 device sampling, a blocking forced 
+ * measurement that retries a failed scheduled request.
+ * 
+ * @param op_ctx Sensors sampling.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t bmp280_sampling_operation(void *op_ctx) {
+    sensors_sampling_t *sampling = (sensors_sampling_t*)op_ctx;
+
+    ESP_RETURN_ON_ERROR( i2c_bmp280_start_forced_measurement(sampling->bmp280_dev_hdl, NULL), TAG, "bmp280 start forced measurement failed" );
+
+    return i2c_bmp280_wait_forced_measurements(sampling->bmp280_dev_hdl, &sampling->bmp280_temperature, &sampling->bmp280_pressure,
+                                                (sampling->ahtxx_dev_hdl == NULL) ? &sampling->bmp280_humidity : NULL);
+}
+
+/**
+ * @brief I2C recovery operation of the ahtxx device sampling, a blocking measurement 
+ * that retries a failed scheduled request.
+ * 
+ * @param op_ctx Sensors sampling.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ahtxx_sampling_operation(void *op_ctx) {
+    sensors_sampling_t *sampling = (sensors_sampling_t*)op_ctx;
+
+    return i2c_ahtxx_get_measurement(sampling->ahtxx_dev_hdl, &sampling->ahtxx_temperature, &sampling->ahtxx_humidity);
+}
+
+/**
+ * @brief I2C recovery re-initialization hook of the bmp280 device.
+ * 
+ * @param device_ctx bmp280 device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t bmp280_reinit(void *device_ctx) {
+    return i2c_bmp280_reinit((i2c_bmp280_handle_t)device_ctx);
+}
+
+/**
+ * @brief I2C recovery re-initialization hook of the ahtxx device.
+ * 
+ * @param device_ctx ahtxx device handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t ahtxx_reinit(void *device_ctx) {
+    return i2c_ahtxx_reinit((i2c_ahtxx_handle_t)device_ctx);
+}
+
 /**
  * @brief Task that sends a sensor sample item to the MQTT sensor 
  * sampling queue every 60-seconds once MQTT client is connected.
@@ -303,43 +635,64 @@ static void sample_sensor_task( void *pvParameters ) {
     pressure_tendency_codes_t   pa_tendency_code;
     scalar_trend_codes_t        ta_trend_code;
     uint64_t                    epoch_timestamp;
+    uint32_t                    sample_sequence = 0;
     esp_err_t                   result;
+    bool                        bme280_humidity;
     /* time-into-interval sampling handle and configuration - */
     time_into_interval_handle_t tii_sampling_hdl;
+    time_into_interval_event_t  tii_sampling_event;
     const time_into_interval_config_t tii_sampling_cfg = {
         .name               = "tii_sampling",
         .interval_type      = TIME_INTO_INTERVAL_SEC,
         .interval_period    = 6,
         .interval_offset    = 0
     };
-    /* time-into-interval 1-hr handle and configuration - */
-    time_into_interval_handle_t tii_1hr_hdl;
-    const time_into_interval_config_t tii_1hr_cfg = {
-        .name               = "tii_1hr",
-        .interval_type      = TIME_INTO_INTERVAL_HR,
-        .interval_period    = 1,
-        .interval_offset    = 0
-    };
     /* master i2c 0 bus handle and configuration*/
     const i2c_master_bus_config_t i2c0_master_cfg = I2C_0_MASTER_DEFAULT_CONFIG;
     i2c_master_bus_handle_t     i2c0_bus_hdl;
     /* bmp280 i2c device handle and configuration */
-    const i2c_bmp280_config_t   bmp280_dev_cfg = I2C_BMP280_CONFIG_DEFAULT;
+    i2c_bmp280_config_t         bmp280_dev_cfg = I2C_BMP280_CONFIG_DEFAULT;
     i2c_bmp280_handle_t         bmp280_dev_hdl;
     /* ahtxx i2c device handle and configuration */
     const i2c_ahtxx_config_t    ahtxx_dev_cfg = I2C_AHT2X_CONFIG_DEFAULT;
-    i2c_ahtxx_handle_t          ahtxx_dev_hdl;
+    i2c_ahtxx_handle_t          ahtxx_dev_hdl = NULL;
+    /* i2c 0 bus scheduler handle and device configurations, the devices are interleaved at their turnaround */
+    sensors_sampling_t          sensors_sampling = { 0 };
+    const i2c_bus_scheduler_device_config_t bmp280_sched_cfg = {
+        .name               = "bmp280",
+        .turnaround_us      = I2C_BMP280_TURNAROUND_US,
+        .step               = bmp280_sampling_step,
+        .device_ctx         = &sensors_sampling
+    };
+    const i2c_bus_scheduler_device_config_t ahtxx_sched_cfg = {
+        .name               = "ahtxx",
+        .turnaround_us      = I2C_AHTXX_TURNAROUND_US,
+        .step               = ahtxx_sampling_step,
+        .device_ctx         = &sensors_sampling
+    };
+    /* i2c 0 device recoveries, transient bus and device faults are retried rather than restarting the system */
+    const i2c_recovery_config_t i2c0_recovery_cfg = I2C_RECOVERY_CONFIG_DEFAULT;
+    i2c_recovery_t              bmp280_recovery;
+    i2c_recovery_t              ahtxx_recovery;
+    i2c_device_health_t         device_health;
+    i2c_bus_scheduler_handle_t  i2c0_scheduler_hdl = NULL;
+    i2c_bus_scheduler_cycle_stats_t i2c0_cycle_stats;
+    uint8_t                     bmp280_sched_index;
+    uint8_t                     ahtxx_sched_index = 0;
     /* pa scalar trend handle and configuration */
     const uint16_t              trend_samples_size = (3600 / tii_sampling_cfg.interval_period);  // e.g. 6-sec sampling rate: 10 samples per minute, 600 samples per hour
     scalar_trend_handle_t       pa_trend_hdl;
     /* pa tendency handle and configuration */
-    const uint16_t              tendency_samples_size = ((3600 * 3) / tii_sampling_cfg.interval_period); // 3-hours = 10,800-seconds / sampling rate
+    const pressure_tendency_config_t pa_tendency_cfg = {
+        .sampling_period    = tii_sampling_cfg.interval_period,    // e.g. 6-sec sampling rate
+        .history_period     = PRESSURE_TENDENCY_PERIOD_MIN         // 3-hours of history
+    };
     pressure_tendency_handle_t  pa_tendency_hdl;
     /* ta scalar trend handle and configuration */
     scalar_trend_handle_t       ta_trend_hdl;
 
     /* attempt to create a queue for environmental samples */
-    s_mqtt_pub_env_queue_hdl = xQueueCreate(MQTT_PUB_ENV_QUEUE_SIZE, sizeof(environmental_sample_t*));
+    s_mqtt_pub_env_queue_hdl = xQueueCreate(MQTT_PUB_ENV_QUEUE_SIZE, sizeof(environmental_sample_t));
     if(s_mqtt_pub_env_queue_hdl == pdFALSE) {
         ESP_LOGE(TAG, "Unable to create queue for publishing environmental samples");
         esp_restart();
@@ -352,13 +705,6 @@ static void sample_sensor_task( void *pvParameters ) {
         esp_restart(); 
     }
 
-    /* attempt to initialize a time-into-interval 1-hr handle - task system clock synchronization */
-    time_into_interval_init(&tii_1hr_cfg, &tii_1hr_hdl);
-    if (tii_1hr_hdl == NULL) {
-        ESP_LOGE(TAG, "Unable to initialize time-into-interval 1-hr handle");
-        esp_restart(); 
-    }
-
     /* attempt to initialize a new i2c 0 master bus handle */
     i2c_new_master_bus(&i2c0_master_cfg, &i2c0_bus_hdl);
     if (i2c0_bus_hdl == NULL) {
@@ -366,17 +712,49 @@ static void sample_sensor_task( void *pvParameters ) {
         esp_restart(); 
     }
 
-    /* attempt to initialize a bmp280 device handle */
-    i2c_bmp280_init(i2c0_bus_hdl, &bmp280_dev_cfg, &bmp280_dev_hdl);
+    /* initialize i2c 0 device recoveries */
+    i2c_master_recovery_init(&bmp280_recovery, &i2c0_recovery_cfg, i2c0_bus_hdl);
+    i2c_master_recovery_init(&ahtxx_recovery, &i2c0_recovery_cfg, i2c0_bus_hdl);
+    sensors_sampling.bus_hdl        = i2c0_bus_hdl;
+    sensors_sampling.bmp280_dev_cfg = &bmp280_dev_cfg;
+    sensors_sampling.ahtxx_dev_cfg  = &ahtxx_dev_cfg;
+
+    /* attempt to initialize a bmp280 device handle, sleeps between forced measurements, only a persistent fault restarts the system */
+    bmp280_dev_cfg.power_mode = I2C_BMP280_POWER_MODE_FORCED;
+    i2c_master_recovery_execute(&bmp280_recovery, bmp280_init_operation, &sensors_sampling);
+    bmp280_dev_hdl = sensors_sampling.bmp280_dev_hdl;
     if (bmp280_dev_hdl == NULL) {
         ESP_LOGE(TAG, "Unable to initialize bmp280 device handle");
         esp_restart(); 
     }
+    i2c_master_recovery_set_device(&bmp280_recovery, bmp280_dev_hdl->i2c_dev_handle, bmp280_reinit, bmp280_dev_hdl);
+
+    /* a bme280 device samples humidity, the ahtxx device is not used */
+    bme280_humidity = (bmp280_dev_hdl->dev_type == I2C_BMP280_TYPE_BME280);
 
     /* attempt to initialize a ahtxx device handle */
-    i2c_ahtxx_init(i2c0_bus_hdl, &ahtxx_dev_cfg, &ahtxx_dev_hdl);
-    if (ahtxx_dev_hdl == NULL) {
-        ESP_LOGE(TAG, "Unable to initialize ahtxx device handle");
+    if (bme280_humidity == false) {
+        i2c_master_recovery_execute(&ahtxx_recovery, ahtxx_init_operation, &sensors_sampling);
+        ahtxx_dev_hdl = sensors_sampling.ahtxx_dev_hdl;
+        if (ahtxx_dev_hdl == NULL) {
+            ESP_LOGE(TAG, "Unable to initialize ahtxx device handle");
+            esp_restart(); 
+        }
+        i2c_master_recovery_set_device(&ahtxx_recovery, ahtxx_dev_hdl->i2c_dev_handle, ahtxx_reinit, ahtxx_dev_hdl);
+    }
+
+    /* attempt to initialize an i2c 0 bus scheduler handle with the bmp280 and ahtxx devices */
+    i2c_bus_scheduler_init(&i2c0_scheduler_hdl);
+    if (i2c0_scheduler_hdl == NULL) {
+        ESP_LOGE(TAG, "Unable to initialize i2c 0 bus scheduler handle");
+        esp_restart(); 
+    }
+    result = i2c_bus_scheduler_add_device(i2c0_scheduler_hdl, &bmp280_sched_cfg, &bmp280_sched_index);
+    if (result == ESP_OK && bme280_humidity == false) {
+        result = i2c_bus_scheduler_add_device(i2c0_scheduler_hdl, &ahtxx_sched_cfg, &ahtxx_sched_index);
+    }
+    if (result != ESP_OK) {
+        ESP_LOGE(TAG, "Unable to add devices to i2c 0 bus scheduler handle");
         esp_restart(); 
     }
 
@@ -388,7 +766,7 @@ static void sample_sensor_task( void *pvParameters ) {
     }
 
     /* attempt to initialize a pa tendency handle */
-    pressure_tendency_init(tendency_samples_size, &pa_tendency_hdl);
+    pressure_tendency_init(&pa_tendency_cfg, &pa_tendency_hdl);
     if (pa_tendency_hdl == NULL) {
         ESP_LOGE(TAG, "Unable to initialize pa tendency handle");
         esp_restart(); 
@@ -401,61 +779,15 @@ static void sample_sensor_task( void *pvParameters ) {
         esp_restart(); 
     }
 
-    /* attempt to create air temperature sample pointer */
-    environmental_sample_t* ta_sample = create_sample(MQTT_NET_DEVICE_ID, SAMPLE_AIR_TEMPERATURE);
-    if(ta_sample == NULL) {
-        ESP_LOGE(TAG, "Unable to allocate memory for environmental air temperature sample pointer");
-        esp_restart();
-    }
-
-    /* attempt to create air temperature trend sample pointer */
-    environmental_sample_t* tatrd_sample = create_sample(MQTT_NET_DEVICE_ID, SAMPLE_AIR_TEMPERATURE_TREND);
-    if(tatrd_sample == NULL) {
-        ESP_LOGE(TAG, "Unable to allocate memory for environmental air temperature trend sample pointer");
-        esp_restart();
-    }
-
-    /* attempt to create dewpoint temperature sample pointer */
-    environmental_sample_t* td_sample = create_sample(MQTT_NET_DEVICE_ID, SAMPLE_DEWPOINT_TEMPERATURE);
-    if(td_sample == NULL) {
-        ESP_LOGE(TAG, "Unable to allocate memory for environmental dewpoint temperature sample pointer");
-        esp_restart();
-    }
-
-    /* attempt to create relative humidity sample pointer */
-    environmental_sample_t* hr_sample = create_sample(MQTT_NET_DEVICE_ID, SAMPLE_RELATIVE_HUMIDITY);
-    if(hr_sample == NULL) {
-        ESP_LOGE(TAG, "Unable to allocate memory for environmental relative humidity sample pointer");
-        esp_restart();
-    }
-
-    /* attempt to create atmospheric pressure sample pointer */
-    environmental_sample_t* pa_sample = create_sample(MQTT_NET_DEVICE_ID, SAMPLE_ATMOSPHERIC_PRESSURE);
-    if(pa_sample == NULL) {
-        ESP_LOGE(TAG, "Unable to allocate memory for environmental atmospheric pressure sample pointer");
-        esp_restart();
-    }
-
-    /* attempt to create atmospheric pressure trend sample pointer */
-    environmental_sample_t* patrd_sample = create_sample(MQTT_NET_DEVICE_ID, SAMPLE_ATMOSPHERIC_PRESSURE_TREND);
-    if(patrd_sample == NULL) {
-        ESP_LOGE(TAG, "Unable to allocate memory for environmental atmospheric pressure trend sample pointer");
-        esp_restart();
-    }
-
-    /* attempt to create atmospheric pressure tendency sample pointer */
-    environmental_sample_t* patdc_sample = create_sample(MQTT_NET_DEVICE_ID, SAMPLE_ATMOSPHERIC_PRESSURE_TENDENCY);
-    if(patdc_sample == NULL) {
-        ESP_LOGE(TAG, "Unable to allocate memory for environmental atmospheric pressure tendency sample pointer");
-        esp_restart();
-    }
-
-    /* attempt to create atmospheric pressure tendency change sample pointer */
-    environmental_sample_t* patdcv_sample = create_sample(MQTT_NET_DEVICE_ID, SAMPLE_ATMOSPHERIC_PRESSURE_CHANGE);
-    if(patdcv_sample == NULL) {
-        ESP_LOGE(TAG, "Unable to allocate memory for environmental atmospheric pressure tendency change sample pointer");
-        esp_restart();
-    }
+    /* sample records, queued by value */
+    environmental_sample_t ta_sample     = create_sample(SAMPLE_AIR_TEMPERATURE);
+    environmental_sample_t tatrd_sample  = create_sample(SAMPLE_AIR_TEMPERATURE_TREND);
+    environmental_sample_t td_sample     = create_sample(SAMPLE_DEWPOINT_TEMPERATURE);
+    environmental_sample_t hr_sample     = create_sample(SAMPLE_RELATIVE_HUMIDITY);
+    environmental_sample_t pa_sample     = create_sample(SAMPLE_ATMOSPHERIC_PRESSURE);
+    environmental_sample_t patrd_sample  = create_sample(SAMPLE_ATMOSPHERIC_PRESSURE_TREND);
+    environmental_sample_t patdc_sample  = create_sample(SAMPLE_ATMOSPHERIC_PRESSURE_TENDENCY);
+    environmental_sample_t patdcv_sample = create_sample(SAMPLE_ATMOSPHERIC_PRESSURE_CHANGE);
 
     /* enter task loop */
     for ( ;; ) {
@@ -465,103 +797,118 @@ static void sample_sensor_task( void *pvParameters ) {
         /* validate mqtt link status */
         if(mqtt_connected == false) continue;
 
-        /* get timestamp value from last time-into-interval event */
-        time_into_interval_get_last_event(tii_sampling_hdl, &epoch_timestamp); // msec
-        epoch_timestamp = 1000000U * epoch_timestamp; // convert msec to nsec
+        /* get timestamp value from the interval boundary of the time-into-interval event */
+        time_into_interval_get_delay_event(tii_sampling_hdl, &tii_sampling_event);
+        epoch_timestamp = 1000U * tii_sampling_event.epoch_timestamp_usec; // convert usec to nsec
+        if (tii_sampling_event.skipped_events > 0) {
+            ESP_LOGW(TAG, "Sampling Interval Overrun:   %" PRIu32 " events skipped", tii_sampling_event.skipped_events);
+        }
+        ESP_LOGI(TAG, "Sampling Event Lateness:     %" PRId64 " us", tii_sampling_event.lateness_usec);
 
         /* set timestamp in nano-seconds for each sample */
-        ta_sample->timestamp    = epoch_timestamp;
-        td_sample->timestamp    = epoch_timestamp;
-        hr_sample->timestamp    = epoch_timestamp;
-        pa_sample->timestamp    = epoch_timestamp;
-        patrd_sample->timestamp = epoch_timestamp;
-        patdc_sample->timestamp = epoch_timestamp;
-        patdcv_sample->timestamp= epoch_timestamp;
-        tatrd_sample->timestamp = epoch_timestamp;
-
-        /* handle ahtxx device sampling */
-        result = i2c_ahtxx_get_measurements(ahtxx_dev_hdl, &ta_sample->value, &hr_sample->value, &td_sample->value);
-        if(result != ESP_OK) {
-            ta_sample->value = NAN, hr_sample->value = NAN, td_sample->value = NAN;
-            ESP_LOGE(TAG, "AHTXX device read failed (%s)", esp_err_to_name(result));
+        ta_sample.timestamp    = epoch_timestamp;
+        td_sample.timestamp    = epoch_timestamp;
+        hr_sample.timestamp    = epoch_timestamp;
+        pa_sample.timestamp    = epoch_timestamp;
+        patrd_sample.timestamp = epoch_timestamp;
+        patdc_sample.timestamp = epoch_timestamp;
+        patdcv_sample.timestamp= epoch_timestamp;
+        tatrd_sample.timestamp = epoch_timestamp;
+
+        /* sample the i2c 0 devices, the scheduler runs the ahtxx device steps during the bmp280 device conversion and vice versa */
+        i2c_bus_scheduler_run_cycle(i2c0_scheduler_hdl);
+        i2c_bus_scheduler_get_cycle_stats(i2c0_scheduler_hdl, &i2c0_cycle_stats);
+        ESP_LOGI(TAG, "I2C 0 Bus Cycle:             %" PRIu32 " us, %.2f %% utilization", i2c0_cycle_stats.cycle_us, i2c0_cycle_stats.utilization);
+
+        /* handle bmp280 device sampling, a failed request is retried with bus and device recovery */
+        i2c_bus_scheduler_get_device_result(i2c0_scheduler_hdl, bmp280_sched_index, &result);
+        result = i2c_master_recovery_retry(&bmp280_recovery, result, bmp280_sampling_operation, &sensors_sampling);
+        i2c_master_recovery_get_health(&bmp280_recovery, &device_health);
+        if (device_health.state != I2C_DEVICE_HEALTH_OK) {
+            ESP_LOGW(TAG, "BMP280 Device Health:        %s (%" PRIu32 " recoveries, %" PRIu32 " bus resets)", i2c_device_health_state_to_string(device_health.state), device_health.recoveries, device_health.bus_resets);
+        }
+        if (bme280_humidity == true) {
+            /* handle bme280 device sampling, temperature, pressure and humidity in one burst read */
+            if(result != ESP_OK) {
+                ta_sample.value = NAN, pa_sample.value = NAN, hr_sample.value = NAN, td_sample.value = NAN;
+                ESP_LOGE(TAG, "BME280 device read failed (%s)", esp_err_to_name(result));
+            } else {
+                ta_sample.value = sensors_sampling.bmp280_temperature;
+                pa_sample.value = sensors_sampling.bmp280_pressure / 100;
+                hr_sample.value = sensors_sampling.bmp280_humidity;
+                ESP_LOGI(TAG, "BME280 Atmospheric Pressure: %.2f hPa", pa_sample.value);
+                ESP_LOGI(TAG, "BME280 Air Temperature:       %.2f C", ta_sample.value);
+                ESP_LOGI(TAG, "BME280 Relative Humidity:     %.2f %%", hr_sample.value);
+
+                /* a rejected dewpoint only invalidates the derived sample, the read samples are kept */
+                result = i2c_ahtxx_calculate_dewpoint(ta_sample.value, hr_sample.value, &td_sample.value);
+                if(result != ESP_OK) {
+                    td_sample.value = NAN;
+                    ESP_LOGE(TAG, "BME280 dewpoint calculation failed (%s)", esp_err_to_name(result));
+                } else {
+                    ESP_LOGI(TAG, "BME280 Dewpoint Temperature:  %.2f C", td_sample.value);
+                }
+            }
         } else {
-            ESP_LOGI(TAG, "AHTXX Air Temperature:       %.2f C", ta_sample->value);
-            ESP_LOGI(TAG, "AHTXX Relative Humidity:     %.2f %%", hr_sample->value);
-            ESP_LOGI(TAG, "AHTXX Dewpoint Temperature:  %.2f C", td_sample->value);
+            if(result != ESP_OK) {
+                pa_sample.value = NAN;
+                ESP_LOGE(TAG, "BMP280 device read failed (%s)", esp_err_to_name(result));
+            } else {
+                pa_sample.value = sensors_sampling.bmp280_pressure / 100;
+                ESP_LOGI(TAG, "BMP280 Atmospheric Pressure: %.2f hPa", pa_sample.value);
+            }
+
+            /* handle ahtxx device sampling, a failed request is retried with bus and device recovery */
+            i2c_bus_scheduler_get_device_result(i2c0_scheduler_hdl, ahtxx_sched_index, &result);
+            result = i2c_master_recovery_retry(&ahtxx_recovery, result, ahtxx_sampling_operation, &sensors_sampling);
+            i2c_master_recovery_get_health(&ahtxx_recovery, &device_health);
+            if (device_health.state != I2C_DEVICE_HEALTH_OK) {
+                ESP_LOGW(TAG, "AHTXX Device Health:         %s (%" PRIu32 " recoveries, %" PRIu32 " bus resets)", i2c_device_health_state_to_string(device_health.state), device_health.recoveries, device_health.bus_resets);
+            }
+            if(result == ESP_OK) {
+                ta_sample.value = sensors_sampling.ahtxx_temperature;
+                hr_sample.value = sensors_sampling.ahtxx_humidity;
+                result = i2c_ahtxx_calculate_dewpoint(ta_sample.value, hr_sample.value, &td_sample.value);
+            }
+            if(result != ESP_OK) {
+                ta_sample.value = NAN, hr_sample.value = NAN, td_sample.value = NAN;
+                ESP_LOGE(TAG, "AHTXX device read failed (%s)", esp_err_to_name(result));
+            } else {
+                ESP_LOGI(TAG, "AHTXX Air Temperature:       %.2f C", ta_sample.value);
+                ESP_LOGI(TAG, "AHTXX Relative Humidity:     %.2f %%", hr_sample.value);
+                ESP_LOGI(TAG, "AHTXX Dewpoint Temperature:  %.2f C", td_sample.value);
+            }
         }
 
         /* handle ta scalar trend analysis */
-        scalar_trend_analysis(ta_trend_hdl, ta_sample->value, &ta_trend_code);
-        tatrd_sample->value = ta_trend_code;
-        ESP_LOGI(TAG, "AHTXX Air Temperature Trend: %s", scalar_trend_code_to_string(ta_trend_code));
-
-        /* settling delay between i2c device transactions on the same i2c master bus */
-        vTaskDelay(pdMS_TO_TICKS(50));
-
-        /* handle bmp280 device sampling */
-        result = i2c_bmp280_get_pressure(bmp280_dev_hdl, &pa_sample->value);
-        if(result != ESP_OK) {
-            pa_sample->value = NAN;
-            ESP_LOGE(TAG, "BMP280 device read failed (%s)", esp_err_to_name(result));
-        } else {
-            pa_sample->value = pa_sample->value / 100;
-            ESP_LOGI(TAG, "BMP280 Atmospheric Pressure: %.2f hPa", pa_sample->value);
-        }
+        scalar_trend_analysis(ta_trend_hdl, ta_sample.value, &ta_trend_code);
+        tatrd_sample.value = ta_trend_code;
+        ESP_LOGI(TAG, "%s Air Temperature Trend: %s", bme280_humidity ? "BME280" : "AHTXX", scalar_trend_code_to_string(ta_trend_code));
 
         /* handle pa scalar trend analysis */
-        scalar_trend_analysis(pa_trend_hdl, pa_sample->value, &pa_trend_code);
-        patrd_sample->value = pa_trend_code;
-        ESP_LOGI(TAG, "BMP280 Air Pressure Trend:   %s", scalar_trend_code_to_string(pa_trend_code));
+        scalar_trend_analysis(pa_trend_hdl, pa_sample.value, &pa_trend_code);
+        patrd_sample.value = pa_trend_code;
+        ESP_LOGI(TAG, "%s Air Pressure Trend:   %s", bme280_humidity ? "BME280" : "BMP280", scalar_trend_code_to_string(pa_trend_code));
 
         /* handle pa tendency code and change analysis */
-        pressure_tendency_analysis(pa_tendency_hdl, pa_sample->value, &pa_tendency_code, &patdcv_sample->value);
-        patdc_sample->value = pa_tendency_code;
-        ESP_LOGI(TAG, "BMP280 Pressure Tendency:    %s", pressure_tendency_code_to_string(pa_tendency_code));
-        ESP_LOGI(TAG, "BMP280 3-hr Pressure Change: %.2f hPa", patdcv_sample->value);
-
-        // attempt to queue ta sample item and send
-        if(xQueueSend(s_mqtt_pub_env_queue_hdl, (void *)&ta_sample, (TickType_t)0) != pdTRUE) {
-            ESP_LOGE(TAG, "Unable to Send Publish Environmental %s Sample Queue", sample_parameter_to_string(ta_sample->parameter));
-        }
-
-        // attempt to queue tatrd sample item and send
-        if(xQueueSend(s_mqtt_pub_env_queue_hdl, (void *)&tatrd_sample, (TickType_t)0) != pdTRUE) {
-            ESP_LOGE(TAG, "Unable to Send Publish Environmental %s Sample Queue", sample_parameter_to_string(tatrd_sample->parameter));
-        }
-
-        // attempt to queue hr sample item and send
-        if(xQueueSend(s_mqtt_pub_env_queue_hdl, (void *)&hr_sample, (TickType_t)0) != pdTRUE) {
-            ESP_LOGE(TAG, "Unable to Send Publish Environmental %s Sample Queue", sample_parameter_to_string(hr_sample->parameter));
-        }
-
-        // attempt to queue td sample item and send
-        if(xQueueSend(s_mqtt_pub_env_queue_hdl, (void *)&td_sample, (TickType_t)0) != pdTRUE) {
-            ESP_LOGE(TAG, "Unable to Send Publish Environmental %s Sample Queue", sample_parameter_to_string(td_sample->parameter));
-        }
-
-        // attempt to queue pa sample item and send
-        if(xQueueSend(s_mqtt_pub_env_queue_hdl, (void *)&pa_sample, (TickType_t)0) != pdTRUE) {
-            ESP_LOGE(TAG, "Unable to Send Publish Environmental %s Sample Queue", sample_parameter_to_string(pa_sample->parameter));
-        }
-
-        // attempt to queue patrd sample item and send
-        if(xQueueSend(s_mqtt_pub_env_queue_hdl, (void *)&patrd_sample, (TickType_t)0) != pdTRUE) {
-            ESP_LOGE(TAG, "Unable to Send Publish Environmental %s Sample Queue", sample_parameter_to_string(patrd_sample->parameter));
-        }
-
-        // attempt to queue patdc sample item and send
-        if(xQueueSend(s_mqtt_pub_env_queue_hdl, (void *)&patdc_sample, (TickType_t)0) != pdTRUE) {
-            ESP_LOGE(TAG, "Unable to Send Publish Environmental %s Sample Queue", sample_parameter_to_string(patdc_sample->parameter));
-        }
-
-        // attempt to queue patdcv sample item and send
-        if(xQueueSend(s_mqtt_pub_env_queue_hdl, (void *)&patdcv_sample, (TickType_t)0) != pdTRUE) {
-            ESP_LOGE(TAG, "Unable to Send Publish Environmental %s Sample Queue", sample_parameter_to_string(patdcv_sample->parameter));
-        }
+        pressure_tendency_analysis(pa_tendency_hdl, pa_sample.value, &pa_tendency_code, &patdcv_sample.value);
+        patdc_sample.value = pa_tendency_code;
+        ESP_LOGI(TAG, "%s Pressure Tendency:    %s", bme280_humidity ? "BME280" : "BMP280", pressure_tendency_code_to_string(pa_tendency_code));
+        ESP_LOGI(TAG, "%s 3-hr Pressure Change: %.2f hPa", bme280_humidity ? "BME280" : "BMP280", patdcv_sample.value);
+
+        /* attempt to queue sample records */
+        queue_sample(&ta_sample, &sample_sequence);
+        queue_sample(&tatrd_sample, &sample_sequence);
+        queue_sample(&hr_sample, &sample_sequence);
+        queue_sample(&td_sample, &sample_sequence);
+        queue_sample(&pa_sample, &sample_sequence);
+        queue_sample(&patrd_sample, &sample_sequence);
+        queue_sample(&patdc_sample, &sample_sequence);
+        queue_sample(&patdcv_sample, &sample_sequence);
     }
     /* free resources */
     i2c_bmp280_rm( bmp280_dev_hdl );
-    i2c_ahtxx_rm( ahtxx_dev_hdl ); 
+    if (ahtxx_dev_hdl != NULL) i2c_ahtxx_rm( ahtxx_dev_hdl ); 
     i2c_del_master_bus( i2c0_bus_hdl );
     scalar_trend_del(pa_trend_hdl);
     scalar_trend_del(ta_trend_hdl);
@@ -571,85 +918,137 @@ static void sample_sensor_task( void *pvParameters ) {
 
 /**
  * @brief Task that publishes incoming sensor sampling item queue to
- * an MQTT broker when a queued item is received.  This task waits for 
- * a queued item that is sent from the sample sensor task before 
- * publishing to the MQTT broker.
+ * an MQTT broker in batches.  This task waits for queued items that are 
+ * sent from the sample sensor task and appends them to a batch that is 
+ * published to the MQTT broker as a single message by sample count, by 
+ * payload size or by age of the batch.
  * 
  * @note This task will restart the system if the MQTT client disconnects.
  * 
  * @param pvParameters Parameters for task.
  */
 static void publish_sensor_task( void *pvParameters ) {
-    environmental_sample_t* sample = NULL;
+    environmental_sample_t  sample;
+    uint32_t                sample_sequence = 0;
+    static mqtt_pub_batch_t batch;
     //uint32_t free_heap_size_last   = 0;
 
+    /* attempt to precompute row templates of the network device by sample parameter */
+    for(uint8_t parameter = 0; parameter < SAMPLE_PARAMETERS_MAX; parameter++) {
+        if(machbase_row_template_init(MQTT_NET_DEVICE_ID, sample_parameter_to_string(parameter), &batch.row_templates[parameter]) != ESP_OK) {
+            ESP_LOGE(TAG, "Unable to initialize publishing environmental %s row template", sample_parameter_to_string(parameter));
+            esp_restart();
+        }
+    }
+
     /* enter task loop */
     for ( ;; ) {
+        /* wait for a queued item, no longer than the age remaining on a pending batch */
+        TickType_t wait_ticks = portMAX_DELAY;
+        if(batch.samples_count > 0) {
+            TickType_t age_ticks = xTaskGetTickCount() - batch.created_ticks;
+            wait_ticks = (age_ticks < pdMS_TO_TICKS(MQTT_PUB_BATCH_AGE_MAX_MS)) ? pdMS_TO_TICKS(MQTT_PUB_BATCH_AGE_MAX_MS) - age_ticks : 0;
+        }
+
         /* validate receive queue and handle queued item */
-        if(xQueueReceive(s_mqtt_pub_env_queue_hdl, &(sample), (TickType_t)10) == pdTRUE && sample != NULL) {
+        if(xQueueReceive(s_mqtt_pub_env_queue_hdl, &(sample), wait_ticks) == pdTRUE) {
             /* validate mqtt link status */
             if(mqtt_connected == false) esp_restart();
 
-            //ESP_LOGI(TAG, "Publish Environmental %s Sample Queue Received....", sample_param_type_to_string(sample->type));
+            /* report sample records dropped by the sampler when the queue was full */
+            if(sample.sequence != sample_sequence) {
+                ESP_LOGW(TAG, "Publish Environmental Sample Queue dropped %lu sample(s)", sample.sequence - sample_sequence);
+            }
+            sample_sequence = sample.sequence + 1;
 
-            /* 
-                construct mqtt message from sample item received from the queue
-                sample: ["ca-nb-aws-01-1000.Air-Temperature",1729957661187888000,1002.928162,"Air-Temperature", "ca-nb-aws-01-1000"] 
-            */
-            char* msg = malloc(MQTT_PUB_MSG_BUFFER_SIZE);
-            snprintf(msg, MQTT_PUB_MSG_BUFFER_SIZE, "[\"%s.%s\",%llu,%f,\"%s\",\"%s\"]", 
-                    sample->device_id, sample_parameter_to_string(sample->parameter),
-                    sample->timestamp, sample->value, 
-                    sample_parameter_to_string(sample->parameter), sample->device_id);
+            /* append sample to batch, flushes by count and size */
+            append_batch(&batch, &sample);
+        }
 
-            /* publish sample message */
-            esp_mqtt_client_publish(mqtt_client_hdl, MQTT_PUB_ENV, (const char *)msg, 0, 0, 0);
+        /* flush by age */
+        if(batch.samples_count > 0 && (xTaskGetTickCount() - batch.created_ticks) >= pdMS_TO_TICKS(MQTT_PUB_BATCH_AGE_MAX_MS)) {
+            /* validate mqtt link status */
+            if(mqtt_connected == false) esp_restart();
 
-            /* free rousource */
-            free(msg);
+            publish_batch(&batch);
         }
     }
     vTaskDelete( NULL );
 }
 
 /**
- * @brief Task that prints memory usage.
+ * @brief Time-into-interval multiplexer callback that prints memory usage.
+ * 
+ * @param callback_ctx Last free heap size in bytes.
+ * @param event Time-into-interval event.
+ */
+static void heap_size_callback(void *callback_ctx, const time_into_interval_event_t *event) {
+    uint32_t *free_heap_size_last = (uint32_t *)callback_ctx;
+
+    /* monitor consumed bytes for possible memory leak */
+    *free_heap_size_last = print_free_heap_size(*free_heap_size_last);
+
+    ESP_LOGW(TAG, "Free Stack Memory: %lu bytes (housekeeping_task)", uxTaskGetStackHighWaterMark2(NULL));
+
+    if(s_sample_sensor_task_hdl != NULL) 
+        ESP_LOGW(TAG, "Free Stack Memory: %lu bytes (sample_sensor_task)", uxTaskGetStackHighWaterMark2(s_sample_sensor_task_hdl));
+
+    if(s_publish_sensor_task_hdl != NULL)  
+        ESP_LOGW(TAG, "Free Stack Memory: %lu bytes (publish_sensor_task)", uxTaskGetStackHighWaterMark2(s_publish_sensor_task_hdl));
+}
+
+/**
+ * @brief Time-into-interval multiplexer callback that publishes the hourly i2c device statistics.
+ * 
+ * @param callback_ctx Not used.
+ * @param event Time-into-interval event, the interval boundary is the statistics timestamp.
+ */
+static void i2c_stats_callback(void *callback_ctx, const time_into_interval_event_t *event) {
+    /* validate mqtt link status, the statistics accumulate until the next hour */
+    if(mqtt_connected == false) return;
+
+    publish_i2c_stats(1000U * event->epoch_timestamp_usec); // convert usec to nsec
+}
+
+/**
+ * @brief Task that runs the periodic housekeeping, memory usage and i2c device statistics,
+ * on a single time-into-interval multiplexer.
  * 
  * @param pvParameters 
  */
-static void heap_size_task( void *pvParameters ) {
+static void housekeeping_task( void *pvParameters ) {
     uint32_t free_heap_size_last = 0;
-    /* time-into-interval handle and configuration - */
-    time_into_interval_handle_t       tii_1min_hdl;
-    const time_into_interval_config_t tii_1min_cfg = {
+    /* time-into-interval multiplexer handle and interval configurations - */
+    time_into_interval_mux_handle_t                 tii_mux_hdl = NULL;
+    const time_into_interval_mux_interval_config_t  tii_1min_cfg = {
         .name               = "tii_1min",
         .interval_type      = TIME_INTO_INTERVAL_SEC,
         .interval_period    = 60,
-        .interval_offset    = 10
+        .interval_offset    = 10,
+        .callback           = heap_size_callback,
+        .callback_ctx       = &free_heap_size_last
+    };
+    const time_into_interval_mux_interval_config_t  tii_1hr_cfg = {
+        .name               = "tii_1hr",
+        .interval_type      = TIME_INTO_INTERVAL_HR,
+        .interval_period    = 1,
+        .interval_offset    = 0,
+        .callback           = i2c_stats_callback,
+        .callback_ctx       = NULL
     };
 
-    /* attempt to initialize a time-into-interval handle - task system clock synchronization */
-    time_into_interval_init(&tii_1min_cfg, &tii_1min_hdl);
-    if (tii_1min_hdl == NULL) {
-        ESP_LOGE(TAG, "Unable to initialize time-into-interval handle");
+    /* attempt to initialize a time-into-interval multiplexer handle - task system clock synchronization */
+    if (time_into_interval_mux_init(&tii_mux_hdl) != ESP_OK ||
+        time_into_interval_mux_add_interval(tii_mux_hdl, &tii_1min_cfg, NULL) != ESP_OK ||
+        time_into_interval_mux_add_interval(tii_mux_hdl, &tii_1hr_cfg, NULL) != ESP_OK) {
+        ESP_LOGE(TAG, "Unable to initialize time-into-interval multiplexer handle");
         esp_restart(); 
     }
 
     /* enter task loop */
     for ( ;; ) {
-        /* time-into-interval task delay (1-min interval with 10-second offset into the interval) */
-        time_into_interval_delay(tii_1min_hdl);
-
-        /* monitor consumed bytes for possible memory leak */
-        free_heap_size_last = print_free_heap_size(free_heap_size_last);
-
-        ESP_LOGW(TAG, "Free Stack Memory: %lu bytes (heap_size_task)", uxTaskGetStackHighWaterMark2(NULL));
-
-        if(s_sample_sensor_task_hdl != NULL) 
-            ESP_LOGW(TAG, "Free Stack Memory: %lu bytes (sample_sensor_task)", uxTaskGetStackHighWaterMark2(s_sample_sensor_task_hdl));
-
-        if(s_publish_sensor_task_hdl != NULL)  
-            ESP_LOGW(TAG, "Free Stack Memory: %lu bytes (publish_sensor_task)", uxTaskGetStackHighWaterMark2(s_publish_sensor_task_hdl));
+        /* time-into-interval multiplexer dispatch (1-min interval with 10-second offset, 1-hr interval) */
+        time_into_interval_mux_dispatch(tii_mux_hdl);
     }
     vTaskDelete( NULL );
 }
@@ -708,11 +1107,11 @@ void app_main(void) {
         &s_publish_sensor_task_hdl, 
         APP_CPU_NUM );
 
-    /* attempt to start memory usage task */
+    /* attempt to start housekeeping task */
     xTaskCreatePinnedToCore( 
-        heap_size_task, 
-        "heap_size_tsk", 
-        (MINIMAL_STACK_SIZE * 4), 
+        housekeeping_task, 
+        "hk_tsk", 
+        (MINIMAL_STACK_SIZE * 6), 
         NULL, 
         (tskIDLE_PRIORITY + 2), 
         NULL, 
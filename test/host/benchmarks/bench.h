@@ -0,0 +1,48 @@
+/**
+ * @file bench.h
+ *
+ * Common timing and reporting helpers of the host benchmarks.  Every benchmark
+ * is run at the samples sizes of `BENCH_SAMPLES_SIZES`, repeated until at least
+ * `BENCH_SAMPLES_MIN` samples are processed, and the best of `BENCH_RUNS` runs is
+ * reported as one JSON object per line:
+ *
+ *   {"benchmark":"scalar_trend_analysis","samples":3600,"ns_per_sample":12.3,"bytes_per_handle":14440}
+ */
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+
+#define BENCH_SAMPLES_SIZES     { 60, 600, 3600, 10800 }    /*!< samples sizes, 1-minute to 3-hours of history at typical sampling rates */
+#define BENCH_SAMPLES_MIN       (1000000)                   /*!< minimum number of samples processed per run */
+#define BENCH_RUNS              (3)                         /*!< number of runs, the fastest run is reported */
+
+static inline double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief Number of passes over a samples buffer of `samples_size` to process at least `BENCH_SAMPLES_MIN` samples.
+ */
+static inline uint32_t bench_passes(const uint32_t samples_size) {
+    return (BENCH_SAMPLES_MIN + samples_size - 1) / samples_size;
+}
+
+static inline void bench_report(const char *const benchmark, const uint32_t samples_size, const double ns_per_sample, const size_t bytes_per_handle) {
+    printf("{\"benchmark\":\"%s\",\"samples\":%u,\"ns_per_sample\":%.1f,\"bytes_per_handle\":%zu}\n",
+            benchmark, samples_size, ns_per_sample, bytes_per_handle);
+}
+
+static inline void bench_report_skipped(const char *const benchmark, const uint32_t samples_size, const char *const reason) {
+    printf("{\"benchmark\":\"%s\",\"samples\":%u,\"skipped\":\"%s\"}\n", benchmark, samples_size, reason);
+}
+
+/* keeps results observable so the timed loops are not optimized away */
+static volatile double s_bench_sink;
+
+#endif // __BENCH_H__
@@ -0,0 +1,55 @@
+/**
+ * @file bench_ahtxx.c
+ *
+ * Host benchmark of the AHTXX dew-point calculation.  The calculation is
+ * internal to the driver, the driver source is included to reach it.  See
+ * bench.h for the output format.
+ */
+#include <stdlib.h>
+#include <math.h>
+
+#include "../../../components/ahtxx/ahtxx.c"
+
+#include "bench.h"
+
+static const uint32_t s_samples_sizes[] = BENCH_SAMPLES_SIZES;
+
+int main(void) {
+    for(size_t s = 0; s < sizeof(s_samples_sizes) / sizeof(s_samples_sizes[0]); s++) {
+        const uint32_t samples_size = s_samples_sizes[s];
+        const uint32_t passes = bench_passes(samples_size);
+        float *temperatures = malloc(samples_size * sizeof(float));
+        float *humidities   = malloc(samples_size * sizeof(float));
+        double best_ns = INFINITY;
+
+        if(temperatures == NULL || humidities == NULL) return EXIT_FAILURE;
+
+        /* temperatures of -20 to 40 degrees celsius and humidities of 10 to 95 percent */
+        for(uint32_t i = 0; i < samples_size; i++) {
+            temperatures[i] = -20.0f + 60.0f * (float)((i * 7919u) % 1000u) / 1000.0f + 0.05f;
+            humidities[i]   = 10.0f + 85.0f * (float)((i * 104729u) % 1000u) / 1000.0f;
+        }
+
+        for(int run = 0; run < BENCH_RUNS; run++) {
+            double sum = 0;
+            double start = bench_now_ns();
+            for(uint32_t p = 0; p < passes; p++) {
+                for(uint32_t i = 0; i < samples_size; i++) {
+                    float dewpoint;
+                    if(i2c_ahtxx_calculate_dewpoint(temperatures[i], humidities[i], &dewpoint) != ESP_OK) return EXIT_FAILURE;
+                    sum += dewpoint;
+                }
+            }
+            double ns = (bench_now_ns() - start) / ((double)passes * samples_size);
+            if(ns < best_ns) best_ns = ns;
+            s_bench_sink = sum;
+        }
+
+        bench_report("ahtxx_calculate_dewpoint", samples_size, best_ns, sizeof(i2c_ahtxx_t));
+
+        free(temperatures);
+        free(humidities);
+    }
+
+    return EXIT_SUCCESS;
+}
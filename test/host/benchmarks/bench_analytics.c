@@ -0,0 +1,159 @@
+/**
+ * @file bench_analytics.c
+ *
+ * Host benchmarks of the scalar trend, pressure tendency and MACHBASE row
+ * components at realistic samples sizes.  See bench.h for the output format.
+ */
+#include <stdlib.h>
+#include <math.h>
+
+#include <scalar_trend.h>
+#include <pressure_tendency.h>
+#include <machbase_row.h>
+
+#include "bench.h"
+
+static const uint32_t s_samples_sizes[] = BENCH_SAMPLES_SIZES;
+
+/* pressure-like samples, a slow drift with noise */
+static float *bench_samples(const uint32_t samples_size) {
+    float *samples = malloc(samples_size * sizeof(float));
+    if(samples == NULL) return NULL;
+    for(uint32_t i = 0; i < samples_size; i++) {
+        samples[i] = 1000.0f + 2.5f * (float)i / (float)samples_size + 0.05f * (float)((i * 7919u) % 11u);
+    }
+    return samples;
+}
+
+static int bench_scalar_trend(const uint32_t samples_size, const float *const samples, const scalar_trend_modes_t mode) {
+    const char *benchmark = (mode == SCALAR_TREND_MODE_INCREMENTAL) ? "scalar_trend_analysis" : "scalar_trend_analysis_compatible";
+    scalar_trend_handle_t hdl = NULL;
+    scalar_trend_codes_t  code;
+    double best_ns = INFINITY;
+
+    if(scalar_trend_init((uint16_t)samples_size, &hdl) != ESP_OK) return EXIT_FAILURE;
+    scalar_trend_set_mode(hdl, mode);
+
+    /* the compatible mode is linear in the samples size, bound its total work */
+    uint32_t passes = (mode == SCALAR_TREND_MODE_INCREMENTAL) ? bench_passes(samples_size) : bench_passes(samples_size * samples_size / 10 + 1);
+    if(passes < 2) passes = 2;
+
+    for(int run = 0; run < BENCH_RUNS; run++) {
+        scalar_trend_reset(hdl);
+        /* first pass fills the samples buffer */
+        for(uint32_t i = 0; i < samples_size; i++) scalar_trend_analysis(hdl, samples[i], &code);
+        double start = bench_now_ns();
+        for(uint32_t p = 1; p < passes; p++) {
+            for(uint32_t i = 0; i < samples_size; i++) scalar_trend_analysis(hdl, samples[i], &code);
+        }
+        double ns = (bench_now_ns() - start) / ((double)(passes - 1) * samples_size);
+        if(ns < best_ns) best_ns = ns;
+        s_bench_sink = code;
+    }
+
+    bench_report(benchmark, samples_size, best_ns, sizeof(scalar_trend_t) + hdl->samples_size * sizeof(float));
+
+    scalar_trend_del(hdl);
+    return EXIT_SUCCESS;
+}
+
+static int bench_pressure_tendency(const uint32_t samples_size, const float *const samples) {
+    static const uint16_t sampling_periods[] = { 1, 2, 3, 4, 5, 6, 10, 12, 15, 20, 30, 60 };
+    pressure_tendency_config_t cfg = { 0 };
+    pressure_tendency_handle_t hdl = NULL;
+    pressure_tendency_codes_t  code;
+    float change;
+    double best_ns = INFINITY;
+
+    /* the finest sampling period whose history of `samples_size` samples spans at least 3-hrs */
+    for(size_t i = 0; i < sizeof(sampling_periods) / sizeof(sampling_periods[0]); i++) {
+        uint32_t history_s = samples_size * sampling_periods[i];
+        if(history_s >= PRESSURE_TENDENCY_PERIOD_MIN * 60 && history_s % 60 == 0) {
+            cfg.sampling_period = sampling_periods[i];
+            cfg.history_period  = (uint16_t)(history_s / 60);
+            break;
+        }
+    }
+    if(cfg.sampling_period == 0) {
+        bench_report_skipped("pressure_tendency_analysis", samples_size, "history shorter than the 3-hr pressure tendency period");
+        return EXIT_SUCCESS;
+    }
+
+    if(pressure_tendency_init(&cfg, &hdl) != ESP_OK) return EXIT_FAILURE;
+
+    uint32_t passes = bench_passes(samples_size);
+    if(passes < 2) passes = 2;
+
+    for(int run = 0; run < BENCH_RUNS; run++) {
+        pressure_tendency_reset(hdl);
+        /* first pass fills the history */
+        for(uint32_t i = 0; i < samples_size; i++) pressure_tendency_analysis(hdl, samples[i], &code, &change);
+        double start = bench_now_ns();
+        for(uint32_t p = 1; p < passes; p++) {
+            for(uint32_t i = 0; i < samples_size; i++) pressure_tendency_analysis(hdl, samples[i], &code, &change);
+        }
+        double ns = (bench_now_ns() - start) / ((double)(passes - 1) * samples_size);
+        if(ns < best_ns) best_ns = ns;
+        s_bench_sink = change;
+    }
+
+    size_t bytes = sizeof(pressure_tendency_t) +
+                    (hdl->raw_history.buckets_size + hdl->min_history.buckets_size + hdl->ten_history.buckets_size) * sizeof(float);
+    bench_report("pressure_tendency_analysis", samples_size, best_ns, bytes);
+
+    pressure_tendency_del(hdl);
+    return EXIT_SUCCESS;
+}
+
+static int bench_machbase_row(const uint32_t samples_size, const float *const samples) {
+    machbase_row_template_t row_template;
+    double best_ns = INFINITY;
+
+    if(machbase_row_template_init("CA.NB.AWS.01-1000", "Atmospheric-Pressure", &row_template) != ESP_OK) return EXIT_FAILURE;
+
+    /* rows of the samples are serialized back-to-back as in a batch payload */
+    const size_t payload_size = samples_size * machbase_row_size_max(&row_template);
+    char *payload = malloc(payload_size);
+    if(payload == NULL) return EXIT_FAILURE;
+
+    const uint32_t passes = bench_passes(samples_size);
+
+    for(int run = 0; run < BENCH_RUNS; run++) {
+        uint64_t timestamp = 1729957661187888000ULL;
+        size_t   len = 0;
+        double start = bench_now_ns();
+        for(uint32_t p = 0; p < passes; p++) {
+            len = 0;
+            for(uint32_t i = 0; i < samples_size; i++) {
+                len += machbase_row_serialize(&row_template, timestamp++, samples[i], payload + len, payload_size - len);
+            }
+        }
+        double ns = (bench_now_ns() - start) / ((double)passes * samples_size);
+        if(ns < best_ns) best_ns = ns;
+        s_bench_sink = (double)len;
+    }
+
+    bench_report("machbase_row_serialize", samples_size, best_ns, sizeof(row_template));
+
+    free(payload);
+    return EXIT_SUCCESS;
+}
+
+int main(void) {
+    int ret = EXIT_SUCCESS;
+
+    for(size_t s = 0; s < sizeof(s_samples_sizes) / sizeof(s_samples_sizes[0]); s++) {
+        const uint32_t samples_size = s_samples_sizes[s];
+        float *samples = bench_samples(samples_size);
+        if(samples == NULL) return EXIT_FAILURE;
+
+        ret |= bench_scalar_trend(samples_size, samples, SCALAR_TREND_MODE_INCREMENTAL);
+        ret |= bench_scalar_trend(samples_size, samples, SCALAR_TREND_MODE_COMPATIBLE);
+        ret |= bench_pressure_tendency(samples_size, samples);
+        ret |= bench_machbase_row(samples_size, samples);
+
+        free(samples);
+    }
+
+    return ret;
+}
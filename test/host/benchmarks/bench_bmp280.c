@@ -0,0 +1,76 @@
+/**
+ * @file bench_bmp280.c
+ *
+ * Host benchmark of the BMP280 temperature and pressure compensation back-ends.
+ * The compensation functions are internal to the driver, the driver source is
+ * included to reach them.  See bench.h for the output format.
+ */
+#include <stdlib.h>
+#include <math.h>
+
+#include "../../../components/bmp280/bmp280.c"
+
+#include "bench.h"
+
+static const uint32_t s_samples_sizes[] = BENCH_SAMPLES_SIZES;
+
+static const struct {
+    i2c_bmp280_compensations_t  compensation;
+    const char                 *benchmark;
+} s_compensations[] = {
+    { I2C_BMP280_COMPENSATION_INT64, "bmp280_compensate_int64" },
+    { I2C_BMP280_COMPENSATION_INT32, "bmp280_compensate_int32" },
+    { I2C_BMP280_COMPENSATION_FLOAT, "bmp280_compensate_float" } };
+
+/* datasheet section 3.11.3 example calibration */
+static i2c_bmp280_cal_factors_t s_cal_factors = {
+    .dig_T1 = 27504, .dig_T2 = 26435, .dig_T3 = -1000,
+    .dig_P1 = 36477, .dig_P2 = -10685, .dig_P3 = 3024, .dig_P4 = 2855, .dig_P5 = 140,
+    .dig_P6 = -7, .dig_P7 = 15500, .dig_P8 = -14600, .dig_P9 = 6000 };
+
+int main(void) {
+    i2c_bmp280_t bmp280 = { .dev_cal_factors = &s_cal_factors };
+
+    for(size_t s = 0; s < sizeof(s_samples_sizes) / sizeof(s_samples_sizes[0]); s++) {
+        const uint32_t samples_size = s_samples_sizes[s];
+        const uint32_t passes = bench_passes(samples_size);
+        int32_t *adc_temperatures = malloc(samples_size * sizeof(int32_t));
+        int32_t *adc_pressures    = malloc(samples_size * sizeof(int32_t));
+
+        if(adc_temperatures == NULL || adc_pressures == NULL) return EXIT_FAILURE;
+
+        /* raw adc readings around the datasheet example */
+        for(uint32_t i = 0; i < samples_size; i++) {
+            adc_temperatures[i] = 519888 + (int32_t)(i % 2000) - 1000;
+            adc_pressures[i]    = 415148 + (int32_t)((i * 37) % 20000) - 10000;
+        }
+
+        for(size_t c = 0; c < sizeof(s_compensations) / sizeof(s_compensations[0]); c++) {
+            double best_ns = INFINITY;
+
+            bmp280.compensation = s_compensations[c].compensation;
+
+            for(int run = 0; run < BENCH_RUNS; run++) {
+                double sum = 0;
+                double start = bench_now_ns();
+                for(uint32_t p = 0; p < passes; p++) {
+                    for(uint32_t i = 0; i < samples_size; i++) {
+                        float temperature, pressure;
+                        i2c_bmp280_compensate_measurements(&bmp280, adc_temperatures[i], adc_pressures[i], 0, &temperature, &pressure, NULL);
+                        sum += temperature + pressure;
+                    }
+                }
+                double ns = (bench_now_ns() - start) / ((double)passes * samples_size);
+                if(ns < best_ns) best_ns = ns;
+                s_bench_sink = sum;
+            }
+
+            bench_report(s_compensations[c].benchmark, samples_size, best_ns, sizeof(i2c_bmp280_t) + sizeof(i2c_bmp280_cal_factors_t));
+        }
+
+        free(adc_temperatures);
+        free(adc_pressures);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file bench_machbase_row.c
+ *
+ * Host benchmark of the MACHBASE row serializer against the `malloc`, `snprintf` 
+ * and `free` row formatting it replaces.  Rows of both are compared for equality 
+ * before timing.  Results are printed as one JSON object per line.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include <machbase_row.h>
+
+#define BENCH_DEVICE_ID         "CA.NB.AWS.01-1000"
+#define BENCH_PARAMETER         "Atmospheric-Pressure"
+#define BENCH_ROW_BUFFER_SIZE   (200)
+#define BENCH_ITERATIONS        (1000000)
+
+static double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static float bench_value(const uint32_t i) {
+    return 950.0f + (float)(i % 10000) * 0.0137f;
+}
+
+static size_t bench_snprintf_row(const uint64_t timestamp, const float value, volatile char *sink) {
+    char* msg = malloc(BENCH_ROW_BUFFER_SIZE);
+    int len = snprintf(msg, BENCH_ROW_BUFFER_SIZE, "[\"%s.%s\",%llu,%f,\"%s\",\"%s\"]", 
+                    BENCH_DEVICE_ID, BENCH_PARAMETER, (unsigned long long)timestamp, value, 
+                    BENCH_PARAMETER, BENCH_DEVICE_ID);
+    *sink = msg[len - 1];
+    free(msg);
+    return (size_t)len;
+}
+
+int main(void) {
+    machbase_row_template_t row_template;
+    char            row[BENCH_ROW_BUFFER_SIZE];
+    char            expected[BENCH_ROW_BUFFER_SIZE];
+    volatile char   sink;
+    uint64_t        timestamp = 1729957661187888000ULL;
+    uint32_t        mismatches = 0;
+
+    if(machbase_row_template_init(BENCH_DEVICE_ID, BENCH_PARAMETER, &row_template) != ESP_OK) return EXIT_FAILURE;
+
+    /* validate serialized rows against snprintf rows */
+    for(uint32_t i = 0; i < 100000; i++) {
+        const float value = (i & 1) ? bench_value(i) : -bench_value(i) / (float)(i + 1);
+        size_t len = machbase_row_serialize(&row_template, timestamp + i, value, row, sizeof(row));
+        snprintf(expected, sizeof(expected), "[\"%s.%s\",%llu,%f,\"%s\",\"%s\"]", 
+                BENCH_DEVICE_ID, BENCH_PARAMETER, (unsigned long long)(timestamp + i), value, 
+                BENCH_PARAMETER, BENCH_DEVICE_ID);
+        if(len != strlen(expected) || memcmp(row, expected, len) != 0) {
+            if(mismatches++ < 5) fprintf(stderr, "mismatch: %.*s != %s\n", (int)len, row, expected);
+        }
+    }
+
+    /* baseline: heap buffer and printf formatting per row */
+    double start = bench_now_ns();
+    for(uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        bench_snprintf_row(timestamp + i, bench_value(i), &sink);
+    }
+    double snprintf_ns = (bench_now_ns() - start) / BENCH_ITERATIONS;
+
+    /* serializer: reusable buffer and precomputed row template */
+    start = bench_now_ns();
+    for(uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        size_t len = machbase_row_serialize(&row_template, timestamp + i, bench_value(i), row, sizeof(row));
+        sink = row[len - 1];
+    }
+    double serialize_ns = (bench_now_ns() - start) / BENCH_ITERATIONS;
+
+    printf("{\"benchmark\":\"machbase_row_snprintf_malloc\",\"ns_per_op\":%.1f}\n", snprintf_ns);
+    printf("{\"benchmark\":\"machbase_row_serialize\",\"ns_per_op\":%.1f,\"bytes_per_handle\":%zu,\"mismatches\":%u}\n", 
+            serialize_ns, sizeof(row_template), mismatches);
+
+    (void)sink;
+    return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file ahtxx_sim.c
+ *
+ * Simulated AHTXX device for the host build.
+ */
+#include <string.h>
+#include <math.h>
+
+#include "ahtxx_sim.h"
+
+#define AHTXX_SIM_CMD_AHT10_INIT    (0xE1)
+#define AHTXX_SIM_CMD_AHT2X_INIT    (0xBE)
+#define AHTXX_SIM_CMD_STATUS        (0x71)
+#define AHTXX_SIM_CMD_TRIGGER_MEAS  (0xAC)
+#define AHTXX_SIM_CMD_RESET         (0xBA)
+#define AHTXX_SIM_STATUS_BUSY       (0x80)
+#define AHTXX_SIM_STATUS_WORD       (0x18)
+
+/* updates the busy bit and measurement frame to the simulated host clock */
+static void ahtxx_sim_update(ahtxx_sim_t *const sim) {
+    if((sim->status & AHTXX_SIM_STATUS_BUSY) && i2c_sim_clock_get_us() >= sim->busy_until_us) {
+        const uint32_t humidity    = (uint32_t)lround(sim->humidity / 100.0 * 0x100000) & 0xfffff;
+        const uint32_t temperature = (uint32_t)lround((sim->temperature + 50.0) / 200.0 * 0x100000) & 0xfffff;
+        sim->status  &= (uint8_t)~AHTXX_SIM_STATUS_BUSY;
+        sim->frame[1] = (uint8_t)(humidity >> 12);
+        sim->frame[2] = (uint8_t)(humidity >> 4);
+        sim->frame[3] = (uint8_t)(((humidity & 0x0f) << 4) | (temperature >> 16));
+        sim->frame[4] = (uint8_t)(temperature >> 8);
+        sim->frame[5] = (uint8_t)temperature;
+        sim->measurements++;
+    }
+    sim->frame[0] = sim->status;
+}
+
+static esp_err_t ahtxx_sim_transmit(void *context, const uint8_t *data, size_t size) {
+    ahtxx_sim_t *sim = (ahtxx_sim_t *)context;
+
+    ahtxx_sim_update(sim);
+
+    switch(data[0]) {
+        case AHTXX_SIM_CMD_RESET:
+            sim->status = AHTXX_SIM_STATUS_WORD;
+            return ESP_OK;
+        case AHTXX_SIM_CMD_AHT10_INIT:
+        case AHTXX_SIM_CMD_AHT2X_INIT:
+            sim->status |= 0x08;
+            return ESP_OK;
+        case AHTXX_SIM_CMD_STATUS:
+            return ESP_OK;
+        case AHTXX_SIM_CMD_TRIGGER_MEAS:
+            if(size != 3) return ESP_ERR_INVALID_SIZE;
+            sim->status       |= AHTXX_SIM_STATUS_BUSY;
+            sim->busy_until_us = i2c_sim_clock_get_us() + sim->measurement_us;
+            return ESP_OK;
+        default:
+            return ESP_ERR_INVALID_ARG;
+    }
+}
+
+static esp_err_t ahtxx_sim_receive(void *context, uint8_t *data, size_t size) {
+    ahtxx_sim_t *sim = (ahtxx_sim_t *)context;
+
+    ahtxx_sim_update(sim);
+
+    /* status byte followed by the measurement frame */
+    for(size_t i = 0; i < size; i++) {
+        data[i] = (i < sizeof(sim->frame)) ? sim->frame[i] : 0xff;
+    }
+
+    return ESP_OK;
+}
+
+void ahtxx_sim_init(ahtxx_sim_t *const sim, const uint16_t address) {
+    memset(sim, 0, sizeof(*sim));
+    sim->device.address  = address;
+    sim->device.context  = sim;
+    sim->device.transmit = ahtxx_sim_transmit;
+    sim->device.receive  = ahtxx_sim_receive;
+    sim->status          = AHTXX_SIM_STATUS_WORD;
+    sim->measurement_us  = AHTXX_SIM_MEASUREMENT_TIME_US;
+    sim->temperature     = 25.0;
+    sim->humidity        = 50.0;
+}
+
+void ahtxx_sim_set_environment(ahtxx_sim_t *const sim, const double temperature, const double humidity) {
+    sim->temperature = temperature;
+    sim->humidity    = humidity;
+}
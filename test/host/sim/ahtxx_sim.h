@@ -0,0 +1,56 @@
+/**
+ * @file ahtxx_sim.h
+ *
+ * Simulated AHTXX device for the host build.  Models the status word, soft-reset, 
+ * initialization and measurement trigger commands and the 6-byte measurement frame.  
+ * The busy bit is set for the measurement time after a trigger on the simulated 
+ * host clock.
+ */
+#ifndef __AHTXX_SIM_H__
+#define __AHTXX_SIM_H__
+
+#include <stdint.h>
+#include "i2c_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AHTXX_SIM_MEASUREMENT_TIME_US   (80000)     /*!< datasheet typical measurement time */
+
+/**
+ * @brief Simulated AHTXX device structure.
+ */
+typedef struct ahtxx_sim_tag {
+    i2c_sim_device_t    device;             /*!< simulated i2c device, attach with `i2c_sim_attach_device` */
+    uint8_t             status;             /*!< status word, bit 7 busy and bit 3 calibrated */
+    double              temperature;        /*!< simulated air temperature in degrees celsius */
+    double              humidity;           /*!< simulated relative humidity in percent */
+    uint32_t            measurement_us;     /*!< measurement time, `AHTXX_SIM_MEASUREMENT_TIME_US` by default */
+    int64_t             busy_until_us;      /*!< end time of the running measurement */
+    uint8_t             frame[6];           /*!< measurement frame of the last completed measurement */
+    uint32_t            measurements;       /*!< number of completed measurements */
+} ahtxx_sim_t;
+
+/**
+ * @brief Initializes a simulated AHTXX device, calibrated at 25 degrees celsius and 50 percent.
+ * 
+ * @param sim Simulated device.
+ * @param address Device address.
+ */
+void ahtxx_sim_init(ahtxx_sim_t *const sim, const uint16_t address);
+
+/**
+ * @brief Sets the simulated environment, takes effect at the next measurement trigger.
+ * 
+ * @param sim Simulated device.
+ * @param temperature Air temperature in degrees celsius.
+ * @param humidity Relative humidity in percent.
+ */
+void ahtxx_sim_set_environment(ahtxx_sim_t *const sim, const double temperature, const double humidity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __AHTXX_SIM_H__
@@ -0,0 +1,244 @@
+/**
+ * @file bmp280_sim.c
+ *
+ * Simulated BMP280 device for the host build.
+ */
+#include <string.h>
+#include <math.h>
+
+#include "bmp280_sim.h"
+
+#define BMP280_SIM_REG_CALIB    (0x88)
+#define BMP280_SIM_REG_HUM_H1   (0xA1)
+#define BMP280_SIM_REG_HUM_CALIB (0xE1)
+#define BMP280_SIM_REG_CTRL_HUM (0xF2)
+#define BMP280_SIM_REG_HUM      (0xFD)
+#define BMP280_SIM_REG_ID       (0xD0)
+#define BMP280_SIM_REG_RESET    (0xE0)
+#define BMP280_SIM_REG_STATUS   (0xF3)
+#define BMP280_SIM_REG_CTRL     (0xF4)
+#define BMP280_SIM_REG_CONFIG   (0xF5)
+#define BMP280_SIM_REG_PRESS    (0xF7)
+#define BMP280_SIM_REG_TEMP     (0xFA)
+#define BMP280_SIM_RESET_VALUE  (0xB6)
+#define BMP280_SIM_ADC_SKIPPED  (0x80000)
+#define BMP280_SIM_HUM_SKIPPED  (0x8000)
+
+/* datasheet section 3.11.3 example calibration */
+static const uint16_t s_calibration[12] = { 27504, 26435, (uint16_t)-1000, 36477, (uint16_t)-10685, 3024, 2855, 140, (uint16_t)-7, 15500, (uint16_t)-14600, 6000 };
+
+/* typical bme280 humidity calibration, H1 and the 0xE1 to 0xE7 block of H2 = 362, H3 = 0, H4 = 313, H5 = 50, H6 = 30 */
+static const uint8_t s_hum_h1 = 75;
+static const uint8_t s_hum_calibration[7] = { 0x6a, 0x01, 0x00, 0x13, 0x29, 0x03, 0x1e };
+
+/* oversampling setting to number of samples */
+static const uint8_t s_oversampling[8] = { 0, 1, 2, 4, 8, 16, 16, 16 };
+
+/* standby time setting to micro-seconds */
+static const int64_t s_standby_us[8] = { 500, 62500, 125000, 250000, 500000, 1000000, 2000000, 4000000 };
+
+static uint16_t bmp280_sim_cal_u16(const bmp280_sim_t *const sim, const uint8_t index) {
+    return (uint16_t)(sim->regs[BMP280_SIM_REG_CALIB + index * 2] | (sim->regs[BMP280_SIM_REG_CALIB + index * 2 + 1] << 8));
+}
+
+static int16_t bmp280_sim_cal_s16(const bmp280_sim_t *const sim, const uint8_t index) {
+    return (int16_t)bmp280_sim_cal_u16(sim, index);
+}
+
+double bmp280_sim_compensate_temperature(const bmp280_sim_t *const sim, const int32_t adc_temperature, double *const fine_temperature) {
+    const double t1 = bmp280_sim_cal_u16(sim, 0), t2 = bmp280_sim_cal_s16(sim, 1), t3 = bmp280_sim_cal_s16(sim, 2);
+    double var1 = (adc_temperature / 16384.0 - t1 / 1024.0) * t2;
+    double var2 = (adc_temperature / 131072.0 - t1 / 8192.0) * (adc_temperature / 131072.0 - t1 / 8192.0) * t3;
+    *fine_temperature = var1 + var2;
+    return (var1 + var2) / 5120.0;
+}
+
+double bmp280_sim_compensate_pressure(const bmp280_sim_t *const sim, const int32_t adc_pressure, const double fine_temperature) {
+    const double p1 = bmp280_sim_cal_u16(sim, 3), p2 = bmp280_sim_cal_s16(sim, 4), p3 = bmp280_sim_cal_s16(sim, 5);
+    const double p4 = bmp280_sim_cal_s16(sim, 6), p5 = bmp280_sim_cal_s16(sim, 7), p6 = bmp280_sim_cal_s16(sim, 8);
+    const double p7 = bmp280_sim_cal_s16(sim, 9), p8 = bmp280_sim_cal_s16(sim, 10), p9 = bmp280_sim_cal_s16(sim, 11);
+    double var1 = fine_temperature / 2.0 - 64000.0;
+    double var2 = var1 * var1 * p6 / 32768.0;
+    var2 = var2 + var1 * p5 * 2.0;
+    var2 = var2 / 4.0 + p4 * 65536.0;
+    var1 = (p3 * var1 * var1 / 524288.0 + p2 * var1) / 524288.0;
+    var1 = (1.0 + var1 / 32768.0) * p1;
+    if(var1 == 0.0) return 0;
+    double p = 1048576.0 - adc_pressure;
+    p = (p - var2 / 4096.0) * 6250.0 / var1;
+    var1 = p9 * p * p / 2147483648.0;
+    var2 = p * p8 / 32768.0;
+    return p + (var1 + var2 + p7) / 16.0;
+}
+
+double bmp280_sim_compensate_humidity(const bmp280_sim_t *const sim, const int32_t adc_humidity, const double fine_temperature) {
+    const uint8_t *const calib = &sim->regs[BMP280_SIM_REG_HUM_CALIB];
+    const double h1 = sim->regs[BMP280_SIM_REG_HUM_H1], h2 = (int16_t)(calib[1] << 8 | calib[0]), h3 = calib[2];
+    const double h4 = (int16_t)((int8_t)calib[3] * 16 | (calib[4] & 0x0f)), h5 = (int16_t)((int8_t)calib[5] * 16 | (calib[4] >> 4)), h6 = (int8_t)calib[6];
+    double h = fine_temperature - 76800.0;
+    h = (adc_humidity - (h4 * 64.0 + h5 / 16384.0 * h)) * (h2 / 65536.0 * (1.0 + h6 / 67108864.0 * h * (1.0 + h3 / 67108864.0 * h)));
+    h = h * (1.0 - h1 * h / 524288.0);
+    return (h > 100.0) ? 100.0 : (h < 0.0) ? 0.0 : h;
+}
+
+int64_t bmp280_sim_measurement_time_us(const bmp280_sim_t *const sim) {
+    const uint8_t osrs_t = s_oversampling[(sim->regs[BMP280_SIM_REG_CTRL] >> 5) & 0x07];
+    const uint8_t osrs_p = s_oversampling[(sim->regs[BMP280_SIM_REG_CTRL] >> 2) & 0x07];
+    const uint8_t osrs_h = (sim->regs[BMP280_SIM_REG_ID] == BMP280_SIM_CHIP_ID_BME280) ? s_oversampling[sim->ctrl_hum & 0x07] : 0;
+    /* datasheet section 3.8.1 and bme280 datasheet section 9.1, typical measurement time */
+    return 1000 + 2000 * osrs_t + (osrs_p ? 2000 * osrs_p + 500 : 0) + (osrs_h ? 2000 * osrs_h + 500 : 0);
+}
+
+static void bmp280_sim_set_adc(bmp280_sim_t *const sim, const uint8_t reg, const uint32_t adc) {
+    sim->regs[reg]     = (uint8_t)(adc >> 12);
+    sim->regs[reg + 1] = (uint8_t)(adc >> 4);
+    sim->regs[reg + 2] = (uint8_t)((adc & 0x0f) << 4);
+}
+
+/* transfers a conversion of the simulated environment to the data registers */
+static void bmp280_sim_convert(bmp280_sim_t *const sim) {
+    const uint8_t ctrl = sim->regs[BMP280_SIM_REG_CTRL];
+    int32_t lo, hi;
+    double  fine_temperature;
+
+    /* temperature increases with raw temperature */
+    for(lo = 0, hi = 0xfffff; lo < hi; ) {
+        int32_t mid = (lo + hi) / 2;
+        if(bmp280_sim_compensate_temperature(sim, mid, &fine_temperature) < sim->temperature) lo = mid + 1; else hi = mid;
+    }
+    const int32_t adc_temperature = lo;
+    bmp280_sim_compensate_temperature(sim, adc_temperature, &fine_temperature);
+
+    /* pressure decreases with raw pressure */
+    for(lo = 0, hi = 0xfffff; lo < hi; ) {
+        int32_t mid = (lo + hi) / 2;
+        if(bmp280_sim_compensate_pressure(sim, mid, fine_temperature) > sim->pressure) lo = mid + 1; else hi = mid;
+    }
+    const int32_t adc_pressure = lo;
+
+    bmp280_sim_set_adc(sim, BMP280_SIM_REG_TEMP, ((ctrl >> 5) & 0x07) ? (uint32_t)adc_temperature : BMP280_SIM_ADC_SKIPPED);
+    bmp280_sim_set_adc(sim, BMP280_SIM_REG_PRESS, ((ctrl >> 2) & 0x07) ? (uint32_t)adc_pressure : BMP280_SIM_ADC_SKIPPED);
+
+    if(sim->regs[BMP280_SIM_REG_ID] == BMP280_SIM_CHIP_ID_BME280) {
+        /* humidity increases with raw humidity */
+        for(lo = 0, hi = 0xffff; lo < hi; ) {
+            int32_t mid = (lo + hi) / 2;
+            if(bmp280_sim_compensate_humidity(sim, mid, fine_temperature) < sim->humidity) lo = mid + 1; else hi = mid;
+        }
+        const uint32_t adc_humidity = (sim->ctrl_hum & 0x07) ? (uint32_t)lo : BMP280_SIM_HUM_SKIPPED;
+        sim->regs[BMP280_SIM_REG_HUM]     = (uint8_t)(adc_humidity >> 8);
+        sim->regs[BMP280_SIM_REG_HUM + 1] = (uint8_t)adc_humidity;
+    }
+
+    sim->conversions++;
+}
+
+/* advances the conversion state machine to the simulated host clock */
+static void bmp280_sim_update(bmp280_sim_t *const sim) {
+    const int64_t now  = i2c_sim_clock_get_us();
+    const uint8_t mode = sim->regs[BMP280_SIM_REG_CTRL] & 0x03;
+
+    sim->regs[BMP280_SIM_REG_STATUS] = 0;
+
+    if(mode == 0x01 || mode == 0x02) {
+        /* forced mode, return to sleep mode once converted */
+        if(now < sim->conversion_end_us) {
+            sim->regs[BMP280_SIM_REG_STATUS] = 0x08;
+        } else {
+            bmp280_sim_convert(sim);
+            sim->regs[BMP280_SIM_REG_CTRL] &= (uint8_t)~0x03;
+        }
+    } else if(mode == 0x03) {
+        /* normal mode, measurement followed by standby */
+        const int64_t measurement = bmp280_sim_measurement_time_us(sim);
+        const int64_t period      = measurement + s_standby_us[(sim->regs[BMP280_SIM_REG_CONFIG] >> 5) & 0x07];
+        const int64_t elapsed     = now - sim->conversion_start_us;
+        if(elapsed % period < measurement) sim->regs[BMP280_SIM_REG_STATUS] = 0x08;
+        if(elapsed >= measurement) {
+            const uint32_t completed = (uint32_t)((elapsed - measurement) / period) + 1;
+            if(completed != sim->normal_cycles) {
+                sim->normal_cycles = completed;
+                bmp280_sim_convert(sim);
+            }
+        }
+    }
+}
+
+static esp_err_t bmp280_sim_transmit(void *context, const uint8_t *data, size_t size) {
+    bmp280_sim_t *sim = (bmp280_sim_t *)context;
+
+    sim->pointer = data[0];
+
+    /* register address and data pairs */
+    for(size_t i = 0; i + 1 < size; i += 2) {
+        const uint8_t reg = data[i];
+        const uint8_t val = data[i + 1];
+        if(reg == BMP280_SIM_REG_RESET) {
+            if(val == BMP280_SIM_RESET_VALUE) {
+                sim->regs[BMP280_SIM_REG_STATUS] = 0;
+                sim->regs[BMP280_SIM_REG_CTRL]   = 0;
+                sim->regs[BMP280_SIM_REG_CONFIG] = 0;
+                sim->regs[BMP280_SIM_REG_CTRL_HUM] = 0;
+                sim->ctrl_hum = 0;
+            }
+        } else if(reg == BMP280_SIM_REG_CTRL) {
+            sim->regs[reg] = val;
+            sim->ctrl_hum  = sim->regs[BMP280_SIM_REG_CTRL_HUM];
+            sim->conversion_start_us = i2c_sim_clock_get_us();
+            sim->conversion_end_us   = sim->conversion_start_us + bmp280_sim_measurement_time_us(sim);
+            sim->normal_cycles       = 0;
+        } else if(reg >= 0xF2 && reg <= 0xF5 && reg != BMP280_SIM_REG_STATUS) {
+            sim->regs[reg] = val;
+        } else {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t bmp280_sim_receive(void *context, uint8_t *data, size_t size) {
+    bmp280_sim_t *sim = (bmp280_sim_t *)context;
+
+    bmp280_sim_update(sim);
+
+    /* auto-incremented register reads */
+    for(size_t i = 0; i < size; i++) {
+        data[i] = sim->regs[sim->pointer++];
+    }
+
+    return ESP_OK;
+}
+
+void bmp280_sim_init(bmp280_sim_t *const sim, const uint16_t address, const uint8_t chip_id) {
+    memset(sim, 0, sizeof(*sim));
+    sim->device.address  = address;
+    sim->device.context  = sim;
+    sim->device.transmit = bmp280_sim_transmit;
+    sim->device.receive  = bmp280_sim_receive;
+    for(uint8_t i = 0; i < 12; i++) {
+        sim->regs[BMP280_SIM_REG_CALIB + i * 2]     = (uint8_t)(s_calibration[i] & 0xff);
+        sim->regs[BMP280_SIM_REG_CALIB + i * 2 + 1] = (uint8_t)(s_calibration[i] >> 8);
+    }
+    if(chip_id == BMP280_SIM_CHIP_ID_BME280) {
+        sim->regs[BMP280_SIM_REG_HUM_H1] = s_hum_h1;
+        memcpy(&sim->regs[BMP280_SIM_REG_HUM_CALIB], s_hum_calibration, sizeof(s_hum_calibration));
+        sim->regs[BMP280_SIM_REG_HUM]     = (uint8_t)(BMP280_SIM_HUM_SKIPPED >> 8);
+        sim->regs[BMP280_SIM_REG_HUM + 1] = (uint8_t)BMP280_SIM_HUM_SKIPPED;
+    }
+    sim->regs[BMP280_SIM_REG_ID] = chip_id;
+    bmp280_sim_set_adc(sim, BMP280_SIM_REG_TEMP, BMP280_SIM_ADC_SKIPPED);
+    bmp280_sim_set_adc(sim, BMP280_SIM_REG_PRESS, BMP280_SIM_ADC_SKIPPED);
+    sim->temperature = 25.08;
+    sim->pressure    = 100653.27;
+    sim->humidity    = 50.0;
+}
+
+void bmp280_sim_set_environment(bmp280_sim_t *const sim, const double temperature, const double pressure) {
+    sim->temperature = temperature;
+    sim->pressure    = pressure;
+}
+
+void bmp280_sim_set_humidity(bmp280_sim_t *const sim, const double humidity) {
+    sim->humidity = humidity;
+}
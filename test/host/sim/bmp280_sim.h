@@ -0,0 +1,114 @@
+/**
+ * @file bmp280_sim.h
+ *
+ * Simulated BMP280 device for the host build.  Models the calibration, identifier, 
+ * reset, status, control measurement, configuration and data registers.  Conversions 
+ * take the datasheet typical measurement time on the simulated host clock, forced 
+ * conversions return to sleep mode and normal mode cycles between measurement and 
+ * standby.  ADC data are derived from the simulated temperature and pressure with 
+ * the datasheet floating-point compensation.  Devices initialized as a BME280 add the 
+ * humidity calibration, control humidity and humidity data registers, the humidity 
+ * oversampling takes effect when the control measurement register is written.
+ */
+#ifndef __BMP280_SIM_H__
+#define __BMP280_SIM_H__
+
+#include <stdint.h>
+#include "i2c_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BMP280_SIM_CHIP_ID_BMP280   (0x58)  /*!< bmp280 chip identifier */
+#define BMP280_SIM_CHIP_ID_BME280   (0x60)  /*!< bme280 chip identifier */
+
+/**
+ * @brief Simulated BMP280 device structure.
+ */
+typedef struct bmp280_sim_tag {
+    i2c_sim_device_t    device;                 /*!< simulated i2c device, attach with `i2c_sim_attach_device` */
+    uint8_t             regs[256];              /*!< register map */
+    uint8_t             pointer;                /*!< register pointer of the next read */
+    double              temperature;            /*!< simulated air temperature in degrees celsius */
+    double              pressure;               /*!< simulated air pressure in pascal */
+    double              humidity;               /*!< simulated relative humidity in percent, bme280 only */
+    uint8_t             ctrl_hum;               /*!< control humidity register latched by the last control measurement register write */
+    int64_t             conversion_start_us;    /*!< start time of the running forced conversion or of normal mode */
+    int64_t             conversion_end_us;      /*!< end time of the running forced conversion */
+    uint32_t            normal_cycles;          /*!< number of normal mode cycles completed since normal mode was set */
+    uint32_t            conversions;            /*!< number of conversions transferred to the data registers */
+} bmp280_sim_t;
+
+/**
+ * @brief Initializes a simulated BMP280 device with the datasheet example calibration 
+ * at 25 degrees celsius and 1006.53 hPa.  A BME280 adds a typical humidity calibration 
+ * at 50 percent relative humidity.
+ * 
+ * @param sim Simulated device.
+ * @param address Device address.
+ * @param chip_id Chip identifier register value.
+ */
+void bmp280_sim_init(bmp280_sim_t *const sim, const uint16_t address, const uint8_t chip_id);
+
+/**
+ * @brief Sets the simulated environment, takes effect at the next conversion.
+ * 
+ * @param sim Simulated device.
+ * @param temperature Air temperature in degrees celsius.
+ * @param pressure Air pressure in pascal.
+ */
+void bmp280_sim_set_environment(bmp280_sim_t *const sim, const double temperature, const double pressure);
+
+/**
+ * @brief Sets the simulated relative humidity of a BME280, takes effect at the next conversion.
+ * 
+ * @param sim Simulated device.
+ * @param humidity Relative humidity in percent.
+ */
+void bmp280_sim_set_humidity(bmp280_sim_t *const sim, const double humidity);
+
+/**
+ * @brief Gets the datasheet typical measurement time of the configured oversampling, 
+ * conversions of the simulated device take the typical time.
+ * 
+ * @param sim Simulated device.
+ * @return int64_t Measurement time in micro-seconds.
+ */
+int64_t bmp280_sim_measurement_time_us(const bmp280_sim_t *const sim);
+
+/**
+ * @brief Datasheet floating-point temperature compensation.
+ * 
+ * @param sim Simulated device.
+ * @param adc_temperature Raw temperature.
+ * @param fine_temperature Fine temperature.
+ * @return double Temperature in degrees celsius.
+ */
+double bmp280_sim_compensate_temperature(const bmp280_sim_t *const sim, const int32_t adc_temperature, double *const fine_temperature);
+
+/**
+ * @brief Datasheet floating-point pressure compensation.
+ * 
+ * @param sim Simulated device.
+ * @param adc_pressure Raw pressure.
+ * @param fine_temperature Fine temperature.
+ * @return double Pressure in pascal.
+ */
+double bmp280_sim_compensate_pressure(const bmp280_sim_t *const sim, const int32_t adc_pressure, const double fine_temperature);
+
+/**
+ * @brief BME280 datasheet floating-point humidity compensation.
+ * 
+ * @param sim Simulated device.
+ * @param adc_humidity Raw humidity.
+ * @param fine_temperature Fine temperature.
+ * @return double Relative humidity in percent.
+ */
+double bmp280_sim_compensate_humidity(const bmp280_sim_t *const sim, const int32_t adc_humidity, const double fine_temperature);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __BMP280_SIM_H__
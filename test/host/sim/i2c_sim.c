@@ -0,0 +1,436 @@
+/**
+ * @file i2c_sim.c
+ *
+ * Simulated i2c master bus, host clock, system clock, one-shot timers and FreeRTOS task 
+ * delay and notifications for the host build.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <esp_timer.h>
+#include <esp_rom_sys.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "i2c_sim.h"
+
+#define I2C_SIM_SCL_SPEED_HZ    (100000)    /*!< bus clock when the device configuration does not set one */
+#define I2C_SIM_BITS_PER_BYTE   (9)         /*!< 8 data bits and an acknowledge bit */
+
+/* queued asynchronous transaction, completes at `end_us` on the simulated clock, the buffers are the caller's as with esp-idf */
+typedef struct i2c_sim_trans_tag {
+    i2c_master_dev_handle_t dev;
+    const uint8_t*          tx;
+    size_t                  tx_size;
+    uint8_t*                rx;
+    size_t                  rx_size;
+    int64_t                 end_us;
+} i2c_sim_trans_t;
+
+struct i2c_master_bus_t {
+    i2c_sim_device_t*       devices[I2C_SIM_DEVICES_MAX];
+    uint8_t                 devices_count;
+    i2c_sim_stats_t         stats;
+    i2c_sim_trans_t*        queue;              /* asynchronous transactions queue, NULL when the bus is synchronous */
+    size_t                  queue_depth;
+    size_t                  queue_head;
+    size_t                  queue_count;
+    int64_t                 busy_until_us;      /* end of the last queued asynchronous transaction */
+    bool                    held;               /* a device holds SDA low, transactions time out until the bus is reset */
+    struct i2c_master_bus_t *next;
+};
+
+struct i2c_master_dev_t {
+    i2c_master_bus_handle_t         bus;
+    i2c_device_config_t             config;
+    i2c_master_event_callbacks_t    cbs;
+    void*                           user_data;
+};
+
+/* one-shot timer, the callback runs when the simulated clock reaches `alarm_us` */
+struct esp_timer {
+    esp_timer_create_args_t args;
+    int64_t                 alarm_us;
+    bool                    armed;
+    struct esp_timer        *next;
+};
+
+static int64_t                  s_clock_us = 0;
+static int64_t                  s_busy_wait_us = 0;        /* total time busy-waited with esp_rom_delay_us */
+static int64_t                  s_epoch_offset_us = 0;     /* unix epoch (UTC) of the simulated clock start */
+static struct i2c_master_bus_t *s_buses = NULL;
+static struct esp_timer        *s_timers = NULL;
+static uint32_t                 s_notifications = 0;
+
+static esp_err_t i2c_sim_transfer(i2c_master_dev_handle_t dev, const uint8_t *write_buffer, size_t write_size, uint8_t *read_buffer, size_t read_size);
+
+/* gets the bus with the earliest pending asynchronous transaction completion, NULL when none */
+static i2c_master_bus_handle_t i2c_sim_next_completion(void) {
+    i2c_master_bus_handle_t next = NULL;
+    for(i2c_master_bus_handle_t bus = s_buses; bus != NULL; bus = bus->next) {
+        if(bus->queue_count == 0) continue;
+        if(next == NULL || bus->queue[bus->queue_head].end_us < next->queue[next->queue_head].end_us) next = bus;
+    }
+    return next;
+}
+
+/* completes the oldest asynchronous transaction of a bus and invokes the device transaction done callback */
+static void i2c_sim_complete(i2c_master_bus_handle_t bus) {
+    i2c_sim_trans_t trans = bus->queue[bus->queue_head];
+    bus->queue_head = (bus->queue_head + 1) % bus->queue_depth;
+    bus->queue_count--;
+
+    esp_err_t ret = i2c_sim_transfer(trans.dev, trans.tx, trans.tx_size, trans.rx, trans.rx_size);
+    if(trans.dev->cbs.on_trans_done) {
+        const i2c_master_event_data_t evt_data = { .event = (ret == ESP_OK) ? I2C_EVENT_DONE : I2C_EVENT_NACK };
+        trans.dev->cbs.on_trans_done(trans.dev, &evt_data, trans.dev->user_data);
+    }
+}
+
+/* gets the armed timer with the earliest alarm, NULL when none */
+static esp_timer_handle_t i2c_sim_next_alarm(void) {
+    esp_timer_handle_t next = NULL;
+    for(esp_timer_handle_t timer = s_timers; timer != NULL; timer = timer->next) {
+        if(timer->armed == false) continue;
+        if(next == NULL || timer->alarm_us < next->alarm_us) next = timer;
+    }
+    return next;
+}
+
+/* runs the earliest asynchronous transaction completion or timer alarm due by `target_us`, false when none is due */
+static bool i2c_sim_run_next(const int64_t target_us) {
+    i2c_master_bus_handle_t bus   = i2c_sim_next_completion();
+    esp_timer_handle_t      timer = i2c_sim_next_alarm();
+    const int64_t bus_us   = bus ? bus->queue[bus->queue_head].end_us : INT64_MAX;
+    const int64_t timer_us = timer ? timer->alarm_us : INT64_MAX;
+
+    if(bus != NULL && bus_us <= timer_us) {
+        if(bus_us > target_us) return false;
+        if(bus_us > s_clock_us) s_clock_us = bus_us;
+        i2c_sim_complete(bus);
+        return true;
+    }
+    if(timer != NULL) {
+        if(timer_us > target_us) return false;
+        if(timer_us > s_clock_us) s_clock_us = timer_us;
+        timer->armed = false;
+        timer->args.callback(timer->args.arg);
+        return true;
+    }
+    return false;
+}
+
+/* runs the simulated clock to `target_us`, completing asynchronous transactions and running timer alarms on the way */
+static void i2c_sim_run_until(const int64_t target_us) {
+    while(i2c_sim_run_next(target_us)) {}
+    if(target_us > s_clock_us) s_clock_us = target_us;
+}
+
+int64_t i2c_sim_clock_get_us(void) {
+    return s_clock_us;
+}
+
+void i2c_sim_clock_advance_us(const int64_t us) {
+    if(us > 0) i2c_sim_run_until(s_clock_us + us);
+}
+
+int64_t esp_timer_get_time(void) {
+    return s_clock_us;
+}
+
+void i2c_sim_clock_set_epoch_us(const int64_t epoch_us) {
+    s_epoch_offset_us = epoch_us - s_clock_us;
+}
+
+int gettimeofday(struct timeval *restrict tv, void *restrict tz) {
+    (void)tz;
+    const int64_t epoch_us = s_epoch_offset_us + s_clock_us;
+    tv->tv_sec  = (time_t)(epoch_us / 1000000);
+    tv->tv_usec = (suseconds_t)(epoch_us % 1000000);
+    return 0;
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* create_args, esp_timer_handle_t* out_handle) {
+    if(create_args == NULL || create_args->callback == NULL || out_handle == NULL) return ESP_ERR_INVALID_ARG;
+    esp_timer_handle_t timer = (esp_timer_handle_t)calloc(1, sizeof(struct esp_timer));
+    if(timer == NULL) return ESP_ERR_NO_MEM;
+    timer->args = *create_args;
+    timer->next = s_timers;
+    s_timers    = timer;
+    *out_handle = timer;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+    if(timer == NULL) return ESP_ERR_INVALID_ARG;
+    if(timer->armed) return ESP_ERR_INVALID_STATE;
+    timer->alarm_us = s_clock_us + (int64_t)timeout_us;
+    timer->armed    = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    if(timer == NULL) return ESP_ERR_INVALID_ARG;
+    if(timer->armed == false) return ESP_ERR_INVALID_STATE;
+    timer->armed = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    if(timer == NULL) return ESP_ERR_INVALID_ARG;
+    if(timer->armed) return ESP_ERR_INVALID_STATE;
+    for(struct esp_timer **t = &s_timers; *t != NULL; t = &(*t)->next) {
+        if(*t == timer) {
+            *t = timer->next;
+            break;
+        }
+    }
+    free(timer);
+    return ESP_OK;
+}
+
+int64_t i2c_sim_clock_get_busy_wait_us(void) {
+    return s_busy_wait_us;
+}
+
+void esp_rom_delay_us(uint32_t us) {
+    s_busy_wait_us += us;
+    i2c_sim_clock_advance_us(us);
+}
+
+/* tick boundary `ticks` ticks after the current partial tick, a delayed task wakes on the boundary as with the freertos tick interrupt */
+static inline int64_t i2c_sim_tick_boundary_us(const TickType_t ticks) {
+    const int64_t tick_us = (int64_t)portTICK_PERIOD_MS * 1000;
+    return (s_clock_us / tick_us + (int64_t)ticks) * tick_us;
+}
+
+void vTaskDelay(const TickType_t ticks) {
+    if(ticks > 0) i2c_sim_run_until(i2c_sim_tick_boundary_us(ticks));
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return (TickType_t)(s_clock_us / (portTICK_PERIOD_MS * 1000));
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return (TaskHandle_t)&s_notifications;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    if(task != NULL) s_notifications++;
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_task_woken) {
+    if(task != NULL) s_notifications++;
+    if(higher_priority_task_woken != NULL) *higher_priority_task_woken = pdFALSE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks) {
+    const int64_t timeout_us = (ticks == portMAX_DELAY) ? INT64_MAX : i2c_sim_tick_boundary_us(ticks);
+
+    /* nothing else runs on the host, only asynchronous transaction completions and timer alarms give notifications */
+    while(s_notifications == 0 && i2c_sim_run_next(timeout_us)) {}
+    if(s_notifications == 0) {
+        if(ticks != portMAX_DELAY) i2c_sim_run_until(timeout_us);
+        return 0;
+    }
+
+    const uint32_t notifications = s_notifications;
+    s_notifications = clear_on_exit ? 0 : s_notifications - 1;
+    return notifications;
+}
+
+static i2c_sim_device_t *i2c_sim_find_device(i2c_master_bus_handle_t bus, const uint16_t address) {
+    for(uint8_t i = 0; i < bus->devices_count; i++) {
+        if(bus->devices[i]->address == address) return bus->devices[i];
+    }
+    return NULL;
+}
+
+/* time on the wire, start, address, data and stop */
+static int64_t i2c_sim_wire_us(i2c_master_dev_handle_t dev, const size_t bytes, const uint8_t addresses) {
+    const uint32_t speed_hz = dev->config.scl_speed_hz ? dev->config.scl_speed_hz : I2C_SIM_SCL_SPEED_HZ;
+    const uint64_t bits     = (uint64_t)(bytes + addresses) * I2C_SIM_BITS_PER_BYTE + 2;
+    return (int64_t)((bits * 1000000U + speed_hz - 1) / speed_hz);
+}
+
+/* validates the device acknowledges the transaction */
+static esp_err_t i2c_sim_acknowledge(i2c_master_dev_handle_t dev, i2c_sim_device_t **device) {
+    *device = i2c_sim_find_device(dev->bus, dev->config.device_address);
+    if(*device == NULL) {
+        dev->bus->stats.nacks++;
+        return ESP_FAIL;
+    }
+    if((*device)->nack_count > 0) {
+        (*device)->nack_count--;
+        dev->bus->stats.nacks++;
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t *bus_config, i2c_master_bus_handle_t *ret_bus_handle) {
+    if(bus_config == NULL || ret_bus_handle == NULL) return ESP_ERR_INVALID_ARG;
+    i2c_master_bus_handle_t bus = (i2c_master_bus_handle_t)calloc(1, sizeof(struct i2c_master_bus_t));
+    if(bus == NULL) return ESP_ERR_NO_MEM;
+    /* a transactions queue depth puts the bus in asynchronous mode */
+    if(bus_config->trans_queue_depth > 0) {
+        bus->queue = (i2c_sim_trans_t *)calloc(bus_config->trans_queue_depth, sizeof(i2c_sim_trans_t));
+        if(bus->queue == NULL) {
+            free(bus);
+            return ESP_ERR_NO_MEM;
+        }
+        bus->queue_depth = bus_config->trans_queue_depth;
+    }
+    bus->next = s_buses;
+    s_buses   = bus;
+    *ret_bus_handle = bus;
+    return ESP_OK;
+}
+
+esp_err_t i2c_del_master_bus(i2c_master_bus_handle_t bus_handle) {
+    if(bus_handle == NULL) return ESP_ERR_INVALID_ARG;
+    for(struct i2c_master_bus_t **bus = &s_buses; *bus != NULL; bus = &(*bus)->next) {
+        if(*bus == bus_handle) {
+            *bus = bus_handle->next;
+            break;
+        }
+    }
+    free(bus_handle->queue);
+    free(bus_handle);
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_wait_all_done(i2c_master_bus_handle_t bus_handle, int timeout_ms) {
+    if(bus_handle == NULL) return ESP_ERR_INVALID_ARG;
+    const int64_t timeout_us = (timeout_ms < 0) ? INT64_MAX : s_clock_us + (int64_t)timeout_ms * 1000;
+    if(bus_handle->queue_count > 0 && bus_handle->busy_until_us > timeout_us) {
+        i2c_sim_run_until(timeout_us);
+        return ESP_ERR_TIMEOUT;
+    }
+    if(bus_handle->queue_count > 0) i2c_sim_run_until(bus_handle->busy_until_us);
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_register_event_callbacks(i2c_master_dev_handle_t i2c_dev, const i2c_master_event_callbacks_t *cbs, void *user_data) {
+    if(i2c_dev == NULL || cbs == NULL) return ESP_ERR_INVALID_ARG;
+    if(i2c_dev->bus->queue == NULL) return ESP_ERR_INVALID_STATE;
+    i2c_dev->cbs       = *cbs;
+    i2c_dev->user_data = user_data;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_reset(i2c_master_bus_handle_t bus_handle) {
+    if(bus_handle == NULL) return ESP_ERR_INVALID_ARG;
+    i2c_sim_clock_advance_us(100);
+    bus_handle->held = false;
+    bus_handle->stats.resets++;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus_handle, const i2c_device_config_t *dev_config, i2c_master_dev_handle_t *ret_handle) {
+    if(bus_handle == NULL || dev_config == NULL || ret_handle == NULL) return ESP_ERR_INVALID_ARG;
+    i2c_master_dev_handle_t dev = (i2c_master_dev_handle_t)calloc(1, sizeof(struct i2c_master_dev_t));
+    if(dev == NULL) return ESP_ERR_NO_MEM;
+    dev->bus    = bus_handle;
+    dev->config = *dev_config;
+    *ret_handle = dev;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle) {
+    if(handle == NULL) return ESP_ERR_INVALID_ARG;
+    free(handle);
+    return ESP_OK;
+}
+
+/* a transaction on a held bus times out */
+static esp_err_t i2c_sim_timeout(i2c_master_bus_handle_t bus, const int xfer_timeout_ms) {
+    bus->stats.timeouts++;
+    i2c_sim_clock_advance_us((int64_t)xfer_timeout_ms * 1000);
+    return ESP_ERR_TIMEOUT;
+}
+
+esp_err_t i2c_master_probe(i2c_master_bus_handle_t bus_handle, uint16_t address, int xfer_timeout_ms) {
+    if(bus_handle == NULL) return ESP_ERR_INVALID_ARG;
+    if(bus_handle->held) return i2c_sim_timeout(bus_handle, xfer_timeout_ms);
+    i2c_sim_clock_advance_us(100);
+    return i2c_sim_find_device(bus_handle, address) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+/* runs a transaction on the device, the wire time is accounted by the caller */
+static esp_err_t i2c_sim_transfer(i2c_master_dev_handle_t dev, const uint8_t *write_buffer, size_t write_size, uint8_t *read_buffer, size_t read_size) {
+    i2c_sim_device_t *device;
+    if(i2c_sim_acknowledge(dev, &device) != ESP_OK) return ESP_FAIL;
+    dev->bus->stats.bytes += write_size + read_size;
+    if(write_size > 0) {
+        esp_err_t ret = device->transmit(device->context, write_buffer, write_size);
+        if(ret != ESP_OK || read_size == 0) return ret;
+    }
+    return device->receive(device->context, read_buffer, read_size);
+}
+
+/* queues a transaction on an asynchronous bus, a full queue blocks until the oldest transaction completes */
+static esp_err_t i2c_sim_queue(i2c_master_dev_handle_t dev, const uint8_t *write_buffer, size_t write_size, uint8_t *read_buffer, size_t read_size, const uint8_t addresses) {
+    i2c_master_bus_handle_t bus = dev->bus;
+    if(bus->queue_count == bus->queue_depth) i2c_sim_run_until(bus->queue[bus->queue_head].end_us);
+    i2c_sim_trans_t *trans = &bus->queue[(bus->queue_head + bus->queue_count) % bus->queue_depth];
+    const int64_t start_us = (bus->busy_until_us > s_clock_us) ? bus->busy_until_us : s_clock_us;
+    trans->dev     = dev;
+    trans->tx      = write_buffer;
+    trans->tx_size = write_size;
+    trans->rx      = read_buffer;
+    trans->rx_size = read_size;
+    trans->end_us  = start_us + i2c_sim_wire_us(dev, write_size + read_size, addresses);
+    bus->busy_until_us = trans->end_us;
+    bus->queue_count++;
+    bus->stats.transactions++;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size, int xfer_timeout_ms) {
+    if(i2c_dev == NULL || write_buffer == NULL || write_size == 0) return ESP_ERR_INVALID_ARG;
+    if(i2c_dev->bus->queue != NULL) return i2c_sim_queue(i2c_dev, write_buffer, write_size, NULL, 0, 1);
+    i2c_dev->bus->stats.transactions++;
+    if(i2c_dev->bus->held) return i2c_sim_timeout(i2c_dev->bus, xfer_timeout_ms);
+    i2c_sim_clock_advance_us(i2c_sim_wire_us(i2c_dev, write_size, 1));
+    return i2c_sim_transfer(i2c_dev, write_buffer, write_size, NULL, 0);
+}
+
+esp_err_t i2c_master_receive(i2c_master_dev_handle_t i2c_dev, uint8_t *read_buffer, size_t read_size, int xfer_timeout_ms) {
+    if(i2c_dev == NULL || read_buffer == NULL || read_size == 0) return ESP_ERR_INVALID_ARG;
+    if(i2c_dev->bus->queue != NULL) return i2c_sim_queue(i2c_dev, NULL, 0, read_buffer, read_size, 1);
+    i2c_dev->bus->stats.transactions++;
+    if(i2c_dev->bus->held) return i2c_sim_timeout(i2c_dev->bus, xfer_timeout_ms);
+    i2c_sim_clock_advance_us(i2c_sim_wire_us(i2c_dev, read_size, 1));
+    return i2c_sim_transfer(i2c_dev, NULL, 0, read_buffer, read_size);
+}
+
+esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t i2c_dev, const uint8_t *write_buffer, size_t write_size, uint8_t *read_buffer, size_t read_size, int xfer_timeout_ms) {
+    if(i2c_dev == NULL || write_buffer == NULL || write_size == 0 || read_buffer == NULL || read_size == 0) return ESP_ERR_INVALID_ARG;
+    if(i2c_dev->bus->queue != NULL) return i2c_sim_queue(i2c_dev, write_buffer, write_size, read_buffer, read_size, 2);
+    i2c_dev->bus->stats.transactions++;
+    if(i2c_dev->bus->held) return i2c_sim_timeout(i2c_dev->bus, xfer_timeout_ms);
+    i2c_sim_clock_advance_us(i2c_sim_wire_us(i2c_dev, write_size + read_size, 2));
+    return i2c_sim_transfer(i2c_dev, write_buffer, write_size, read_buffer, read_size);
+}
+
+esp_err_t i2c_sim_attach_device(i2c_master_bus_handle_t bus_handle, i2c_sim_device_t *const device) {
+    if(bus_handle == NULL || device == NULL) return ESP_ERR_INVALID_ARG;
+    if(bus_handle->devices_count >= I2C_SIM_DEVICES_MAX) return ESP_ERR_NO_MEM;
+    bus_handle->devices[bus_handle->devices_count++] = device;
+    return ESP_OK;
+}
+
+void i2c_sim_hold_bus(i2c_master_bus_handle_t bus_handle) {
+    bus_handle->held = true;
+}
+
+void i2c_sim_get_stats(i2c_master_bus_handle_t bus_handle, i2c_sim_stats_t *const stats) {
+    *stats = bus_handle->stats;
+}
+
+void i2c_sim_reset_stats(i2c_master_bus_handle_t bus_handle) {
+    memset(&bus_handle->stats, 0, sizeof(bus_handle->stats));
+}
@@ -0,0 +1,111 @@
+/**
+ * @file i2c_sim.h
+ *
+ * Simulated i2c master bus and host clock for the host build.  Simulated devices 
+ * are attached to a bus by address and receive the bytes of every transaction 
+ * addressed to them.  Every transaction and task delay advances the simulated 
+ * host clock, transactions by the time the bytes take on the wire.
+ */
+#ifndef __I2C_SIM_H__
+#define __I2C_SIM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <esp_err.h>
+#include <driver/i2c_master.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define I2C_SIM_DEVICES_MAX     (8)     /*!< maximum number of simulated devices on a bus */
+
+/**
+ * @brief Simulated i2c device structure.
+ */
+typedef struct i2c_sim_device_tag {
+    uint16_t    address;                                                            /*!< device address */
+    void*       context;                                                            /*!< device model context */
+    esp_err_t (*transmit)(void *context, const uint8_t *data, size_t size);         /*!< device model write transaction handler */
+    esp_err_t (*receive)(void *context, uint8_t *data, size_t size);                /*!< device model read transaction handler */
+    uint32_t    nack_count;                                                         /*!< number of subsequent transactions to not acknowledge, fault injection */
+} i2c_sim_device_t;
+
+/**
+ * @brief Simulated i2c bus statistics structure.
+ */
+typedef struct i2c_sim_stats_tag {
+    uint32_t    transactions;       /*!< number of transactions, a write-read transaction counts once */
+    uint32_t    bytes;              /*!< number of bytes transferred excluding addresses */
+    uint32_t    nacks;              /*!< number of transactions not acknowledged */
+    uint32_t    timeouts;           /*!< number of transactions timed out on a held bus */
+    uint32_t    resets;             /*!< number of bus resets */
+} i2c_sim_stats_t;
+
+/**
+ * @brief Gets the simulated host clock.
+ * 
+ * @return int64_t Simulated time in micro-seconds.
+ */
+int64_t i2c_sim_clock_get_us(void);
+
+/**
+ * @brief Advances the simulated host clock.
+ * 
+ * @param us Micro-seconds to advance.
+ */
+void i2c_sim_clock_advance_us(const int64_t us);
+
+/**
+ * @brief Gets the time busy-waited with `esp_rom_delay_us`, the task holds the cpu while busy-waiting.
+ * 
+ * @return int64_t Total busy-wait time in micro-seconds.
+ */
+int64_t i2c_sim_clock_get_busy_wait_us(void);
+
+/**
+ * @brief Sets the system clock, `gettimeofday` returns the simulated host clock from this 
+ * unix epoch timestamp on.  Setting the clock again steps it as an sntp synchronization does.
+ * 
+ * @param epoch_us Unix epoch timestamp (UTC) of the system clock now in micro-seconds.
+ */
+void i2c_sim_clock_set_epoch_us(const int64_t epoch_us);
+
+/**
+ * @brief Attaches a simulated device to a bus.
+ * 
+ * @param bus_handle Bus handle from `i2c_new_master_bus`.
+ * @param device Simulated device, owned by the caller.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t i2c_sim_attach_device(i2c_master_bus_handle_t bus_handle, i2c_sim_device_t *const device);
+
+/**
+ * @brief Holds the bus, a device keeps SDA low, fault injection.  Transactions and probes 
+ * time out until the bus is reset with `i2c_master_bus_reset`.
+ * 
+ * @param bus_handle Bus handle.
+ */
+void i2c_sim_hold_bus(i2c_master_bus_handle_t bus_handle);
+
+/**
+ * @brief Gets the bus statistics.
+ * 
+ * @param bus_handle Bus handle.
+ * @param stats Bus statistics.
+ */
+void i2c_sim_get_stats(i2c_master_bus_handle_t bus_handle, i2c_sim_stats_t *const stats);
+
+/**
+ * @brief Resets the bus statistics.
+ * 
+ * @param bus_handle Bus handle.
+ */
+void i2c_sim_reset_stats(i2c_master_bus_handle_t bus_handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __I2C_SIM_H__
@@ -0,0 +1,126 @@
+/**
+ * @file nvs_sim.c
+ *
+ * Simulated non-volatile storage for the host build, see nvs_sim.h.
+ */
+#include <string.h>
+
+#include "nvs_sim.h"
+
+#define NVS_SIM_HANDLES_MAX     (8)
+
+typedef struct nvs_sim_entry_tag {
+    char        namespace_name[NVS_KEY_NAME_MAX_SIZE];
+    char        key[NVS_KEY_NAME_MAX_SIZE];
+    uint8_t     value[NVS_SIM_BLOB_SIZE_MAX];
+    size_t      length;
+} nvs_sim_entry_t;
+
+typedef struct nvs_sim_handle_tag {
+    char            namespace_name[NVS_KEY_NAME_MAX_SIZE];
+    nvs_open_mode_t open_mode;
+    bool            open;
+} nvs_sim_handle_t;
+
+static nvs_sim_entry_t  s_entries[NVS_SIM_ENTRIES_MAX];
+static size_t           s_entries_count;
+static nvs_sim_handle_t s_handles[NVS_SIM_HANDLES_MAX];
+static nvs_sim_stats_t  s_stats;
+
+static nvs_sim_handle_t *nvs_sim_get_handle(const nvs_handle_t handle) {
+    if(handle == 0 || handle > NVS_SIM_HANDLES_MAX || !s_handles[handle - 1].open) return NULL;
+    return &s_handles[handle - 1];
+}
+
+static nvs_sim_entry_t *nvs_sim_find(const char *namespace_name, const char *key) {
+    for(size_t i = 0; i < s_entries_count; i++) {
+        if(strcmp(s_entries[i].namespace_name, namespace_name) == 0 && strcmp(s_entries[i].key, key) == 0) return &s_entries[i];
+    }
+    return NULL;
+}
+
+esp_err_t nvs_open(const char *namespace_name, nvs_open_mode_t open_mode, nvs_handle_t *out_handle) {
+    if(namespace_name == NULL || out_handle == NULL || strlen(namespace_name) >= NVS_KEY_NAME_MAX_SIZE) return ESP_ERR_INVALID_ARG;
+
+    /* a read-only namespace that was never written isn't found, as with nvs flash */
+    if(open_mode == NVS_READONLY) {
+        bool found = false;
+        for(size_t i = 0; i < s_entries_count && !found; i++) found = strcmp(s_entries[i].namespace_name, namespace_name) == 0;
+        if(!found) return ESP_ERR_NVS_NOT_FOUND;
+    }
+
+    for(size_t i = 0; i < NVS_SIM_HANDLES_MAX; i++) {
+        if(!s_handles[i].open) {
+            strcpy(s_handles[i].namespace_name, namespace_name);
+            s_handles[i].open_mode = open_mode;
+            s_handles[i].open      = true;
+            *out_handle = (nvs_handle_t)(i + 1);
+            return ESP_OK;
+        }
+    }
+
+    return ESP_ERR_NO_MEM;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length) {
+    nvs_sim_handle_t *hdl = nvs_sim_get_handle(handle);
+    if(hdl == NULL) return ESP_ERR_INVALID_ARG;
+    if(key == NULL || length == NULL) return ESP_ERR_INVALID_ARG;
+
+    nvs_sim_entry_t *entry = nvs_sim_find(hdl->namespace_name, key);
+    if(entry == NULL) return ESP_ERR_NVS_NOT_FOUND;
+
+    /* the length of the blob is returned when no output buffer is given */
+    if(out_value == NULL) {
+        *length = entry->length;
+        return ESP_OK;
+    }
+    if(*length < entry->length) return ESP_ERR_NVS_INVALID_LENGTH;
+
+    memcpy(out_value, entry->value, entry->length);
+    *length = entry->length;
+    s_stats.reads++;
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length) {
+    nvs_sim_handle_t *hdl = nvs_sim_get_handle(handle);
+    if(hdl == NULL) return ESP_ERR_INVALID_ARG;
+    if(key == NULL || value == NULL || strlen(key) >= NVS_KEY_NAME_MAX_SIZE) return ESP_ERR_INVALID_ARG;
+    if(hdl->open_mode == NVS_READONLY) return ESP_ERR_NVS_READ_ONLY;
+    if(length > NVS_SIM_BLOB_SIZE_MAX) return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+
+    nvs_sim_entry_t *entry = nvs_sim_find(hdl->namespace_name, key);
+    if(entry == NULL) {
+        if(s_entries_count == NVS_SIM_ENTRIES_MAX) return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+        entry = &s_entries[s_entries_count++];
+        strcpy(entry->namespace_name, hdl->namespace_name);
+        strcpy(entry->key, key);
+    }
+
+    memcpy(entry->value, value, length);
+    entry->length = length;
+    s_stats.writes++;
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+    return nvs_sim_get_handle(handle) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+void nvs_close(nvs_handle_t handle) {
+    nvs_sim_handle_t *hdl = nvs_sim_get_handle(handle);
+    if(hdl) hdl->open = false;
+}
+
+void nvs_sim_erase_all(void) {
+    memset(s_entries, 0, sizeof(s_entries));
+    s_entries_count = 0;
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+void nvs_sim_get_stats(nvs_sim_stats_t *const stats) {
+    *stats = s_stats;
+}
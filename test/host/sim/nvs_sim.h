@@ -0,0 +1,46 @@
+/**
+ * @file nvs_sim.h
+ *
+ * Simulated non-volatile storage for the host build.  Blobs are kept in memory 
+ * per namespace and key, and survive driver handle deletion like flash survives 
+ * a warm boot.
+ */
+#ifndef __NVS_SIM_H__
+#define __NVS_SIM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <nvs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NVS_SIM_ENTRIES_MAX     (16)    /*!< maximum number of stored blobs */
+#define NVS_SIM_BLOB_SIZE_MAX   (64)    /*!< maximum size of a stored blob */
+
+/**
+ * @brief Simulated non-volatile storage statistics structure.
+ */
+typedef struct nvs_sim_stats_tag {
+    uint32_t    reads;      /*!< number of blob reads found */
+    uint32_t    writes;     /*!< number of blob writes */
+} nvs_sim_stats_t;
+
+/**
+ * @brief Erases all blobs and resets the statistics, like an erased flash partition.
+ */
+void nvs_sim_erase_all(void);
+
+/**
+ * @brief Gets the simulated non-volatile storage statistics.
+ * 
+ * @param stats Statistics since the last erase.
+ */
+void nvs_sim_get_stats(nvs_sim_stats_t *const stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NVS_SIM_H__
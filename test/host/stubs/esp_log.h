@@ -0,0 +1,15 @@
+/**
+ * @file esp_log.h
+ *
+ * Host stub of the esp-idf logging macros, errors and warnings are printed to stderr.
+ */
+#pragma once
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#define ESP_LOGE(tag, fmt, ...) fprintf(stderr, "E (%s): " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) fprintf(stderr, "W (%s): " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) do { (void)(tag); } while (0)
+#define ESP_LOGD(tag, fmt, ...) do { (void)(tag); } while (0)
+#define ESP_LOGV(tag, fmt, ...) do { (void)(tag); } while (0)
@@ -0,0 +1,15 @@
+/**
+ * @file esp_rom_sys.h
+ *
+ * Host stub of the esp-idf rom system functions, busy-waits advance the simulated host clock.
+ */
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Busy-waits, advances the simulated host clock.
+ * 
+ * @param us Micro-seconds to wait.
+ */
+void esp_rom_delay_us(uint32_t us);
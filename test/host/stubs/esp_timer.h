@@ -0,0 +1,70 @@
+/**
+ * @file esp_timer.h
+ *
+ * Host stub of the esp-idf high resolution timer, time is the simulated host clock.  One-shot 
+ * timer callbacks run when the simulated host clock reaches their alarm.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <esp_err.h>
+
+typedef struct esp_timer* esp_timer_handle_t;
+
+typedef void (*esp_timer_cb_t)(void* arg);
+
+typedef enum {
+    ESP_TIMER_TASK,
+    ESP_TIMER_ISR,
+    ESP_TIMER_MAX
+} esp_timer_dispatch_t;
+
+typedef struct {
+    esp_timer_cb_t          callback;
+    void*                   arg;
+    esp_timer_dispatch_t    dispatch_method;
+    const char*             name;
+    bool                    skip_unhandled_events;
+} esp_timer_create_args_t;
+
+/**
+ * @brief Gets the simulated time since start-up in micro-seconds.
+ * 
+ * @return int64_t Simulated time in micro-seconds.
+ */
+int64_t esp_timer_get_time(void);
+
+/**
+ * @brief Creates a stopped timer.
+ * 
+ * @param create_args Timer configuration.
+ * @param out_handle Timer handle.
+ * @return esp_err_t ESP_OK on success.
+ */
+esp_err_t esp_timer_create(const esp_timer_create_args_t* create_args, esp_timer_handle_t* out_handle);
+
+/**
+ * @brief Starts a one-shot timer, the callback runs once the simulated host clock advanced by the timeout.
+ * 
+ * @param timer Timer handle.
+ * @param timeout_us Timeout in micro-seconds.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when the timer is running.
+ */
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us);
+
+/**
+ * @brief Stops a timer.
+ * 
+ * @param timer Timer handle.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when the timer is not running.
+ */
+esp_err_t esp_timer_stop(esp_timer_handle_t timer);
+
+/**
+ * @brief Deletes a stopped timer.
+ * 
+ * @param timer Timer handle.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE when the timer is running.
+ */
+esp_err_t esp_timer_delete(esp_timer_handle_t timer);
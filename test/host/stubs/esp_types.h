@@ -0,0 +1,10 @@
+/**
+ * @file esp_types.h
+ *
+ * Host stub of the esp-idf common types.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
@@ -0,0 +1,36 @@
+/**
+ * @file FreeRTOS.h
+ *
+ * Host stub of the FreeRTOS kernel definitions, a 100 Hz tick on the simulated host clock as the 
+ * target's CONFIG_FREERTOS_HZ.  The host build is single threaded, critical sections are no-ops.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef uint32_t    TickType_t;
+typedef int32_t     BaseType_t;
+typedef uint32_t    UBaseType_t;
+
+#define pdFALSE                 ((BaseType_t)0)
+#define pdTRUE                  ((BaseType_t)1)
+#define pdPASS                  (pdTRUE)
+#define pdFAIL                  (pdFALSE)
+#define portMAX_DELAY           ((TickType_t)0xffffffffUL)
+#define configTICK_RATE_HZ      (100)
+#define portTICK_PERIOD_MS      ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000U))
+
+typedef struct {
+    uint32_t owner;
+    uint32_t count;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED    { .owner = 0, .count = 0 }
+#define portMUX_INITIALIZE(mux)         do { (mux)->owner = 0; (mux)->count = 0; } while (0)
+#define taskENTER_CRITICAL(mux)         do { (void)(mux); } while (0)
+#define taskEXIT_CRITICAL(mux)          do { (void)(mux); } while (0)
+#define taskENTER_CRITICAL_ISR(mux)     do { (void)(mux); } while (0)
+#define taskEXIT_CRITICAL_ISR(mux)      do { (void)(mux); } while (0)
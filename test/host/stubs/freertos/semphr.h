@@ -0,0 +1,15 @@
+/**
+ * @file semphr.h
+ *
+ * Host stub of the FreeRTOS semaphore API, the host build is single threaded.
+ */
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void* SemaphoreHandle_t;
+
+static inline SemaphoreHandle_t xSemaphoreCreateMutex(void) { return (SemaphoreHandle_t)1; }
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t handle, TickType_t ticks) { (void)handle; (void)ticks; return pdTRUE; }
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t handle) { (void)handle; return pdTRUE; }
+static inline void vSemaphoreDelete(SemaphoreHandle_t handle) { (void)handle; }
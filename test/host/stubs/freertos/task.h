@@ -0,0 +1,61 @@
+/**
+ * @file task.h
+ *
+ * Host stub of the FreeRTOS task API.  Delays advance the simulated host clock 
+ * instead of blocking.  The host build runs a single task, notifications are 
+ * given to and taken by that task.
+ */
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void* TaskHandle_t;
+
+/**
+ * @brief Advances the simulated host clock to the n-th tick boundary from the current partial
+ * tick, the delay ends early by the elapsed part of the current tick as on the target.
+ * 
+ * @param ticks Number of ticks to delay.
+ */
+void vTaskDelay(const TickType_t ticks);
+
+/**
+ * @brief Gets the simulated host clock in ticks.
+ * 
+ * @return TickType_t Simulated tick count.
+ */
+TickType_t xTaskGetTickCount(void);
+
+/**
+ * @brief Gets the handle of the running task, the single host task.
+ * 
+ * @return TaskHandle_t Task handle.
+ */
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+/**
+ * @brief Gives a notification to a task.
+ * 
+ * @param task Task to notify.
+ * @return BaseType_t pdPASS.
+ */
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+
+/**
+ * @brief Gives a notification to a task from an interrupt.
+ * 
+ * @param task Task to notify.
+ * @param higher_priority_task_woken Set to pdTRUE when a context switch is due, pdFALSE on the host.
+ */
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_task_woken);
+
+/**
+ * @brief Takes the notifications of the running task.  The simulated host clock is advanced, 
+ * completing pending asynchronous i2c transactions, until a notification is given or the 
+ * ticks elapse.  Timer callbacks run when the clock reaches their alarm.
+ * 
+ * @param clear_on_exit pdTRUE to clear the notification count, pdFALSE to decrement it.
+ * @param ticks Number of ticks to wait.
+ * @return uint32_t Notification count before it was cleared or decremented, 0 on timeout.
+ */
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks);
@@ -0,0 +1,6 @@
+/**
+ * @file sdkconfig.h
+ *
+ * Host stub of the esp-idf project configuration, no options are set.
+ */
+#pragma once
@@ -0,0 +1,37 @@
+/**
+ * @file host_test.h
+ *
+ * Minimal assertion macros for the host tests.  A failed assertion prints the 
+ * location and counts as a failure, the test program exits with the number of 
+ * failures.
+ */
+#ifndef __HOST_TEST_H__
+#define __HOST_TEST_H__
+
+#include <stdio.h>
+#include <math.h>
+
+static int s_host_test_failures = 0;
+
+#define TEST_ASSERT(cond) do { \
+        if (!(cond)) { fprintf(stderr, "%s:%d: assertion failed: %s\n", __FILE__, __LINE__, #cond); s_host_test_failures++; } \
+    } while (0)
+
+#define TEST_ASSERT_EQUAL_INT(expected, actual) do { \
+        long long e_ = (long long)(expected), a_ = (long long)(actual); \
+        if (e_ != a_) { fprintf(stderr, "%s:%d: expected %lld, got %lld: %s\n", __FILE__, __LINE__, e_, a_, #actual); s_host_test_failures++; } \
+    } while (0)
+
+#define TEST_ASSERT_NEAR(expected, actual, tolerance) do { \
+        double e_ = (double)(expected), a_ = (double)(actual); \
+        if (!(fabs(e_ - a_) <= (tolerance))) { fprintf(stderr, "%s:%d: expected %f, got %f: %s\n", __FILE__, __LINE__, e_, a_, #actual); s_host_test_failures++; } \
+    } while (0)
+
+#define RUN_TEST(fn) do { \
+        int failures_ = s_host_test_failures; fn(); \
+        printf("%s: %s\n", #fn, failures_ == s_host_test_failures ? "PASS" : "FAIL"); \
+    } while (0)
+
+#define TEST_EXIT() (s_host_test_failures == 0 ? 0 : 1)
+
+#endif // __HOST_TEST_H__
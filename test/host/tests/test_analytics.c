@@ -0,0 +1,141 @@
+/**
+ * @file test_analytics.c
+ *
+ * Host tests of the scalar trend, pressure tendency and MACHBASE row components.
+ */
+#include <string.h>
+#include <math.h>
+
+#include <scalar_trend.h>
+#include <pressure_tendency.h>
+#include <machbase_row.h>
+
+#include "host_test.h"
+
+static void test_scalar_trend(void) {
+    scalar_trend_handle_t hdl = NULL;
+    scalar_trend_codes_t  code;
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, scalar_trend_init(60, &hdl));
+
+    /* unknown until the samples buffer is full */
+    for(int i = 0; i < 59; i++) {
+        TEST_ASSERT_EQUAL_INT(ESP_OK, scalar_trend_analysis(hdl, 1000.0f + 0.05f * i, &code));
+        TEST_ASSERT_EQUAL_INT(SCALAR_TREND_CODE_UNKNOWN, code);
+    }
+    TEST_ASSERT_EQUAL_INT(ESP_OK, scalar_trend_analysis(hdl, 1000.0f + 0.05f * 59, &code));
+    TEST_ASSERT_EQUAL_INT(SCALAR_TREND_CODE_RISING, code);
+
+    for(int i = 0; i < 60; i++) scalar_trend_analysis(hdl, 1000.0f - 0.05f * i, &code);
+    TEST_ASSERT_EQUAL_INT(SCALAR_TREND_CODE_FALLING, code);
+
+    for(int i = 0; i < 60; i++) scalar_trend_analysis(hdl, 1000.0f, &code);
+    TEST_ASSERT_EQUAL_INT(SCALAR_TREND_CODE_STEADY, code);
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, scalar_trend_reset(hdl));
+    scalar_trend_analysis(hdl, 1000.0f, &code);
+    TEST_ASSERT_EQUAL_INT(SCALAR_TREND_CODE_UNKNOWN, code);
+
+    scalar_trend_del(hdl);
+}
+
+static void test_scalar_trend_compatible(void) {
+    scalar_trend_handle_t incremental_hdl = NULL;
+    scalar_trend_handle_t compatible_hdl  = NULL;
+    scalar_trend_codes_t  incremental_code;
+    scalar_trend_codes_t  compatible_code;
+    uint32_t              codes[SCALAR_TREND_CODE_FALLING + 1] = { 0 };
+    uint32_t              mismatches = 0;
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, scalar_trend_init(20, &incremental_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, scalar_trend_init(20, &compatible_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, scalar_trend_set_mode(compatible_hdl, SCALAR_TREND_MODE_COMPATIBLE));
+
+    /* rising, noisy steady, falling and constant segments over several buffer revolutions, with NaN samples */
+    for(int i = 0; i < 600; i++) {
+        const int segment = (i / 50) % 4;
+        float     sample;
+
+        switch(segment) {
+            case 0:  sample = 1000.0f + 0.02f * (float)(i % 50); break;
+            case 1:  sample = 1001.0f + 0.05f * (float)((i * 7919) % 11) - 0.25f; break;
+            case 2:  sample = 1001.0f - 0.03f * (float)(i % 50) + 0.01f * (float)((i * 31) % 5); break;
+            default: sample = 999.5f; break;
+        }
+        if(i % 97 == 13) sample = NAN;
+
+        TEST_ASSERT_EQUAL_INT(ESP_OK, scalar_trend_analysis(incremental_hdl, sample, &incremental_code));
+        TEST_ASSERT_EQUAL_INT(ESP_OK, scalar_trend_analysis(compatible_hdl, sample, &compatible_code));
+        if(incremental_code != compatible_code) mismatches++;
+        codes[incremental_code]++;
+    }
+    TEST_ASSERT_EQUAL_INT(0, mismatches);
+
+    /* every trend code is covered */
+    TEST_ASSERT(codes[SCALAR_TREND_CODE_STEADY] > 0);
+    TEST_ASSERT(codes[SCALAR_TREND_CODE_RISING] > 0);
+    TEST_ASSERT(codes[SCALAR_TREND_CODE_FALLING] > 0);
+
+    /* a NaN sample in the buffer is a steady trend, until it leaves the buffer */
+    for(int i = 0; i < 20; i++) scalar_trend_analysis(incremental_hdl, 1000.0f + 0.05f * i, &incremental_code);
+    TEST_ASSERT_EQUAL_INT(SCALAR_TREND_CODE_RISING, incremental_code);
+    scalar_trend_analysis(incremental_hdl, NAN, &incremental_code);
+    TEST_ASSERT_EQUAL_INT(SCALAR_TREND_CODE_STEADY, incremental_code);
+    for(int i = 0; i < 19; i++) scalar_trend_analysis(incremental_hdl, 1001.0f + 0.05f * i, &incremental_code);
+    TEST_ASSERT_EQUAL_INT(SCALAR_TREND_CODE_STEADY, incremental_code);
+    scalar_trend_analysis(incremental_hdl, 1001.0f + 0.05f * 19, &incremental_code);
+    TEST_ASSERT_EQUAL_INT(SCALAR_TREND_CODE_RISING, incremental_code);
+
+    scalar_trend_del(incremental_hdl);
+    scalar_trend_del(compatible_hdl);
+}
+
+static void test_pressure_tendency(void) {
+    const pressure_tendency_config_t cfg = { .sampling_period = 6, .history_period = PRESSURE_TENDENCY_PERIOD_MIN };
+    pressure_tendency_handle_t hdl = NULL;
+    pressure_tendency_codes_t  code;
+    float change;
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, pressure_tendency_init(&cfg, &hdl));
+
+    /* 2.5 hPa rise over 3-hrs, 1,800 samples at 6-seconds */
+    for(int i = 0; i <= 1800; i++) {
+        TEST_ASSERT_EQUAL_INT(ESP_OK, pressure_tendency_analysis(hdl, 1000.0f + 2.5f * i / 1800.0f, &code, &change));
+        if(i < 1800) TEST_ASSERT_EQUAL_INT(PRESSURE_TENDENCY_CODE_UNKNOWN, code);
+    }
+    TEST_ASSERT_NEAR(2.5, change, 0.01);
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, pressure_tendency_get_change(hdl, 60, &change));
+    TEST_ASSERT_NEAR(2.5 / 3, change, 0.01);
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_ARG, pressure_tendency_get_change(hdl, PRESSURE_TENDENCY_PERIOD_MIN + 1, &change));
+
+    pressure_tendency_del(hdl);
+}
+
+static void test_machbase_row(void) {
+    machbase_row_template_t row_template;
+    char row[128];
+    size_t len;
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, machbase_row_template_init("CA.NB.AWS.01-1000", "Air-Temperature", &row_template));
+
+    len = machbase_row_serialize(&row_template, 1729957661187888000ULL, 21.25f, row, sizeof(row));
+    TEST_ASSERT(len > 0);
+    row[len] = '\0';
+    TEST_ASSERT(strcmp(row, "[\"CA.NB.AWS.01-1000.Air-Temperature\",1729957661187888000,21.250000,\"Air-Temperature\",\"CA.NB.AWS.01-1000\"]") == 0);
+
+    len = machbase_row_serialize(&row_template, 0, NAN, row, sizeof(row));
+    row[len] = '\0';
+    TEST_ASSERT(strcmp(row, "[\"CA.NB.AWS.01-1000.Air-Temperature\",0,null,\"Air-Temperature\",\"CA.NB.AWS.01-1000\"]") == 0);
+
+    /* rows are not truncated */
+    TEST_ASSERT_EQUAL_INT(0, machbase_row_serialize(&row_template, 0, 1.0f, row, 32));
+}
+
+int main(void) {
+    RUN_TEST(test_scalar_trend);
+    RUN_TEST(test_scalar_trend_compatible);
+    RUN_TEST(test_pressure_tendency);
+    RUN_TEST(test_machbase_row);
+    return TEST_EXIT();
+}
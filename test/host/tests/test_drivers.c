@@ -0,0 +1,1053 @@
+/**
+ * @file test_drivers.c
+ *
+ * Host tests of the BMP280 and AHTXX drivers against simulated devices on a 
+ * simulated i2c master bus.
+ */
+#include <string.h>
+#include <math.h>
+
+#include <bmp280.h>
+#include <ahtxx.h>
+#include <i2c_bus_scheduler.h>
+
+#include "i2c_sim.h"
+#include "bmp280_sim.h"
+#include "ahtxx_sim.h"
+#include "nvs_sim.h"
+#include "host_test.h"
+
+static i2c_master_bus_handle_t new_bus(void) {
+    const i2c_master_bus_config_t bus_cfg = { .i2c_port = I2C_NUM_0 };
+    i2c_master_bus_handle_t bus_hdl = NULL;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_new_master_bus(&bus_cfg, &bus_hdl));
+    return bus_hdl;
+}
+
+static void test_bmp280_pressure(void) {
+    const i2c_bmp280_config_t dev_cfg = I2C_BMP280_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_bmp280_handle_t dev_hdl = NULL;
+    bmp280_sim_t sim;
+    float temperature, pressure;
+
+    bmp280_sim_init(&sim, I2C_BMP280_DEV_ADDR_HI, BMP280_SIM_CHIP_ID_BMP280);
+    i2c_sim_attach_device(bus_hdl, &sim.device);
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_init(bus_hdl, &dev_cfg, &dev_hdl));
+    TEST_ASSERT(dev_hdl != NULL);
+
+    /* datasheet example calibration */
+    TEST_ASSERT_EQUAL_INT(27504, dev_hdl->dev_cal_factors->dig_T1);
+    TEST_ASSERT_EQUAL_INT(-10685, dev_hdl->dev_cal_factors->dig_P2);
+    TEST_ASSERT_EQUAL_INT(6000, dev_hdl->dev_cal_factors->dig_P9);
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_measurements(dev_hdl, &temperature, &pressure));
+    TEST_ASSERT_NEAR(25.08, temperature, 0.01);
+    TEST_ASSERT_NEAR(100653.27, pressure, 1.0);
+
+    bmp280_sim_set_environment(&sim, -10.0, 98000.0);
+    i2c_sim_clock_advance_us(1000000);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_pressure(dev_hdl, &pressure));
+    TEST_ASSERT_NEAR(98000.0, pressure, 1.0);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_temperature(dev_hdl, &temperature));
+    TEST_ASSERT_NEAR(-10.0, temperature, 0.01);
+
+    i2c_bmp280_rm(dev_hdl);
+    i2c_del_master_bus(bus_hdl);
+}
+
+static void test_bmp280_cal_factors_cache(void) {
+    const i2c_bmp280_config_t dev_cfg = I2C_BMP280_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_bmp280_handle_t dev_hdl = NULL;
+    bmp280_sim_t sim;
+    i2c_sim_stats_t cold_stats, warm_stats;
+    nvs_sim_stats_t nvs_stats;
+    i2c_bmp280_cal_factors_t cal_factors;
+
+    bmp280_sim_init(&sim, I2C_BMP280_DEV_ADDR_HI, BMP280_SIM_CHIP_ID_BMP280);
+    i2c_sim_attach_device(bus_hdl, &sim.device);
+    nvs_sim_erase_all();
+
+    /* cold boot, the calibration block is read from the device and cached */
+    i2c_sim_reset_stats(bus_hdl);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_init(bus_hdl, &dev_cfg, &dev_hdl));
+    i2c_sim_get_stats(bus_hdl, &cold_stats);
+    nvs_sim_get_stats(&nvs_stats);
+    TEST_ASSERT_EQUAL_INT(0, nvs_stats.reads);
+    TEST_ASSERT_EQUAL_INT(1, nvs_stats.writes);
+    cal_factors = *dev_hdl->dev_cal_factors;
+    i2c_bmp280_rm(dev_hdl);
+
+    /* warm boot, the calibration block is read from the cache */
+    i2c_sim_reset_stats(bus_hdl);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_init(bus_hdl, &dev_cfg, &dev_hdl));
+    i2c_sim_get_stats(bus_hdl, &warm_stats);
+    nvs_sim_get_stats(&nvs_stats);
+    TEST_ASSERT_EQUAL_INT(1, nvs_stats.reads);
+    TEST_ASSERT_EQUAL_INT(1, nvs_stats.writes);
+    TEST_ASSERT(memcmp(&cal_factors, dev_hdl->dev_cal_factors, sizeof(cal_factors)) == 0);
+    TEST_ASSERT_EQUAL_INT(cold_stats.transactions - 1, warm_stats.transactions);
+    TEST_ASSERT_EQUAL_INT(cold_stats.bytes - 1 - 24, warm_stats.bytes);
+    i2c_bmp280_rm(dev_hdl);
+
+    i2c_del_master_bus(bus_hdl);
+}
+
+static void test_bmp280_streaming(void) {
+    i2c_bmp280_config_t dev_cfg = I2C_BMP280_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_bmp280_handle_t dev_hdl = NULL;
+    bmp280_sim_t sim;
+    i2c_sim_stats_t stats;
+    float temperature, pressure;
+    uint32_t age_us;
+
+    /* 62.5 ms standby, 11.5 ms typical measurement at 4x pressure and 1x temperature oversampling */
+    dev_cfg.standby_time = I2C_BMP280_STANDBY_TIME_62_5MS;
+    bmp280_sim_init(&sim, I2C_BMP280_DEV_ADDR_HI, BMP280_SIM_CHIP_ID_BMP280);
+    i2c_sim_attach_device(bus_hdl, &sim.device);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_init(bus_hdl, &dev_cfg, &dev_hdl));
+
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, i2c_bmp280_get_next_measurements(dev_hdl, &temperature, &pressure, NULL, &age_us));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_start_streaming(dev_hdl));
+    TEST_ASSERT_EQUAL_INT(74000, dev_hdl->stream_period_us);
+
+    /* every aligned read returns a new measurement shortly after it completes, without status polls */
+    i2c_sim_reset_stats(bus_hdl);
+    const int64_t start_us = i2c_sim_clock_get_us();
+    for(uint32_t i = 1; i <= 100; i++) {
+        bmp280_sim_set_environment(&sim, 20.0, 100000.0 + i);
+        TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_next_measurements(dev_hdl, &temperature, &pressure, NULL, &age_us));
+        TEST_ASSERT_EQUAL_INT(i, sim.conversions);
+        TEST_ASSERT_NEAR(100000.0 + i, pressure, 1.0);
+        /* maximum to typical measurement time margin, tick rounding and transfer time */
+        TEST_ASSERT(age_us < 4000);
+    }
+    i2c_sim_get_stats(bus_hdl, &stats);
+    TEST_ASSERT_EQUAL_INT(100, stats.transactions);
+    TEST_ASSERT_NEAR(100 * 74000, (double)(i2c_sim_clock_get_us() - start_us), 74000);
+
+    /* a read between aligned reads returns the latest measurement and its age */
+    i2c_sim_clock_advance_us(30000);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_latest_measurements(dev_hdl, &temperature, &pressure, NULL, &age_us));
+    TEST_ASSERT_NEAR(100100.0, pressure, 1.0);
+    TEST_ASSERT(age_us >= 30000 && age_us < 35000);
+
+    /* the streaming schedule follows the configuration, not changed while streaming */
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, i2c_bmp280_set_standby_time(dev_hdl, I2C_BMP280_STANDBY_TIME_125MS));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, i2c_bmp280_set_pressure_oversampling(dev_hdl, I2C_BMP280_PRESSURE_OVERSAMPLING_16X));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, i2c_bmp280_set_temperature_oversampling(dev_hdl, I2C_BMP280_TEMPERATURE_OVERSAMPLING_2X));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, i2c_bmp280_set_iir_filter(dev_hdl, I2C_BMP280_IIR_FILTER_16));
+    TEST_ASSERT_EQUAL_INT(74000, dev_hdl->stream_period_us);
+
+    /* streaming is ended with stop streaming, not by leaving normal mode */
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, i2c_bmp280_set_power_mode(dev_hdl, I2C_BMP280_POWER_MODE_SLEEP));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, i2c_bmp280_set_power_mode(dev_hdl, I2C_BMP280_POWER_MODE_FORCED));
+    TEST_ASSERT_EQUAL_INT(I2C_BMP280_POWER_MODE_NORMAL, dev_hdl->ctrl_meas_reg.bits.power_mode);
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_stop_streaming(dev_hdl));
+    TEST_ASSERT_EQUAL_INT(I2C_BMP280_POWER_MODE_SLEEP, dev_hdl->ctrl_meas_reg.bits.power_mode);
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, i2c_bmp280_get_latest_measurements(dev_hdl, &temperature, &pressure, NULL, &age_us));
+
+    i2c_bmp280_rm(dev_hdl);
+    i2c_del_master_bus(bus_hdl);
+}
+
+static void test_bmp280_forced(void) {
+    i2c_bmp280_config_t dev_cfg = I2C_BMP280_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_bmp280_handle_t dev_hdl = NULL;
+    bmp280_sim_t sim;
+    i2c_sim_stats_t stats;
+    float temperature, pressure;
+
+    dev_cfg.power_mode = I2C_BMP280_POWER_MODE_FORCED;
+    bmp280_sim_init(&sim, I2C_BMP280_DEV_ADDR_HI, BMP280_SIM_CHIP_ID_BMP280);
+    i2c_sim_attach_device(bus_hdl, &sim.device);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_init(bus_hdl, &dev_cfg, &dev_hdl));
+    TEST_ASSERT_EQUAL_INT(0, sim.conversions);
+
+    /* one trigger and one burst read, delayed by the 13.325 ms maximum measurement time */
+    bmp280_sim_set_environment(&sim, 12.5, 101325.0);
+    i2c_sim_reset_stats(bus_hdl);
+    const int64_t start_us = i2c_sim_clock_get_us();
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_forced_measurements(dev_hdl, &temperature, &pressure));
+    i2c_sim_get_stats(bus_hdl, &stats);
+    TEST_ASSERT_EQUAL_INT(2, stats.transactions);
+    TEST_ASSERT_EQUAL_INT(1, sim.conversions);
+    TEST_ASSERT_NEAR(12.5, temperature, 0.01);
+    TEST_ASSERT_NEAR(101325.0, pressure, 1.0);
+    TEST_ASSERT(i2c_sim_clock_get_us() - start_us >= 13325);
+    TEST_ASSERT(i2c_sim_clock_get_us() - start_us < 16000);
+
+    /* back in sleep mode, no conversions between forced measurements */
+    i2c_sim_clock_advance_us(1000000);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_forced_measurements(dev_hdl, &temperature, &pressure));
+    TEST_ASSERT_EQUAL_INT(2, sim.conversions);
+
+    /* not while streaming */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_start_streaming(dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, i2c_bmp280_get_forced_measurements(dev_hdl, &temperature, &pressure));
+
+    i2c_bmp280_rm(dev_hdl);
+    i2c_del_master_bus(bus_hdl);
+}
+
+static void test_bmp280_compensation(void) {
+    static const i2c_bmp280_compensations_t compensations[] = { I2C_BMP280_COMPENSATION_INT64, I2C_BMP280_COMPENSATION_INT32, I2C_BMP280_COMPENSATION_FLOAT };
+    /* 
+        deviation from the datasheet floating-point reference, the 32-bit integer pressure 
+        compensation truncates intermediates and deviates by up to 4 Pa, 100656 Pa at the 
+        datasheet example of 100653.27 Pa 
+    */
+    static const double pressure_tolerances[] = { 0.5, 5.0, 0.5 };
+    i2c_bmp280_config_t dev_cfg = I2C_BMP280_CONFIG_DEFAULT;
+    float temperature, pressure;
+
+    dev_cfg.power_mode = I2C_BMP280_POWER_MODE_FORCED;
+    for(size_t c = 0; c < sizeof(compensations) / sizeof(compensations[0]); c++) {
+        i2c_master_bus_handle_t bus_hdl = new_bus();
+        i2c_bmp280_handle_t dev_hdl = NULL;
+        bmp280_sim_t sim;
+
+        dev_cfg.compensation = compensations[c];
+        bmp280_sim_init(&sim, I2C_BMP280_DEV_ADDR_HI, BMP280_SIM_CHIP_ID_BMP280);
+        i2c_sim_attach_device(bus_hdl, &sim.device);
+        TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_init(bus_hdl, &dev_cfg, &dev_hdl));
+
+        /* operating range of -40 to 85 degrees celsius and 300 to 1100 hPa */
+        for(double t = -40.0; t <= 85.0; t += 12.5) {
+            for(double p = 30000.0; p <= 110000.0; p += 10000.0) {
+                bmp280_sim_set_environment(&sim, t, p);
+                TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_forced_measurements(dev_hdl, &temperature, &pressure));
+                TEST_ASSERT_NEAR(t, temperature, 0.01);
+                TEST_ASSERT_NEAR(p, pressure, pressure_tolerances[c]);
+            }
+        }
+
+        /* temperature only and pressure getters share the back-end */
+        bmp280_sim_set_environment(&sim, 21.3, 99000.0);
+        TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_set_power_mode(dev_hdl, I2C_BMP280_POWER_MODE_NORMAL));
+        i2c_sim_clock_advance_us(1000000);
+        TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_temperature(dev_hdl, &temperature));
+        TEST_ASSERT_NEAR(21.3, temperature, 0.01);
+        TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_pressure(dev_hdl, &pressure));
+        TEST_ASSERT_NEAR(99000.0, pressure, pressure_tolerances[c]);
+
+        i2c_bmp280_rm(dev_hdl);
+        i2c_del_master_bus(bus_hdl);
+    }
+}
+
+static void test_bme280_humidity(void) {
+    static const i2c_bmp280_compensations_t compensations[] = { I2C_BMP280_COMPENSATION_INT64, I2C_BMP280_COMPENSATION_FLOAT };
+    i2c_bmp280_config_t dev_cfg = I2C_BMP280_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_bmp280_handle_t dev_hdl = NULL;
+    bmp280_sim_t sim;
+    i2c_sim_stats_t stats;
+    float temperature, pressure, humidity;
+    uint32_t age_us;
+
+    dev_cfg.power_mode = I2C_BMP280_POWER_MODE_FORCED;
+    bmp280_sim_init(&sim, I2C_BMP280_DEV_ADDR_HI, BMP280_SIM_CHIP_ID_BME280);
+    i2c_sim_attach_device(bus_hdl, &sim.device);
+    nvs_sim_erase_all();
+
+    for(size_t c = 0; c < sizeof(compensations) / sizeof(compensations[0]); c++) {
+        /* the second init reads the calibration block, humidity included, from the nvs cache */
+        dev_cfg.compensation = compensations[c];
+        TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_init(bus_hdl, &dev_cfg, &dev_hdl));
+        TEST_ASSERT_EQUAL_INT(I2C_BMP280_TYPE_BME280, dev_hdl->dev_type);
+        TEST_ASSERT_EQUAL_INT(75, dev_hdl->dev_cal_factors->dig_H1);
+        TEST_ASSERT_EQUAL_INT(362, dev_hdl->dev_cal_factors->dig_H2);
+        TEST_ASSERT_EQUAL_INT(0, dev_hdl->dev_cal_factors->dig_H3);
+        TEST_ASSERT_EQUAL_INT(313, dev_hdl->dev_cal_factors->dig_H4);
+        TEST_ASSERT_EQUAL_INT(50, dev_hdl->dev_cal_factors->dig_H5);
+        TEST_ASSERT_EQUAL_INT(30, dev_hdl->dev_cal_factors->dig_H6);
+        TEST_ASSERT_EQUAL_INT(I2C_BMP280_HUMIDITY_OVERSAMPLING_1X, dev_hdl->ctrl_hum_reg.bits.humidity_oversampling);
+
+        for(double h = 10.0; h <= 90.0; h += 20.0) {
+            bmp280_sim_set_environment(&sim, 18.0 + h / 10.0, 101325.0 - h * 10.0);
+            bmp280_sim_set_humidity(&sim, h);
+
+            /* one trigger and one 8-byte burst read of pressure, temperature and humidity */
+            i2c_sim_reset_stats(bus_hdl);
+            TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_forced_humidity_measurements(dev_hdl, &temperature, &pressure, &humidity));
+            i2c_sim_get_stats(bus_hdl, &stats);
+            TEST_ASSERT_EQUAL_INT(2, stats.transactions);
+            TEST_ASSERT_EQUAL_INT(2 + 1 + 8, stats.bytes);
+            TEST_ASSERT_NEAR(18.0 + h / 10.0, temperature, 0.01);
+            TEST_ASSERT_NEAR(101325.0 - h * 10.0, pressure, 1.0);
+            TEST_ASSERT_NEAR(h, humidity, 0.05);
+        }
+
+        /* status polled measurement with humidity */
+        TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_set_power_mode(dev_hdl, I2C_BMP280_POWER_MODE_NORMAL));
+        i2c_sim_clock_advance_us(1000000);
+        TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_humidity_measurements(dev_hdl, &temperature, &pressure, &humidity));
+        TEST_ASSERT_NEAR(90.0, humidity, 0.05);
+        TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_set_power_mode(dev_hdl, I2C_BMP280_POWER_MODE_SLEEP));
+
+        /* streamed measurements with humidity, one 8-byte burst read per measurement */
+        TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_start_streaming(dev_hdl));
+        bmp280_sim_set_humidity(&sim, 40.0);
+        i2c_sim_reset_stats(bus_hdl);
+        TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_next_measurements(dev_hdl, &temperature, &pressure, &humidity, &age_us));
+        i2c_sim_get_stats(bus_hdl, &stats);
+        TEST_ASSERT_EQUAL_INT(1, stats.transactions);
+        TEST_ASSERT_EQUAL_INT(1 + 8, stats.bytes);
+        TEST_ASSERT_NEAR(40.0, humidity, 0.05);
+        TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_stop_streaming(dev_hdl));
+
+        i2c_bmp280_rm(dev_hdl);
+    }
+
+    i2c_del_master_bus(bus_hdl);
+}
+
+static void test_bmp280_humidity_not_supported(void) {
+    const i2c_bmp280_config_t dev_cfg = I2C_BMP280_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_bmp280_handle_t dev_hdl = NULL;
+    bmp280_sim_t sim;
+    float temperature, pressure, humidity;
+    uint32_t age_us;
+
+    bmp280_sim_init(&sim, I2C_BMP280_DEV_ADDR_HI, BMP280_SIM_CHIP_ID_BMP280);
+    i2c_sim_attach_device(bus_hdl, &sim.device);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_init(bus_hdl, &dev_cfg, &dev_hdl));
+
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NOT_SUPPORTED, i2c_bmp280_get_humidity_measurements(dev_hdl, &temperature, &pressure, &humidity));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NOT_SUPPORTED, i2c_bmp280_get_forced_humidity_measurements(dev_hdl, &temperature, &pressure, &humidity));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NOT_SUPPORTED, i2c_bmp280_set_humidity_oversampling(dev_hdl, I2C_BMP280_HUMIDITY_OVERSAMPLING_2X));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_start_streaming(dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NOT_SUPPORTED, i2c_bmp280_get_next_measurements(dev_hdl, &temperature, &pressure, &humidity, &age_us));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NOT_SUPPORTED, i2c_bmp280_get_latest_measurements(dev_hdl, &temperature, &pressure, &humidity, &age_us));
+
+    i2c_bmp280_rm(dev_hdl);
+    i2c_del_master_bus(bus_hdl);
+}
+
+static void test_bmp280_register_shadow(void) {
+    i2c_bmp280_config_t dev_cfg = I2C_BMP280_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_bmp280_handle_t dev_hdl = NULL;
+    i2c_bmp280_pressure_oversampling_t pressure_oversampling;
+    i2c_bmp280_standby_times_t standby_time;
+    i2c_bmp280_humidity_oversampling_t humidity_oversampling;
+    i2c_sim_stats_t stats;
+    bmp280_sim_t sim;
+    float temperature, pressure, humidity;
+
+    bmp280_sim_init(&sim, I2C_BMP280_DEV_ADDR_HI, BMP280_SIM_CHIP_ID_BME280);
+    i2c_sim_attach_device(bus_hdl, &sim.device);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_init(bus_hdl, &dev_cfg, &dev_hdl));
+
+    /* settings are served from the register shadow */
+    i2c_sim_reset_stats(bus_hdl);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_pressure_oversampling(dev_hdl, &pressure_oversampling));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_standby_time(dev_hdl, &standby_time));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_humidity_oversampling(dev_hdl, &humidity_oversampling));
+    TEST_ASSERT_EQUAL_INT(I2C_BMP280_PRESSURE_OVERSAMPLING_4X, pressure_oversampling);
+    TEST_ASSERT_EQUAL_INT(I2C_BMP280_STANDBY_TIME_250MS, standby_time);
+    TEST_ASSERT_EQUAL_INT(I2C_BMP280_HUMIDITY_OVERSAMPLING_1X, humidity_oversampling);
+
+    /* unchanged settings are not written, changed settings cost one write */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_set_pressure_oversampling(dev_hdl, I2C_BMP280_PRESSURE_OVERSAMPLING_4X));
+    i2c_sim_get_stats(bus_hdl, &stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.transactions);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_set_pressure_oversampling(dev_hdl, I2C_BMP280_PRESSURE_OVERSAMPLING_16X));
+    i2c_sim_get_stats(bus_hdl, &stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.transactions);
+    TEST_ASSERT_EQUAL_INT(dev_hdl->ctrl_meas_reg.reg, sim.regs[0xf4]);
+
+    /* a humidity oversampling change re-writes the control measurement register for it to take effect */
+    i2c_sim_reset_stats(bus_hdl);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_set_humidity_oversampling(dev_hdl, I2C_BMP280_HUMIDITY_OVERSAMPLING_4X));
+    i2c_sim_get_stats(bus_hdl, &stats);
+    TEST_ASSERT_EQUAL_INT(2, stats.transactions);
+    TEST_ASSERT_EQUAL_INT(I2C_BMP280_HUMIDITY_OVERSAMPLING_4X, sim.ctrl_hum);
+
+    /* reconfiguring several fields costs one write per changed register */
+    dev_cfg.power_mode               = I2C_BMP280_POWER_MODE_FORCED;
+    dev_cfg.standby_time             = I2C_BMP280_STANDBY_TIME_1000MS;
+    dev_cfg.iir_filter               = I2C_BMP280_IIR_FILTER_4;
+    dev_cfg.pressure_oversampling    = I2C_BMP280_PRESSURE_OVERSAMPLING_8X;
+    dev_cfg.temperature_oversampling = I2C_BMP280_TEMPERATURE_OVERSAMPLING_2X;
+    dev_cfg.humidity_oversampling    = I2C_BMP280_HUMIDITY_OVERSAMPLING_4X;
+    i2c_sim_reset_stats(bus_hdl);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_reconfigure(dev_hdl, &dev_cfg));
+    i2c_sim_get_stats(bus_hdl, &stats);
+    TEST_ASSERT_EQUAL_INT(2, stats.transactions);
+    TEST_ASSERT_EQUAL_INT(dev_hdl->config_reg.reg, sim.regs[0xf5]);
+    TEST_ASSERT_EQUAL_INT(dev_hdl->ctrl_meas_reg.reg, sim.regs[0xf4]);
+    TEST_ASSERT_EQUAL_INT(I2C_BMP280_POWER_MODE_SLEEP, dev_hdl->ctrl_meas_reg.bits.power_mode);
+    i2c_sim_reset_stats(bus_hdl);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_reconfigure(dev_hdl, &dev_cfg));
+    i2c_sim_get_stats(bus_hdl, &stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.transactions);
+
+    /* forced measurements follow the shadowed settings */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_forced_humidity_measurements(dev_hdl, &temperature, &pressure, &humidity));
+    TEST_ASSERT_NEAR(25.08, temperature, 0.01);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_forced_humidity_measurements(dev_hdl, &temperature, &pressure, &humidity));
+    TEST_ASSERT_NEAR(100653.27, pressure, 1.0);
+
+    i2c_bmp280_rm(dev_hdl);
+
+    /* verified writes are read back */
+    dev_cfg = (i2c_bmp280_config_t)I2C_BMP280_CONFIG_DEFAULT;
+    dev_cfg.verify_registers = true;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_init(bus_hdl, &dev_cfg, &dev_hdl));
+    i2c_sim_reset_stats(bus_hdl);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_set_standby_time(dev_hdl, I2C_BMP280_STANDBY_TIME_125MS));
+    i2c_sim_get_stats(bus_hdl, &stats);
+    TEST_ASSERT_EQUAL_INT(2, stats.transactions);
+    TEST_ASSERT_EQUAL_INT(dev_hdl->config_reg.reg, sim.regs[0xf5]);
+
+    i2c_bmp280_rm(dev_hdl);
+    i2c_del_master_bus(bus_hdl);
+}
+
+static void test_i2c_batch(void) {
+    const i2c_device_config_t dev_cfg = { .dev_addr_length = I2C_ADDR_BIT_LEN_7, .device_address = I2C_BMP280_DEV_ADDR_HI, .scl_speed_hz = 100000 };
+    const i2c_device_config_t missing_cfg = { .dev_addr_length = I2C_ADDR_BIT_LEN_7, .device_address = I2C_BMP280_DEV_ADDR_LO, .scl_speed_hz = 100000 };
+    const uint8_t ctrl_config[3] = { 0x24, 0xf5, 0xa0 }; // bmp280 multi-byte writes are register address and data pairs
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_master_dev_handle_t dev_hdl = NULL, missing_hdl = NULL;
+    i2c_sim_stats_t stats;
+    i2c_batch_t batch;
+    bmp280_sim_t sim;
+    uint8_t chip_id = 0, config = 0, data[2] = { 0 };
+
+    bmp280_sim_init(&sim, I2C_BMP280_DEV_ADDR_HI, BMP280_SIM_CHIP_ID_BMP280);
+    i2c_sim_attach_device(bus_hdl, &sim.device);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_bus_add_device(bus_hdl, &dev_cfg, &dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_bus_add_device(bus_hdl, &missing_cfg, &missing_hdl));
+
+    /* writes and read-backs run in queued order without delays between transactions */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_batch_init(&batch, dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_batch_read(&batch, 0xd0, &chip_id, 1));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_batch_write_uint8(&batch, 0xf5, 0xa8));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_batch_read(&batch, 0xf5, &config, 1));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_batch_write(&batch, 0xf4, ctrl_config, sizeof(ctrl_config)));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_batch_read(&batch, 0xf4, data, sizeof(data)));
+    i2c_sim_reset_stats(bus_hdl);
+    int64_t start_us = i2c_sim_clock_get_us();
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_batch_execute(&batch));
+    i2c_sim_get_stats(bus_hdl, &stats);
+    TEST_ASSERT_EQUAL_INT(5, stats.transactions);
+    TEST_ASSERT(i2c_sim_clock_get_us() - start_us < 5000);
+    TEST_ASSERT_EQUAL_INT(BMP280_SIM_CHIP_ID_BMP280, chip_id);
+    TEST_ASSERT_EQUAL_INT(0xa8, config);
+    TEST_ASSERT_EQUAL_INT(0x24, data[0]);
+    TEST_ASSERT_EQUAL_INT(0xa0, data[1]);
+    for(uint8_t i = 0; i < batch.ops_size; i++) TEST_ASSERT_EQUAL_INT(ESP_OK, batch.ops[i].result);
+
+    /* a full batch is not executed */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_batch_init(&batch, dev_hdl));
+    for(uint8_t i = 0; i < I2C_BATCH_OPS_MAX; i++) TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_batch_read(&batch, 0xd0, &chip_id, 1));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NO_MEM, i2c_master_batch_read(&batch, 0xd0, &chip_id, 1));
+    i2c_sim_reset_stats(bus_hdl);
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NO_MEM, i2c_master_batch_execute(&batch));
+    i2c_sim_get_stats(bus_hdl, &stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.transactions);
+
+    /* oversized writes are rejected */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_batch_init(&batch, dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_ARG, i2c_master_batch_write(&batch, 0xf4, ctrl_config, I2C_BATCH_WRITE_MAX + 1));
+
+    /* execution stops at the first failed operation */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_batch_init(&batch, missing_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_batch_write_uint8(&batch, 0xf5, 0x00));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_batch_read(&batch, 0xf5, &config, 1));
+    TEST_ASSERT(i2c_master_batch_execute(&batch) != ESP_OK);
+    TEST_ASSERT(batch.ops[0].result != ESP_OK);
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, batch.ops[1].result);
+    TEST_ASSERT_EQUAL_INT(0xa8, config);
+
+    i2c_master_bus_rm_device(missing_hdl);
+    i2c_master_bus_rm_device(dev_hdl);
+    i2c_del_master_bus(bus_hdl);
+}
+
+static void test_i2c_stats(void) {
+    const i2c_device_config_t dev_cfg = { .dev_addr_length = I2C_ADDR_BIT_LEN_7, .device_address = I2C_BMP280_DEV_ADDR_HI, .scl_speed_hz = 100000 };
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_master_dev_handle_t dev_hdl = NULL;
+    i2c_master_stats_t stats, all_stats[I2C_STATS_DEVICES_MAX];
+    uint8_t all_stats_size = 0;
+    bmp280_sim_t sim;
+    uint8_t chip_id = 0;
+
+    bmp280_sim_init(&sim, I2C_BMP280_DEV_ADDR_HI, BMP280_SIM_CHIP_ID_BMP280);
+    i2c_sim_attach_device(bus_hdl, &sim.device);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_bus_add_device(bus_hdl, &dev_cfg, &dev_hdl));
+
+    /* unregistered handles aren't counted, registration keeps earlier statistics of the address */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_register(dev_hdl, I2C_BMP280_DEV_ADDR_HI));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_reset());
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NOT_FOUND, i2c_master_stats_get(0x7f, &stats));
+
+    /* a register read is 4 bytes on the wire with both addresses, 380 us at 100 kHz */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_bus_read_uint8(dev_hdl, 0xd0, &chip_id));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_bus_write_uint8(dev_hdl, 0xf5, 0xa8));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_get(I2C_BMP280_DEV_ADDR_HI, &stats));
+    TEST_ASSERT_EQUAL_INT(I2C_BMP280_DEV_ADDR_HI, stats.device_address);
+    TEST_ASSERT_EQUAL_INT(2, stats.transactions);
+    TEST_ASSERT_EQUAL_INT(4, stats.bytes);
+    TEST_ASSERT_EQUAL_INT(0, stats.nacks);
+    TEST_ASSERT_EQUAL_INT(0, stats.timeouts);
+    TEST_ASSERT_EQUAL_INT(380, stats.latency_max_us);
+    TEST_ASSERT_EQUAL_INT(2, stats.latency_hist[3]); // 256 to 512 us
+    TEST_ASSERT_EQUAL_INT(380 + 290, (int)stats.latency_sum_us);
+
+    /* failed transactions count as nacks, their bytes aren't counted */
+    sim.device.nack_count = 1;
+    TEST_ASSERT(i2c_master_bus_read_uint8(dev_hdl, 0xd0, &chip_id) != ESP_OK);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_count_retry(dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_bus_read_uint8(dev_hdl, 0xd0, &chip_id));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_get(I2C_BMP280_DEV_ADDR_HI, &stats));
+    TEST_ASSERT_EQUAL_INT(4, stats.transactions);
+    TEST_ASSERT_EQUAL_INT(6, stats.bytes);
+    TEST_ASSERT_EQUAL_INT(1, stats.nacks);
+    TEST_ASSERT_EQUAL_INT(1, stats.retries);
+
+    /* longer transactions fall in later buckets */
+    uint32_t hist_sum = 0;
+    i2c_uint64_t data;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_bus_read_byte64(dev_hdl, 0x88, &data));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_get(I2C_BMP280_DEV_ADDR_HI, &stats));
+    TEST_ASSERT_EQUAL_INT(1, stats.latency_hist[4]); // 512 to 1024 us
+    for(uint8_t b = 0; b < I2C_STATS_LATENCY_BUCKETS; b++) hist_sum += stats.latency_hist[b];
+    TEST_ASSERT_EQUAL_INT(stats.transactions, hist_sum);
+
+    /* unregistered handles aren't counted, the address keeps its statistics */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_unregister(dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NOT_FOUND, i2c_master_stats_unregister(dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_bus_read_uint8(dev_hdl, 0xd0, &chip_id));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_get_all(all_stats, &all_stats_size));
+    TEST_ASSERT(all_stats_size >= 1);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_get(I2C_BMP280_DEV_ADDR_HI, &stats));
+    TEST_ASSERT_EQUAL_INT(5, stats.transactions);
+
+    /* a snapshot with reset returns the counters and clears them, the address is kept */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_get_all_and_reset(all_stats, &all_stats_size));
+    for(uint8_t i = 0; i < all_stats_size; i++) {
+        if(all_stats[i].device_address == I2C_BMP280_DEV_ADDR_HI) TEST_ASSERT_EQUAL_INT(5, all_stats[i].transactions);
+    }
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_get(I2C_BMP280_DEV_ADDR_HI, &stats));
+    TEST_ASSERT_EQUAL_INT(0, stats.transactions);
+    TEST_ASSERT_EQUAL_INT(I2C_BMP280_DEV_ADDR_HI, stats.device_address);
+
+    /* reset clears the counters and keeps the address */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_reset());
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_get(I2C_BMP280_DEV_ADDR_HI, &stats));
+    TEST_ASSERT_EQUAL_INT(0, stats.transactions);
+    TEST_ASSERT_EQUAL_INT(0, stats.latency_max_us);
+
+    i2c_master_bus_rm_device(dev_hdl);
+    i2c_del_master_bus(bus_hdl);
+}
+
+static esp_err_t bmp280_forced_operation(void *op_ctx) {
+    float temperature, pressure;
+    return i2c_bmp280_get_forced_measurements((i2c_bmp280_handle_t)op_ctx, &temperature, &pressure);
+}
+
+static esp_err_t bmp280_reinit_hook(void *device_ctx) {
+    return i2c_bmp280_reinit((i2c_bmp280_handle_t)device_ctx);
+}
+
+static void test_i2c_recovery(void) {
+    i2c_bmp280_config_t dev_cfg = I2C_BMP280_CONFIG_DEFAULT;
+    const i2c_recovery_config_t recovery_cfg = I2C_RECOVERY_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_bmp280_handle_t dev_hdl = NULL;
+    i2c_recovery_t recovery;
+    i2c_device_health_t health;
+    i2c_master_stats_t stats;
+    i2c_sim_stats_t sim_stats;
+    bmp280_sim_t sim;
+
+    bmp280_sim_init(&sim, I2C_BMP280_DEV_ADDR_HI, BMP280_SIM_CHIP_ID_BMP280);
+    i2c_sim_attach_device(bus_hdl, &sim.device);
+    dev_cfg.power_mode = I2C_BMP280_POWER_MODE_FORCED;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_recovery_init(&recovery, &recovery_cfg, bus_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_init(bus_hdl, &dev_cfg, &dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_recovery_set_device(&recovery, dev_hdl->i2c_dev_handle, bmp280_reinit_hook, dev_hdl));
+    const uint8_t config = sim.regs[0xf5], ctrl_meas = sim.regs[0xf4];
+    TEST_ASSERT(config != 0);
+
+    /* a first attempt success is healthy */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_recovery_execute(&recovery, bmp280_forced_operation, dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_recovery_get_health(&recovery, &health));
+    TEST_ASSERT_EQUAL_INT(I2C_DEVICE_HEALTH_OK, health.state);
+
+    /* a held bus times out, it is reset and the device, reset by the glitch, is re-initialized */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_reset());
+    i2c_sim_reset_stats(bus_hdl);
+    i2c_sim_hold_bus(bus_hdl);
+    sim.regs[0xf5] = 0x00;
+    sim.regs[0xf4] = 0x00;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_recovery_execute(&recovery, bmp280_forced_operation, dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_recovery_get_health(&recovery, &health));
+    TEST_ASSERT_EQUAL_INT(I2C_DEVICE_HEALTH_DEGRADED, health.state);
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_TIMEOUT, health.last_error);
+    TEST_ASSERT_EQUAL_INT(1, health.recoveries);
+    TEST_ASSERT_EQUAL_INT(1, health.bus_resets);
+    TEST_ASSERT_EQUAL_INT(1, health.reinits);
+    i2c_sim_get_stats(bus_hdl, &sim_stats);
+    TEST_ASSERT_EQUAL_INT(1, sim_stats.timeouts);
+    TEST_ASSERT_EQUAL_INT(1, sim_stats.resets);
+    TEST_ASSERT_EQUAL_INT(config, sim.regs[0xf5]);
+    TEST_ASSERT_EQUAL_INT(ctrl_meas & 0xfc, sim.regs[0xf4] & 0xfc);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_stats_get(I2C_BMP280_DEV_ADDR_HI, &stats));
+    TEST_ASSERT_EQUAL_INT(1, stats.timeouts);
+    TEST_ASSERT_EQUAL_INT(1, stats.retries);
+
+    /* a persistent fault fails after every retry with a backoff, the first retry doesn't reset the bus, a backoff tick delay ends early by up to a tick */
+    sim.device.nack_count = 1000;
+    i2c_sim_reset_stats(bus_hdl);
+    int64_t start_us = i2c_sim_clock_get_us();
+    TEST_ASSERT(i2c_master_recovery_execute(&recovery, bmp280_forced_operation, dev_hdl) != ESP_OK);
+    TEST_ASSERT((i2c_sim_clock_get_us() - start_us) >= (int64_t)(10 + 20 + 40 - 3 * portTICK_PERIOD_MS) * 1000);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_recovery_get_health(&recovery, &health));
+    TEST_ASSERT_EQUAL_INT(I2C_DEVICE_HEALTH_FAILED, health.state);
+    TEST_ASSERT_EQUAL_INT(1, health.failures);
+    TEST_ASSERT_EQUAL_INT(1 + 2, health.bus_resets);
+    i2c_sim_get_stats(bus_hdl, &sim_stats);
+    TEST_ASSERT_EQUAL_INT(2, sim_stats.resets);
+
+    /* a scheduled request result completes with a retry, the device recovers */
+    sim.device.nack_count = 0;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_recovery_retry(&recovery, ESP_FAIL, bmp280_forced_operation, dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_recovery_get_health(&recovery, &health));
+    TEST_ASSERT_EQUAL_INT(I2C_DEVICE_HEALTH_DEGRADED, health.state);
+    TEST_ASSERT_EQUAL_INT(0, health.failures);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_recovery_retry(&recovery, ESP_OK, bmp280_forced_operation, dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_recovery_get_health(&recovery, &health));
+    TEST_ASSERT_EQUAL_INT(I2C_DEVICE_HEALTH_OK, health.state);
+
+    /* an error other than a bus or transfer error fails at once, without a backoff or bus reset */
+    const uint32_t bus_resets = health.bus_resets;
+    start_us = i2c_sim_clock_get_us();
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, i2c_master_recovery_retry(&recovery, ESP_ERR_INVALID_STATE, bmp280_forced_operation, dev_hdl));
+    TEST_ASSERT_EQUAL_INT(start_us, i2c_sim_clock_get_us());
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_recovery_get_health(&recovery, &health));
+    TEST_ASSERT_EQUAL_INT(I2C_DEVICE_HEALTH_FAILED, health.state);
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, health.last_error);
+    TEST_ASSERT_EQUAL_INT(bus_resets, health.bus_resets);
+
+    i2c_bmp280_rm(dev_hdl);
+    i2c_del_master_bus(bus_hdl);
+}
+
+typedef struct {
+    uint32_t    completions;
+    esp_err_t   result;
+} async_completions_t;
+
+static void async_on_completion(i2c_master_dev_handle_t handle, const esp_err_t result, void *user_ctx) {
+    async_completions_t *completions = (async_completions_t *)user_ctx;
+    (void)handle;
+    completions->completions++;
+    completions->result = result;
+}
+
+static void test_i2c_async(void) {
+    const i2c_master_bus_config_t bus_cfg = { .i2c_port = I2C_NUM_1, .trans_queue_depth = 8 };
+    const i2c_device_config_t dev_cfg = { .dev_addr_length = I2C_ADDR_BIT_LEN_7, .device_address = I2C_BMP280_DEV_ADDR_HI, .scl_speed_hz = 100000 };
+    i2c_master_bus_handle_t bus_hdl = NULL, sync_bus_hdl = new_bus();
+    i2c_master_dev_handle_t dev_hdl = NULL, sync_dev_hdl = NULL;
+    async_completions_t completions = { 0 };
+    i2c_async_t async;
+    bmp280_sim_t sim;
+    uint8_t chip_id = 0, config = 0;
+
+    /* asynchronous operations need a bus in asynchronous mode */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_bus_add_device(sync_bus_hdl, &dev_cfg, &sync_dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, i2c_master_async_init(&async, sync_dev_hdl));
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_new_master_bus(&bus_cfg, &bus_hdl));
+    bmp280_sim_init(&sim, I2C_BMP280_DEV_ADDR_HI, BMP280_SIM_CHIP_ID_BMP280);
+    i2c_sim_attach_device(bus_hdl, &sim.device);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_bus_add_device(bus_hdl, &dev_cfg, &dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_async_init(&async, dev_hdl));
+
+    /* submissions return before the transfers, the wire time is not spent by the task */
+    int64_t start_us = i2c_sim_clock_get_us();
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_async_read(&async, 0xd0, &chip_id, 1, async_on_completion, &completions));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_async_write(&async, 0xf5, (const uint8_t[]){ 0xa8 }, 1, NULL, NULL));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_async_read(&async, 0xf5, &config, 1, async_on_completion, &completions));
+    TEST_ASSERT_EQUAL_INT(start_us, i2c_sim_clock_get_us());
+    TEST_ASSERT_EQUAL_INT(3, async.ops_size);
+    TEST_ASSERT_EQUAL_INT(0, chip_id);
+
+    /* transfers complete in the background while the task computes */
+    i2c_sim_clock_advance_us(400);
+    TEST_ASSERT_EQUAL_INT(1, completions.completions);
+    TEST_ASSERT_EQUAL_INT(BMP280_SIM_CHIP_ID_BMP280, chip_id);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_async_wait_all_done(&async, 100));
+    TEST_ASSERT_EQUAL_INT(2, completions.completions);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, completions.result);
+    TEST_ASSERT_EQUAL_INT(0xa8, config);
+    TEST_ASSERT(i2c_sim_clock_get_us() - start_us < 2000);
+
+    /* the in-flight queue is bounded */
+    for(uint8_t i = 0; i < I2C_ASYNC_QUEUE_DEPTH; i++) TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_async_read(&async, 0xd0, &chip_id, 1, NULL, NULL));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NO_MEM, i2c_master_async_read(&async, 0xd0, &chip_id, 1, NULL, NULL));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, i2c_master_async_deinit(&async));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_TIMEOUT, i2c_master_async_wait_all_done(&async, 0));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_async_wait_all_done(&async, 100));
+
+    /* failed completions are reported to the callback and the wait */
+    sim.device.nack_count = 1;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_async_read(&async, 0xf5, &config, 1, async_on_completion, &completions));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_async_read(&async, 0xf5, &config, 1, NULL, NULL));
+    TEST_ASSERT_EQUAL_INT(ESP_FAIL, i2c_master_async_wait_all_done(&async, 100));
+    TEST_ASSERT_EQUAL_INT(3, completions.completions);
+    TEST_ASSERT_EQUAL_INT(ESP_FAIL, completions.result);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_async_wait_all_done(&async, 100));
+
+    /* a task other than the initializing task is woken by the completions it waits for */
+    async.task_handle = NULL;
+    start_us = i2c_sim_clock_get_us();
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_async_read(&async, 0xd0, &chip_id, 1, NULL, NULL));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_async_wait_all_done(&async, 100));
+    TEST_ASSERT(i2c_sim_clock_get_us() - start_us < 2000);
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_master_async_deinit(&async));
+    i2c_master_bus_rm_device(dev_hdl);
+    i2c_master_bus_rm_device(sync_dev_hdl);
+    i2c_del_master_bus(bus_hdl);
+    i2c_del_master_bus(sync_bus_hdl);
+}
+
+static void test_bmp280_invalid_chip(void) {
+    const i2c_bmp280_config_t dev_cfg = I2C_BMP280_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_bmp280_handle_t dev_hdl = NULL;
+    bmp280_sim_t sim;
+
+    bmp280_sim_init(&sim, I2C_BMP280_DEV_ADDR_HI, 0x55);
+    i2c_sim_attach_device(bus_hdl, &sim.device);
+
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_VERSION, i2c_bmp280_init(bus_hdl, &dev_cfg, &dev_hdl));
+    TEST_ASSERT(dev_hdl == NULL);
+
+    i2c_del_master_bus(bus_hdl);
+}
+
+static void test_bmp280_missing_device(void) {
+    const i2c_bmp280_config_t dev_cfg = I2C_BMP280_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_bmp280_handle_t dev_hdl = NULL;
+
+    TEST_ASSERT(i2c_bmp280_init(bus_hdl, &dev_cfg, &dev_hdl) != ESP_OK);
+    TEST_ASSERT(dev_hdl == NULL);
+
+    i2c_del_master_bus(bus_hdl);
+}
+
+static void test_ahtxx_measurements(void) {
+    const i2c_ahtxx_config_t dev_cfg = I2C_AHT2X_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_ahtxx_handle_t dev_hdl = NULL;
+    ahtxx_sim_t sim;
+    float temperature, humidity, dewpoint;
+
+    ahtxx_sim_init(&sim, I2C_AHTXX_DEV_ADDR);
+    i2c_sim_attach_device(bus_hdl, &sim.device);
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_ahtxx_init(bus_hdl, &dev_cfg, &dev_hdl));
+    TEST_ASSERT(dev_hdl != NULL);
+
+    ahtxx_sim_set_environment(&sim, 21.5, 63.0);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_ahtxx_get_measurements(dev_hdl, &temperature, &humidity, &dewpoint));
+    TEST_ASSERT_NEAR(21.5, temperature, 0.01);
+    TEST_ASSERT_NEAR(63.0, humidity, 0.01);
+    TEST_ASSERT_NEAR(14.19, dewpoint, 0.1);
+    TEST_ASSERT_EQUAL_INT(1, sim.measurements);
+
+    /* not acknowledged measurement trigger */
+    sim.device.nack_count = 1;
+    TEST_ASSERT(i2c_ahtxx_get_measurement(dev_hdl, &temperature, &humidity) != ESP_OK);
+
+    i2c_ahtxx_rm(dev_hdl);
+    i2c_del_master_bus(bus_hdl);
+}
+
+static void test_ahtxx_split_measurement(void) {
+    const i2c_ahtxx_config_t dev_cfg = I2C_AHT2X_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_ahtxx_handle_t dev_hdl = NULL;
+    ahtxx_sim_t sim;
+    float temperature = 0, humidity = 0, dewpoint;
+    bool ready;
+
+    ahtxx_sim_init(&sim, I2C_AHTXX_DEV_ADDR);
+    i2c_sim_attach_device(bus_hdl, &sim.device);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_ahtxx_init(bus_hdl, &dev_cfg, &dev_hdl));
+
+    /* nothing to collect before a trigger */
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, i2c_ahtxx_read_if_ready(dev_hdl, &ready, &temperature, &humidity));
+
+    /* busy until the conversion completes */
+    ahtxx_sim_set_environment(&sim, -5.0, 80.0);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_ahtxx_start_measurement(dev_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_ahtxx_read_if_ready(dev_hdl, &ready, &temperature, &humidity));
+    TEST_ASSERT(!ready);
+    i2c_sim_clock_advance_us(AHTXX_SIM_MEASUREMENT_TIME_US);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_ahtxx_read_if_ready(dev_hdl, &ready, &temperature, &humidity));
+    TEST_ASSERT(ready);
+    TEST_ASSERT_NEAR(-5.0, temperature, 0.01);
+    TEST_ASSERT_NEAR(80.0, humidity, 0.01);
+
+    /* the busy bit poll returns shortly after the conversion, not after a fixed delay */
+    const int64_t start_us = i2c_sim_clock_get_us();
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_ahtxx_get_measurement(dev_hdl, &temperature, &humidity));
+    TEST_ASSERT(i2c_sim_clock_get_us() - start_us < 100000);
+
+    /* a conversion that never completes times out */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_ahtxx_start_measurement(dev_hdl));
+    sim.busy_until_us += 10000000;
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_TIMEOUT, i2c_ahtxx_wait_measurement(dev_hdl, &temperature, &humidity));
+
+    /* dew-point at freezing temperature */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_ahtxx_calculate_dewpoint(0.0f, 100.0f, &dewpoint));
+    TEST_ASSERT_NEAR(0.0, dewpoint, 0.01);
+
+    i2c_ahtxx_rm(dev_hdl);
+    i2c_del_master_bus(bus_hdl);
+}
+
+static void test_shared_bus(void) {
+    const i2c_bmp280_config_t bmp280_cfg = I2C_BMP280_CONFIG_DEFAULT;
+    const i2c_ahtxx_config_t  ahtxx_cfg  = I2C_AHT2X_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    i2c_bmp280_handle_t bmp280_hdl = NULL;
+    i2c_ahtxx_handle_t ahtxx_hdl = NULL;
+    bmp280_sim_t bmp280_sim;
+    ahtxx_sim_t ahtxx_sim;
+    i2c_sim_stats_t stats;
+    float temperature, humidity, dewpoint, pressure;
+
+    bmp280_sim_init(&bmp280_sim, I2C_BMP280_DEV_ADDR_HI, BMP280_SIM_CHIP_ID_BMP280);
+    ahtxx_sim_init(&ahtxx_sim, I2C_AHTXX_DEV_ADDR);
+    i2c_sim_attach_device(bus_hdl, &bmp280_sim.device);
+    i2c_sim_attach_device(bus_hdl, &ahtxx_sim.device);
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_init(bus_hdl, &bmp280_cfg, &bmp280_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_ahtxx_init(bus_hdl, &ahtxx_cfg, &ahtxx_hdl));
+
+    /* one sampling cycle of the application */
+    i2c_sim_reset_stats(bus_hdl);
+    const int64_t start_us = i2c_sim_clock_get_us();
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_ahtxx_start_measurement(ahtxx_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_get_pressure(bmp280_hdl, &pressure));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_ahtxx_wait_measurement(ahtxx_hdl, &temperature, &humidity));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_ahtxx_calculate_dewpoint(temperature, humidity, &dewpoint));
+    i2c_sim_get_stats(bus_hdl, &stats);
+
+    TEST_ASSERT(stats.transactions > 0);
+    TEST_ASSERT_EQUAL_INT(0, stats.nacks);
+    printf("sampling cycle: %u transactions, %u bytes, %lld us\n", stats.transactions, stats.bytes, (long long)(i2c_sim_clock_get_us() - start_us));
+
+    i2c_bmp280_rm(bmp280_hdl);
+    i2c_ahtxx_rm(ahtxx_hdl);
+    i2c_del_master_bus(bus_hdl);
+}
+
+/* synthetic scheduler device, every step takes 100 us on the bus */
+typedef struct scheduler_device_tag {
+    uint32_t    steps_size;
+    uint32_t    delays_us[4];
+    int64_t     starts_us[4];
+    esp_err_t   fail;
+} scheduler_device_t;
+
+static esp_err_t scheduler_device_step(void *device_ctx, const uint32_t step, uint32_t *const delay_us) {
+    scheduler_device_t *device = (scheduler_device_t*)device_ctx;
+    device->starts_us[step] = i2c_sim_clock_get_us();
+    i2c_sim_clock_advance_us(100);
+    if(device->fail != ESP_OK) return device->fail;
+    *delay_us = (step + 1 < device->steps_size) ? device->delays_us[step] : I2C_BUS_SCHEDULER_STEP_DONE;
+    return ESP_OK;
+}
+
+static void test_i2c_bus_scheduler(void) {
+    scheduler_device_t a = { .steps_size = 3, .delays_us = { 10000, 0 } };
+    scheduler_device_t b = { .steps_size = 2, .delays_us = { 3000 } };
+    const i2c_bus_scheduler_device_config_t a_cfg = { .name = "a", .turnaround_us = 2000, .step = scheduler_device_step, .device_ctx = &a };
+    const i2c_bus_scheduler_device_config_t b_cfg = { .name = "b", .turnaround_us = 500, .step = scheduler_device_step, .device_ctx = &b };
+    i2c_bus_scheduler_handle_t hdl = NULL;
+    i2c_bus_scheduler_cycle_stats_t stats;
+    esp_err_t result;
+    uint8_t index;
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_init(&hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_add_device(hdl, &a_cfg, NULL));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_add_device(hdl, &b_cfg, &index));
+    TEST_ASSERT_EQUAL_INT(1, index);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_get_device_result(hdl, 0, &result));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, result);
+
+    /* b runs during the conversion of a, every step starts exactly when due */
+    const int64_t start_us = i2c_sim_clock_get_us();
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_run_cycle(hdl));
+    TEST_ASSERT_EQUAL_INT(0, (int)(a.starts_us[0] - start_us));
+    TEST_ASSERT_EQUAL_INT(100, (int)(b.starts_us[0] - start_us));
+    TEST_ASSERT_EQUAL_INT(3200, (int)(b.starts_us[1] - start_us));
+    TEST_ASSERT_EQUAL_INT(10100, (int)(a.starts_us[1] - start_us));
+    TEST_ASSERT_EQUAL_INT(12200, (int)(a.starts_us[2] - start_us));   /* the turnaround of a applies, its step delay is 0 */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_get_device_result(hdl, 1, &result));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, result);
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_get_cycle_stats(hdl, &stats));
+    TEST_ASSERT_EQUAL_INT(5, stats.steps);
+    TEST_ASSERT_EQUAL_INT(12300, stats.cycle_us);
+    TEST_ASSERT_EQUAL_INT(500, stats.busy_us);
+    TEST_ASSERT_EQUAL_INT(11800, stats.idle_us);
+    TEST_ASSERT_NEAR(100.0 * 500 / 12300, stats.utilization, 0.001);
+
+    /* the turnaround is kept across cycles, b is due first */
+    const int64_t next_us = i2c_sim_clock_get_us();
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_run_cycle(hdl));
+    TEST_ASSERT_EQUAL_INT(0, (int)(b.starts_us[0] - next_us));
+    TEST_ASSERT_EQUAL_INT(2000, (int)(a.starts_us[0] - next_us));
+
+    /* a failed device doesn't stop the other device */
+    a.fail = ESP_ERR_TIMEOUT;
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_TIMEOUT, i2c_bus_scheduler_run_cycle(hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_get_device_result(hdl, 0, &result));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_TIMEOUT, result);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_get_device_result(hdl, 1, &result));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, result);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_get_cycle_stats(hdl, &stats));
+    TEST_ASSERT_EQUAL_INT(3, stats.steps);
+
+    /* capacity */
+    for(int i = 2; i < I2C_BUS_SCHEDULER_DEVICES_MAX; i++) {
+        TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_add_device(hdl, &b_cfg, NULL));
+    }
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NO_MEM, i2c_bus_scheduler_add_device(hdl, &b_cfg, NULL));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_ARG, i2c_bus_scheduler_get_device_result(hdl, I2C_BUS_SCHEDULER_DEVICES_MAX, &result));
+
+    i2c_bus_scheduler_del(hdl);
+}
+
+typedef struct scheduler_sensors_tag {
+    i2c_bmp280_handle_t bmp280_hdl;
+    i2c_ahtxx_handle_t  ahtxx_hdl;
+    float               pressure;
+    float               bmp280_temperature;
+    float               temperature;
+    float               humidity;
+} scheduler_sensors_t;
+
+static esp_err_t scheduler_bmp280_step(void *device_ctx, const uint32_t step, uint32_t *const delay_us) {
+    scheduler_sensors_t *sensors = (scheduler_sensors_t*)device_ctx;
+    if(step == 0) return i2c_bmp280_start_forced_measurement(sensors->bmp280_hdl, delay_us);
+    *delay_us = I2C_BUS_SCHEDULER_STEP_DONE;
+    return i2c_bmp280_wait_forced_measurements(sensors->bmp280_hdl, &sensors->bmp280_temperature, &sensors->pressure, NULL);
+}
+
+static esp_err_t scheduler_ahtxx_step(void *device_ctx, const uint32_t step, uint32_t *const delay_us) {
+    scheduler_sensors_t *sensors = (scheduler_sensors_t*)device_ctx;
+    bool ready;
+    if(step == 0) {
+        *delay_us = I2C_AHTXX_MEASUREMENT_TIME_US;
+        return i2c_ahtxx_start_measurement(sensors->ahtxx_hdl);
+    }
+    const esp_err_t ret = i2c_ahtxx_read_if_ready(sensors->ahtxx_hdl, &ready, &sensors->temperature, &sensors->humidity);
+    *delay_us = ready ? I2C_BUS_SCHEDULER_STEP_DONE : I2C_BUS_SCHEDULER_STEP_POLL;
+    return ret;
+}
+
+static void test_i2c_bus_scheduler_sensors(void) {
+    i2c_bmp280_config_t bmp280_cfg = I2C_BMP280_CONFIG_DEFAULT;
+    const i2c_ahtxx_config_t ahtxx_cfg = I2C_AHT2X_CONFIG_DEFAULT;
+    i2c_master_bus_handle_t bus_hdl = new_bus();
+    scheduler_sensors_t sensors = { 0 };
+    const i2c_bus_scheduler_device_config_t bmp280_dev_cfg = { .name = "bmp280", .turnaround_us = I2C_BMP280_TURNAROUND_US, .step = scheduler_bmp280_step, .device_ctx = &sensors };
+    const i2c_bus_scheduler_device_config_t ahtxx_dev_cfg  = { .name = "ahtxx", .turnaround_us = I2C_AHTXX_TURNAROUND_US, .step = scheduler_ahtxx_step, .device_ctx = &sensors };
+    i2c_bus_scheduler_handle_t hdl = NULL;
+    i2c_bus_scheduler_cycle_stats_t stats;
+    bmp280_sim_t bmp280_sim;
+    ahtxx_sim_t ahtxx_sim;
+    float temperature;
+
+    bmp280_cfg.power_mode = I2C_BMP280_POWER_MODE_FORCED;
+    bmp280_sim_init(&bmp280_sim, I2C_BMP280_DEV_ADDR_HI, BMP280_SIM_CHIP_ID_BMP280);
+    ahtxx_sim_init(&ahtxx_sim, I2C_AHTXX_DEV_ADDR);
+    i2c_sim_attach_device(bus_hdl, &bmp280_sim.device);
+    i2c_sim_attach_device(bus_hdl, &ahtxx_sim.device);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bmp280_init(bus_hdl, &bmp280_cfg, &sensors.bmp280_hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_ahtxx_init(bus_hdl, &ahtxx_cfg, &sensors.ahtxx_hdl));
+
+    /* nothing to read before a forced measurement is started */
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, i2c_bmp280_wait_forced_measurements(sensors.bmp280_hdl, &temperature, &sensors.pressure, NULL));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_NOT_SUPPORTED, i2c_bmp280_wait_forced_measurements(sensors.bmp280_hdl, &temperature, &sensors.pressure, &sensors.humidity));
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_init(&hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_add_device(hdl, &ahtxx_dev_cfg, NULL));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_add_device(hdl, &bmp280_dev_cfg, NULL));
+
+    /* the bmp280 conversion completes during the ahtxx conversion, the cycle is the ahtxx conversion time */
+    bmp280_sim_set_environment(&bmp280_sim, 18.0, 99500.0);
+    ahtxx_sim_set_environment(&ahtxx_sim, 18.0, 55.0);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_run_cycle(hdl));
+    TEST_ASSERT_NEAR(99500.0, sensors.pressure, 1.0);
+    TEST_ASSERT_NEAR(18.0, sensors.temperature, 0.01);
+    TEST_ASSERT_NEAR(55.0, sensors.humidity, 0.01);
+    TEST_ASSERT_EQUAL_INT(1, bmp280_sim.conversions);
+
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_get_cycle_stats(hdl, &stats));
+    TEST_ASSERT(stats.cycle_us >= I2C_AHTXX_MEASUREMENT_TIME_US);
+    TEST_ASSERT(stats.cycle_us < I2C_AHTXX_MEASUREMENT_TIME_US + 5000);
+    TEST_ASSERT(stats.utilization > 0 && stats.utilization < 100);
+    printf("scheduled sampling cycle: %u steps, %u us, %u us busy, %.2f %% utilization\n", stats.steps, stats.cycle_us, stats.busy_us, stats.utilization);
+
+    /* a slow ahtxx is polled once per tick, only the sub-tick remainders of the conversion deadlines are busy-waited */
+    ahtxx_sim.measurement_us = 140000;
+    const int64_t busy_wait_us = i2c_sim_clock_get_busy_wait_us();
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_run_cycle(hdl));
+    TEST_ASSERT_NEAR(55.0, sensors.humidity, 0.01);
+    TEST_ASSERT(i2c_sim_clock_get_busy_wait_us() - busy_wait_us < 2 * portTICK_PERIOD_MS * 1000);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, i2c_bus_scheduler_get_cycle_stats(hdl, &stats));
+    TEST_ASSERT(stats.cycle_us >= 140000);
+    TEST_ASSERT(stats.cycle_us < 140000 + 2 * portTICK_PERIOD_MS * 1000);
+    TEST_ASSERT(stats.steps < 2 + 2 + 60 / portTICK_PERIOD_MS + 2);
+
+    i2c_bus_scheduler_del(hdl);
+    i2c_bmp280_rm(sensors.bmp280_hdl);
+    i2c_ahtxx_rm(sensors.ahtxx_hdl);
+    i2c_del_master_bus(bus_hdl);
+}
+
+int main(void) {
+    RUN_TEST(test_bmp280_pressure);
+    RUN_TEST(test_bmp280_cal_factors_cache);
+    RUN_TEST(test_bmp280_streaming);
+    RUN_TEST(test_bmp280_forced);
+    RUN_TEST(test_bmp280_compensation);
+    RUN_TEST(test_bme280_humidity);
+    RUN_TEST(test_bmp280_humidity_not_supported);
+    RUN_TEST(test_bmp280_register_shadow);
+    RUN_TEST(test_i2c_batch);
+    RUN_TEST(test_i2c_stats);
+    RUN_TEST(test_i2c_recovery);
+    RUN_TEST(test_i2c_async);
+    RUN_TEST(test_bmp280_invalid_chip);
+    RUN_TEST(test_bmp280_missing_device);
+    RUN_TEST(test_ahtxx_measurements);
+    RUN_TEST(test_ahtxx_split_measurement);
+    RUN_TEST(test_shared_bus);
+    RUN_TEST(test_i2c_bus_scheduler);
+    RUN_TEST(test_i2c_bus_scheduler_sensors);
+    return TEST_EXIT();
+}
@@ -0,0 +1,323 @@
+/**
+ * @file test_time_into_interval.c
+ *
+ * Host tests of the time-into-interval component.  The system clock is the simulated 
+ * host clock from a unix epoch timestamp, see i2c_sim.h, time zone is UTC.
+ */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include <time_into_interval.h>
+#include <time_into_interval_mux.h>
+#include <i2c_sim.h>
+
+#include "host_test.h"
+
+#define TEST_EPOCH_US   (1729957661187888LL)    /*!< 2024-10-26 15:47:41.187888 UTC */
+
+/* steps the system clock by `s_clock_step_us` from a timer alarm, as an sntp synchronization does */
+static int64_t s_clock_step_us = 0;
+
+static void test_clock_step_callback(void *arg) {
+    (void)arg;
+    i2c_sim_clock_set_epoch_us((int64_t)time_into_interval_get_epoch_timestamp_usec() + s_clock_step_us);
+}
+
+static void test_time_into_interval_delay(void) {
+    const time_into_interval_config_t cfg = { .name = "tii_6sec", .interval_type = TIME_INTO_INTERVAL_SEC, .interval_period = 6, .interval_offset = 0 };
+    time_into_interval_handle_t hdl = NULL;
+    time_into_interval_event_t  event;
+    uint64_t                    last_event;
+
+    i2c_sim_clock_set_epoch_us(TEST_EPOCH_US);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_init(&cfg, &hdl));
+
+    /* wakes up on the interval boundaries of the minute, with work in between the delays */
+    for(int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_delay(hdl));
+        TEST_ASSERT_EQUAL_INT(1729957662000000LL + i * 6000000LL, time_into_interval_get_epoch_timestamp_usec());
+        TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_get_delay_event(hdl, &event));
+        TEST_ASSERT_EQUAL_INT(1729957662000000LL + i * 6000000LL, event.epoch_timestamp_usec);
+        TEST_ASSERT_EQUAL_INT(0, event.lateness_usec);
+        TEST_ASSERT_EQUAL_INT(0, event.skipped_events);
+        TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_get_last_event(hdl, &last_event));
+        TEST_ASSERT_EQUAL_INT(1729957662000LL + i * 6000LL, last_event);
+        i2c_sim_clock_advance_us(1500000);
+    }
+
+    /* work overruns two interval boundaries, they are skipped and the task wakes up on the next boundary */
+    i2c_sim_clock_advance_us(11000000);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_delay(hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_get_delay_event(hdl, &event));
+    TEST_ASSERT_EQUAL_INT(1729957692000000LL, event.epoch_timestamp_usec);
+    TEST_ASSERT_EQUAL_INT(2, event.skipped_events);
+    TEST_ASSERT_EQUAL_INT(0, event.lateness_usec);
+
+    time_into_interval_del(hdl);
+}
+
+static void test_time_into_interval_clock_step(void) {
+    const time_into_interval_config_t cfg = { .name = "tii_10sec", .interval_type = TIME_INTO_INTERVAL_SEC, .interval_period = 10, .interval_offset = 0 };
+    const esp_timer_create_args_t     step_args = { .callback = test_clock_step_callback, .name = "clock_step" };
+    time_into_interval_handle_t hdl = NULL;
+    esp_timer_handle_t          step_hdl = NULL;
+    time_into_interval_event_t  event;
+
+    i2c_sim_clock_set_epoch_us(TEST_EPOCH_US);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_init(&cfg, &hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, esp_timer_create(&step_args, &step_hdl));
+
+    /* the system clock is set back while waiting, the alarm is re-armed and the task wakes up on the boundary */
+    s_clock_step_us = -2000000;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, esp_timer_start_once(step_hdl, 1000000));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_delay(hdl));
+    TEST_ASSERT_EQUAL_INT(1729957670000000LL, time_into_interval_get_epoch_timestamp_usec());
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_get_delay_event(hdl, &event));
+    TEST_ASSERT_EQUAL_INT(1729957670000000LL, event.epoch_timestamp_usec);
+    TEST_ASSERT_EQUAL_INT(0, event.lateness_usec);
+
+    /* the system clock is set forward while waiting, the task wakes up late and reports its lateness */
+    s_clock_step_us = 500000;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, esp_timer_start_once(step_hdl, 1000000));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_delay(hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_get_delay_event(hdl, &event));
+    TEST_ASSERT_EQUAL_INT(1729957680000000LL, event.epoch_timestamp_usec);
+    TEST_ASSERT_EQUAL_INT(500000, event.lateness_usec);
+
+    /* the system clock is set back by days while waiting, the boundary is recomputed on the next wake */
+    const int64_t start_us = i2c_sim_clock_get_us();
+    s_clock_step_us = -2LL * 86400 * 1000000;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, esp_timer_start_once(step_hdl, 1000000));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_delay(hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_get_delay_event(hdl, &event));
+    TEST_ASSERT_EQUAL_INT(1729957700000000LL - 2LL * 86400 * 1000000, event.epoch_timestamp_usec);
+    TEST_ASSERT_EQUAL_INT(0, event.lateness_usec);
+    TEST_ASSERT(i2c_sim_clock_get_us() - start_us < 20000000);
+
+    esp_timer_delete(step_hdl);
+    time_into_interval_del(hdl);
+}
+
+static void test_time_into_interval_sub_second(void) {
+    const time_into_interval_config_t msec_cfg = { .name = "tii_100hz", .interval_type = TIME_INTO_INTERVAL_MSEC, .interval_period = 10, .interval_offset = 5 };
+    const time_into_interval_config_t usec_cfg = { .name = "tii_400hz", .interval_type = TIME_INTO_INTERVAL_USEC, .interval_period = 2500, .interval_offset = 500 };
+    const time_into_interval_config_t bad_cfg  = { .name = "tii_bad", .interval_type = TIME_INTO_INTERVAL_MSEC, .interval_period = 500, .interval_offset = 500 };
+    time_into_interval_handle_t hdl = NULL;
+    time_into_interval_event_t  event;
+    int                         failures = 0;
+
+    TEST_ASSERT_EQUAL_INT(2500, time_into_interval_normalize_interval_to_usec(TIME_INTO_INTERVAL_USEC, 2500));
+    TEST_ASSERT_EQUAL_INT(500000, time_into_interval_normalize_interval_to_usec(TIME_INTO_INTERVAL_MSEC, 500));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_ARG, time_into_interval_init(&bad_cfg, &hdl));
+
+    /* 100-hz with a 5-milli-second offset, boundaries are aligned to the second, with work in between the delays */
+    i2c_sim_clock_set_epoch_us(TEST_EPOCH_US);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_init(&msec_cfg, &hdl));
+    for(int i = 0; i < 200; i++) {
+        time_into_interval_delay(hdl);
+        time_into_interval_get_delay_event(hdl, &event);
+        if(event.epoch_timestamp_usec != 1729957661195000ULL + (uint64_t)i * 10000U || event.lateness_usec != 0 || event.skipped_events != 0) failures++;
+        i2c_sim_clock_advance_us(3000);
+    }
+    TEST_ASSERT_EQUAL_INT(0, failures);
+    time_into_interval_del(hdl);
+
+    /* 400-hz with a 500-micro-second offset */
+    i2c_sim_clock_set_epoch_us(TEST_EPOCH_US);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_init(&usec_cfg, &hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_delay(hdl));
+    TEST_ASSERT_EQUAL_INT(1729957661188000LL, time_into_interval_get_epoch_timestamp_usec());
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_delay(hdl));
+    TEST_ASSERT_EQUAL_INT(1729957661190500LL, time_into_interval_get_epoch_timestamp_usec());
+    time_into_interval_del(hdl);
+}
+
+static void test_time_into_interval_state(void) {
+    const time_into_interval_config_t cfg = { .name = "tii_6sec", .interval_type = TIME_INTO_INTERVAL_SEC, .interval_period = 6, .interval_offset = 0 };
+    time_into_interval_handle_t hdl = NULL;
+    time_into_interval_event_t  event;
+    uint64_t                    last_event;
+
+    i2c_sim_clock_set_epoch_us(TEST_EPOCH_US);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_init(&cfg, &hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_delay(hdl));
+
+    /* the owner publishes once on init and once per delay */
+    TEST_ASSERT_EQUAL_INT(2, hdl->sequence);
+    TEST_ASSERT_EQUAL_INT(1729957668000000LL, hdl->state[hdl->sequence & 1U].epoch_timestamp);
+
+    /* an owner preempted while writing the inactive state doesn't affect readers */
+    hdl->state[(hdl->sequence + 1U) & 1U].epoch_timestamp = 0;
+    hdl->state[(hdl->sequence + 1U) & 1U].event.epoch_timestamp_usec = 0;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_get_last_event(hdl, &last_event));
+    TEST_ASSERT_EQUAL_INT(1729957662000LL, last_event);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_get_delay_event(hdl, &event));
+    TEST_ASSERT_EQUAL_INT(1729957662000000LL, event.epoch_timestamp_usec);
+
+    /* the polled condition publishes the next event when the interval elapsed */
+    i2c_sim_clock_advance_us(6000000);
+    TEST_ASSERT(time_into_interval(hdl) == true);
+    TEST_ASSERT_EQUAL_INT(3, hdl->sequence);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_get_last_event(hdl, &last_event));
+    TEST_ASSERT_EQUAL_INT(1729957668000LL, last_event);
+    TEST_ASSERT(time_into_interval(hdl) == false);
+    TEST_ASSERT_EQUAL_INT(3, hdl->sequence);
+
+    time_into_interval_del(hdl);
+}
+
+static void test_time_into_interval_utc_offset(void) {
+    uint64_t epoch_timestamp;
+
+    /* atlantic time zone, dst ends 2024-11-03 at 06:00 utc, 02:00 adt to 01:00 ast */
+    setenv("TZ", "AST4ADT,M3.2.0,M11.1.0", 1);
+    tzset();
+    time_into_interval_refresh_utc_offset();
+
+    /* 01:50 adt, the day boundary is local midnight, 03:00 utc */
+    i2c_sim_clock_set_epoch_us(1730609400ULL * 1000000U);
+    epoch_timestamp = 0;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_set_epoch_timestamp_event(TIME_INTO_INTERVAL_HR, 24, 0, &epoch_timestamp));
+    TEST_ASSERT_EQUAL_INT(1730689200LL * 1000000, epoch_timestamp);
+
+    /* a computed event is advanced by the period */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_set_epoch_timestamp_event(TIME_INTO_INTERVAL_HR, 24, 0, &epoch_timestamp));
+    TEST_ASSERT_EQUAL_INT((1730689200LL + 86400) * 1000000, epoch_timestamp);
+
+    /* 01:00 ast, the cached offset is refreshed across the dst transition, local midnight is 04:00 utc */
+    i2c_sim_clock_set_epoch_us(1730613600ULL * 1000000U);
+    epoch_timestamp = 0;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_set_epoch_timestamp_event(TIME_INTO_INTERVAL_HR, 24, 0, &epoch_timestamp));
+    TEST_ASSERT_EQUAL_INT(1730692800LL * 1000000, epoch_timestamp);
+
+    /* a 6-hour interval with a 1-hour offset is aligned to local midnight */
+    epoch_timestamp = 0;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_set_epoch_timestamp_event(TIME_INTO_INTERVAL_HR, 6, 1, &epoch_timestamp));
+    TEST_ASSERT_EQUAL_INT((1730606400LL + 7 * 3600) * 1000000, epoch_timestamp);
+
+    setenv("TZ", "UTC0", 1);
+    tzset();
+    time_into_interval_refresh_utc_offset();
+
+    /* a system clock step back refreshes the offset, the sub-second boundary is aligned to the second */
+    i2c_sim_clock_set_epoch_us(TEST_EPOCH_US);
+    epoch_timestamp = 0;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_set_epoch_timestamp_event(TIME_INTO_INTERVAL_MSEC, 20, 0, &epoch_timestamp));
+    TEST_ASSERT_EQUAL_INT(1729957661200000LL, epoch_timestamp);
+
+    /* the elapsed intervals of a long forward step are skipped at once */
+    i2c_sim_clock_set_epoch_us(TEST_EPOCH_US + 365ULL * 86400U * 1000000U + 123457U);
+    epoch_timestamp = 0;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_set_epoch_timestamp_event(TIME_INTO_INTERVAL_MSEC, 20, 0, &epoch_timestamp));
+    TEST_ASSERT_EQUAL_INT(1729957661200000LL + 365LL * 86400 * 1000000 + 120000, epoch_timestamp);
+}
+
+/* events dispatched by the multiplexer test callbacks */
+typedef struct test_mux_log_tag {
+    uint32_t                    count[3];
+    uint64_t                    last_epoch_timestamp_usec;
+    uint32_t                    failures;
+    time_into_interval_event_t  last_event;
+    int                         last_interval;
+} test_mux_log_t;
+
+static test_mux_log_t s_mux_log;
+
+static void test_mux_callback(void *callback_ctx, const time_into_interval_event_t *event) {
+    const int interval = (int)(intptr_t)callback_ctx;
+
+    /* events are dispatched in time order, on time */
+    if(event->epoch_timestamp_usec < s_mux_log.last_epoch_timestamp_usec) s_mux_log.failures++;
+    if(time_into_interval_get_epoch_timestamp_usec() != event->epoch_timestamp_usec + (uint64_t)event->lateness_usec) s_mux_log.failures++;
+
+    s_mux_log.count[interval]++;
+    s_mux_log.last_epoch_timestamp_usec = event->epoch_timestamp_usec;
+    s_mux_log.last_event    = *event;
+    s_mux_log.last_interval = interval;
+
+    /* work in the callback */
+    i2c_sim_clock_advance_us(2000);
+}
+
+static void test_time_into_interval_mux(void) {
+    const time_into_interval_mux_interval_config_t cfgs[3] = {
+        { .name = "sample", .interval_type = TIME_INTO_INTERVAL_SEC, .interval_period = 6,  .interval_offset = 0,  .callback = test_mux_callback, .callback_ctx = (void *)0 },
+        { .name = "heap",   .interval_type = TIME_INTO_INTERVAL_SEC, .interval_period = 60, .interval_offset = 10, .callback = test_mux_callback, .callback_ctx = (void *)1 },
+        { .name = "rollup", .interval_type = TIME_INTO_INTERVAL_HR,  .interval_period = 1,  .interval_offset = 0,  .callback = test_mux_callback, .callback_ctx = (void *)2 } };
+    time_into_interval_mux_handle_t hdl = NULL;
+    time_into_interval_event_t      event;
+    uint8_t                         index;
+
+    memset(&s_mux_log, 0, sizeof(s_mux_log));
+    i2c_sim_clock_set_epoch_us(TEST_EPOCH_US);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_mux_init(&hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_ERR_INVALID_STATE, time_into_interval_mux_dispatch(hdl));
+    for(uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_mux_add_interval(hdl, &cfgs[i], &index));
+        TEST_ASSERT_EQUAL_INT(i, index);
+    }
+
+    /* 15:47:41.187888 until the 16:00:00 rollup, simultaneous events are dispatched in add order */
+    while(s_mux_log.count[2] == 0) {
+        TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_mux_dispatch(hdl));
+    }
+    TEST_ASSERT_EQUAL_INT(124, s_mux_log.count[0]);
+    TEST_ASSERT_EQUAL_INT(12, s_mux_log.count[1]);
+    TEST_ASSERT_EQUAL_INT(1729958400000000LL, s_mux_log.last_epoch_timestamp_usec);
+    TEST_ASSERT_EQUAL_INT(2000, s_mux_log.last_event.lateness_usec);
+    TEST_ASSERT_EQUAL_INT(0, s_mux_log.failures);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_mux_get_event(hdl, 0, &event));
+    TEST_ASSERT_EQUAL_INT(1729958400000000LL, event.epoch_timestamp_usec);
+    TEST_ASSERT_EQUAL_INT(0, event.lateness_usec);
+
+    /* the task is busy for 20-seconds, the elapsed boundaries of the 6-second interval are skipped */
+    i2c_sim_clock_advance_us(20000000);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_mux_dispatch(hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_mux_get_event(hdl, 0, &event));
+    TEST_ASSERT_EQUAL_INT(1729958406000000LL, event.epoch_timestamp_usec);
+    TEST_ASSERT_EQUAL_INT(2, event.skipped_events);
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_mux_get_event(hdl, 1, &event));
+    TEST_ASSERT_EQUAL_INT(1729958410000000LL, event.epoch_timestamp_usec);
+    TEST_ASSERT_EQUAL_INT(0, event.skipped_events);
+    TEST_ASSERT_EQUAL_INT(125, s_mux_log.count[0]);
+    TEST_ASSERT_EQUAL_INT(13, s_mux_log.count[1]);
+
+    /* the next event is on the boundary after the skipped ones */
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_mux_dispatch(hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_mux_get_event(hdl, 0, &event));
+    TEST_ASSERT_EQUAL_INT(1729958424000000LL, event.epoch_timestamp_usec);
+    TEST_ASSERT_EQUAL_INT(0, event.lateness_usec);
+
+    /* the system clock is set back by days while waiting, the intervals are resynchronized on the next wake */
+    const esp_timer_create_args_t step_args = { .callback = test_clock_step_callback, .name = "clock_step" };
+    esp_timer_handle_t            step_hdl  = NULL;
+    const int64_t                 start_us  = i2c_sim_clock_get_us();
+    TEST_ASSERT_EQUAL_INT(ESP_OK, esp_timer_create(&step_args, &step_hdl));
+    s_clock_step_us = -2LL * 86400 * 1000000;
+    s_mux_log.last_epoch_timestamp_usec = 0;
+    TEST_ASSERT_EQUAL_INT(ESP_OK, esp_timer_start_once(step_hdl, 1000000));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_mux_dispatch(hdl));
+    TEST_ASSERT_EQUAL_INT(ESP_OK, time_into_interval_mux_get_event(hdl, 0, &event));
+    TEST_ASSERT_EQUAL_INT(1729958436000000LL - 2LL * 86400 * 1000000, event.epoch_timestamp_usec);
+    TEST_ASSERT_EQUAL_INT(0, event.lateness_usec);
+    TEST_ASSERT(i2c_sim_clock_get_us() - start_us < 20000000);
+    TEST_ASSERT_EQUAL_INT(0, s_mux_log.failures);
+    esp_timer_delete(step_hdl);
+
+    time_into_interval_mux_del(hdl);
+}
+
+int main(void) {
+    setenv("TZ", "UTC0", 1);
+    tzset();
+
+    RUN_TEST(test_time_into_interval_delay);
+    RUN_TEST(test_time_into_interval_clock_step);
+    RUN_TEST(test_time_into_interval_sub_second);
+    RUN_TEST(test_time_into_interval_state);
+    RUN_TEST(test_time_into_interval_utc_offset);
+    RUN_TEST(test_time_into_interval_mux);
+    return TEST_EXIT();
+}